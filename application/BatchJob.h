@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "SimulationConfig.h"
+
+// Une simulation d'un lot : un fichier d'entrée (config.inputFile) ou une
+// soupe aléatoire à graine fixe.
+struct BatchJob {
+    std::string name;
+    SimulationConfig config;   // réglages propres à la simulation
+    bool soup = false;
+    int soupRows = 0;
+    int soupCols = 0;
+    double soupDensity = 0.0;
+    std::uint64_t soupSeed = 0;
+};
+
+// Résumé d'une simulation d'un lot (une ligne du fichier de synthèse).
+struct BatchResult {
+    enum class Status { Stable, Cycle, MaxIterations, Error };
+
+    std::string name;
+    Status status = Status::Error;
+    int generation = 0;        // dernière génération calculée
+    long long population = 0;
+    int period = 0;            // période détectée (0 : aucune)
+    double seconds = 0.0;      // durée de la simulation (chargement compris)
+    std::string error;         // message si status == Error
+
+    static const char* statusName(Status status);
+};
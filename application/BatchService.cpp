@@ -0,0 +1,186 @@
+#include "BatchService.h"
+#include "EnsembleLife.h"
+#include "LifeRule.h"
+#include "RandomSoup.h"
+#include "SimulationService.h"
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <mutex>
+
+namespace {
+
+// grille initiale d'une soupe : generee, pas lue (le chemin est ignore)
+class SoupLoader : public IGridLoader {
+public:
+    explicit SoupLoader(const BatchJob& job) : m_job(job) {}
+
+    Grid loadGrid(const std::string&, bool toroidal) const override {
+        return RandomSoup::make(m_job.soupRows, m_job.soupCols, m_job.soupDensity,
+                                m_job.soupSeed, toroidal);
+    }
+
+private:
+    const BatchJob& m_job;
+};
+
+// soupes assez petites pour EnsembleLife (au-dela, les tuiles de
+// GameOfLife et le cache priment)
+const long long kEnsembleMaxCells = 128 * 128;
+
+bool ensembleEligible(const BatchJob& job) {
+    return job.soup && job.config.engine == Engine::Dense && !job.config.rule.isGenerations()
+        && static_cast<long long>(job.soupRows) * job.soupCols <= kEnsembleMaxCells;
+}
+
+// memes dimensions et memes reglages de fin : un seul EnsembleLife
+bool sameEnsemble(const BatchJob& a, const BatchJob& b) {
+    return a.soupRows == b.soupRows && a.soupCols == b.soupCols
+        && a.config.toroidal == b.config.toroidal && a.config.rule == b.config.rule
+        && a.config.maxIterations == b.config.maxIterations
+        && a.config.cycleHistory == b.config.cycleHistory
+        && a.config.stopOnCycle == b.config.stopOnCycle;
+}
+
+// Tache du lot : une simulation seule, ou jusqu'a 64 soupes compatibles
+// avancees ensemble.
+struct BatchTask {
+    std::vector<int> jobs;
+    bool ensemble = false;
+};
+
+std::vector<BatchTask> planTasks(const std::vector<BatchJob>& jobs) {
+    std::vector<BatchTask> tasks;
+    std::vector<int> open; // paquets incomplets (indices dans tasks)
+    for (int i = 0; i < static_cast<int>(jobs.size()); ++i) {
+        if (!ensembleEligible(jobs[i])) {
+            tasks.push_back(BatchTask{ { i }, false });
+            continue;
+        }
+        auto pack = std::find_if(open.begin(), open.end(), [&](int t) {
+            return sameEnsemble(jobs[tasks[t].jobs[0]], jobs[i]);
+        });
+        if (pack == open.end()) {
+            open.push_back(static_cast<int>(tasks.size()));
+            tasks.push_back(BatchTask{ { i }, true });
+            continue;
+        }
+        tasks[*pack].jobs.push_back(i);
+        if (static_cast<int>(tasks[*pack].jobs.size()) == EnsembleLife::kLanes) open.erase(pack);
+    }
+    return tasks;
+}
+
+// Meme issue que runOne() pour chaque soupe du paquet : une voie s'arrete
+// quand SimulationService::hasFinished() le ferait.
+void runEnsemble(const std::vector<BatchJob>& jobs, const std::vector<int>& pack,
+                 std::vector<BatchResult>& results)
+{
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    const SimulationConfig& config = jobs[pack[0]].config;
+    try {
+        std::vector<Grid> soups;
+        for (int index : pack) {
+            const BatchJob& job = jobs[index];
+            soups.push_back(RandomSoup::make(job.soupRows, job.soupCols, job.soupDensity,
+                                             job.soupSeed, config.toroidal));
+        }
+        EnsembleLife ensemble(soups, config.rule, config.maxIterations, config.cycleHistory);
+        const std::uint64_t all = ensemble.laneMask();
+        for (;;) {
+            std::uint64_t done = ensemble.finishedMask();
+            if (config.stopOnCycle) done |= ensemble.cycleMask();
+            if ((done & all) == all) break;
+            ensemble.step(~done);
+        }
+
+        for (int l = 0; l < ensemble.lanes(); ++l) {
+            BatchResult& result = results[pack[l]];
+            result.generation = ensemble.currentIteration(l);
+            result.population = ensemble.population(l);
+            result.period = ensemble.detectedPeriod(l);
+            if (ensemble.isStable(l) || result.period == 1) result.status = BatchResult::Status::Stable;
+            else if (result.period > 0) result.status = BatchResult::Status::Cycle;
+            else result.status = BatchResult::Status::MaxIterations;
+        }
+    }
+    catch (const std::exception& ex) {
+        for (int index : pack) {
+            results[index].status = BatchResult::Status::Error;
+            results[index].error = ex.what();
+        }
+    }
+    // duree du paquet repartie entre ses simulations
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (int index : pack) {
+        results[index].name = jobs[index].name;
+        results[index].seconds = seconds / pack.size();
+    }
+}
+
+} // namespace
+
+const char* BatchResult::statusName(Status status) {
+    switch (status) {
+    case Status::Stable: return "stable";
+    case Status::Cycle: return "cycle";
+    case Status::MaxIterations: return "max";
+    case Status::Error: return "erreur";
+    }
+    return "?";
+}
+
+BatchResult BatchService::runOne(const BatchJob& job, const IGridLoader& files) {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    BatchResult result;
+    result.name = job.name;
+    try {
+        // un thread de calcul par simulation : le parallelisme est entre simulations
+        SimulationConfig config = job.config;
+        config.threads = 1;
+        SoupLoader soup(job);
+        SimulationService service(config, job.soup ? soup : files, nullptr,
+                                  std::make_unique<LifeRule>(config.rule));
+        while (!service.hasFinished()) service.step();
+
+        result.generation = service.currentIteration();
+        result.population = service.population();
+        result.period = service.detectedPeriod();
+        // periode 1 : configuration fixe
+        if (service.isStable() || result.period == 1) result.status = BatchResult::Status::Stable;
+        else if (result.period > 0) result.status = BatchResult::Status::Cycle;
+        else result.status = BatchResult::Status::MaxIterations;
+    }
+    catch (const std::exception& ex) {
+        result.status = BatchResult::Status::Error;
+        result.error = ex.what();
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+std::vector<BatchResult> BatchService::run(const std::vector<BatchJob>& jobs,
+                                           const IGridLoader& files,
+                                           int threads,
+                                           const Progress& progress)
+{
+    std::vector<BatchResult> results(jobs.size());
+    const std::vector<BatchTask> tasks = planTasks(jobs);
+    std::mutex progressMutex;
+    int done = 0;
+    auto task = [&](int index, int) {
+        const BatchTask& t = tasks[index];
+        if (t.ensemble) runEnsemble(jobs, t.jobs, results);
+        else results[t.jobs[0]] = runOne(jobs[t.jobs[0]], files);
+        if (progress) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            for (int job : t.jobs)
+                progress(results[job], ++done, static_cast<int>(jobs.size()));
+        }
+    };
+    WorkStealingScheduler::run(static_cast<int>(tasks.size()), threads, task);
+    return results;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "BatchJob.h"
+#include "IGridLoader.h"
+
+// Exécution d'un lot de simulations indépendantes sur tous les cœurs : une
+// simulation par tâche, sur un seul thread de calcul chacune, réparties
+// par vol de travail (WorkStealingScheduler). Les petites soupes de mêmes
+// dimensions et mêmes réglages sont regroupées par 64 dans un EnsembleLife
+// (une tâche par paquet), avec le même résultat que runOne(). Une
+// simulation en erreur donne une ligne de résultat en erreur sans arrêter
+// les autres.
+class BatchService {
+public:
+    // appelé après chaque simulation (sous verrou, un appel à la fois)
+    typedef std::function<void(const BatchResult& result, int done, int total)> Progress;
+
+    // files : chargeur des entrées fichier ; threads <= 0 : tous les cœurs.
+    // Les résultats sont dans l'ordre des jobs.
+    static std::vector<BatchResult> run(const std::vector<BatchJob>& jobs,
+                                        const IGridLoader& files,
+                                        int threads,
+                                        const Progress& progress = Progress());
+
+    // une simulation jusqu'à stabilisation, cycle ou maxIterations
+    static BatchResult runOne(const BatchJob& job, const IGridLoader& files);
+};
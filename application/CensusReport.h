@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ObjectClassifier.h"
+#include "RuleSpec.h"
+
+// Recensement : soupes aléatoires rows x cols de graines seed, seed+1...,
+// placées dans un univers non borné (les vaisseaux s'échappent).
+struct CensusSettings {
+    long long soups = 1000;
+    int soupRows = 16;
+    int soupCols = 16;
+    double density = 0.5;
+    std::uint64_t seed = 1;
+    RuleSpec rule = RuleSpec::conway();
+    int maxIterations = 10000;  // au-delà, la soupe est comptée non stabilisée
+    int maxPeriod = 64;         // période maximale reconnue pour un objet
+    int threads = 0;            // 0 = tous les cœurs
+};
+
+// Une ligne du tableau : une classe d'objets et son nombre d'occurrences.
+struct CensusEntry {
+    ObjectClass object;
+    long long count = 0;
+    std::uint64_t sampleSeed = 0; // plus petite graine de soupe où il apparaît
+};
+
+struct CensusReport {
+    long long soups = 0;
+    long long unsettled = 0;     // soupes arrêtées à maxIterations
+    long long objects = 0;
+    long long generations = 0;   // générations calculées, toutes soupes
+    long long cacheHits = 0;     // objets classés par le cache
+    long long cacheMisses = 0;   // objets simulés
+    double seconds = 0.0;
+    double classifySeconds = 0.0; // séparation et classement, tous threads
+    std::vector<CensusEntry> entries; // par nombre décroissant
+};
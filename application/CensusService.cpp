@@ -0,0 +1,152 @@
+#include "CensusService.h"
+#include "RandomSoup.h"
+#include "SparseLife.h"
+#include "WorkStealingScheduler.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+const int kSoupsPerTask = 64;
+// periode de population la plus longue attendue d'une soupe stabilisee
+// (melange d'oscillateurs de periodes 2, 3, 5...)
+const int kMaxSettlePeriod = 30;
+
+// population periodique de periode p sur les 2p + 16 dernieres generations
+bool populationSettled(const std::vector<long long>& history) {
+    const int n = static_cast<int>(history.size());
+    for (int p = 1; p <= kMaxSettlePeriod; ++p) {
+        const int window = 2 * p + 16;
+        if (n < window + p) break;
+        int i = 0;
+        while (i < window && history[n - 1 - i] == history[n - 1 - i - p]) ++i;
+        if (i == window) return true;
+    }
+    return false;
+}
+
+// objets comptes par un thread, par code
+struct Tally {
+    std::unordered_map<std::string, CensusEntry> entries;
+    long long soups = 0;
+    long long unsettled = 0;
+    long long objects = 0;
+    long long generations = 0;
+    double classifySeconds = 0.0;
+};
+
+void runSoup(const CensusSettings& settings, std::uint64_t seed,
+             ObjectClassifier& classifier, Tally& tally)
+{
+    const Grid soup = RandomSoup::make(settings.soupRows, settings.soupCols, settings.density, seed);
+    SparseLife life(soup, settings.maxIterations, 64, settings.rule);
+    std::vector<long long> populations(1, life.population());
+    bool settled = false;
+    while (life.currentIteration() < settings.maxIterations) {
+        life.step();
+        populations.push_back(life.population());
+        if (life.detectedPeriod() > 0 || populationSettled(populations)) {
+            settled = true;
+            break;
+        }
+    }
+    ++tally.soups;
+    if (!settled) ++tally.unsettled;
+    tally.generations += life.currentIteration();
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    std::vector<ObjectShape::Cell> cells;
+    life.liveCells(cells);
+    std::vector<std::vector<ObjectShape::Cell>> objects;
+    ObjectShape::separate(cells, objects);
+    for (const std::vector<ObjectShape::Cell>& object : objects) {
+        const ObjectClass& found = classifier.classify(ObjectShape::fromCells(object));
+        auto it = tally.entries.find(found.code);
+        if (it == tally.entries.end()) {
+            it = tally.entries.emplace(found.code, CensusEntry()).first;
+            it->second.object = found;
+            it->second.sampleSeed = seed;
+        }
+        ++it->second.count;
+        it->second.sampleSeed = std::min(it->second.sampleSeed, seed);
+        ++tally.objects;
+    }
+    tally.classifySeconds += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+CensusReport CensusService::run(const CensusSettings& settings, const Progress& progress) {
+    if (settings.soups < 0 || settings.soupRows <= 0 || settings.soupCols <= 0) {
+        throw std::invalid_argument("Recensement : nombre ou taille de soupes invalide");
+    }
+    if (settings.rule.isGenerations() || settings.rule.birthOnZero()) {
+        throw std::invalid_argument("Recensement : regle B/S sans B0 attendue");
+    }
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+
+    const int threads = settings.threads > 0 ? settings.threads : WorkerPool::hardwareThreads();
+    const long long taskCount = (settings.soups + kSoupsPerTask - 1) / kSoupsPerTask;
+    if (taskCount > 0x7FFFFFFF) {
+        throw std::invalid_argument("Recensement : trop de soupes");
+    }
+    // un classeur et un decompte par thread : aucun verrou par objet
+    std::vector<std::unique_ptr<ObjectClassifier>> classifiers;
+    for (int t = 0; t < threads; ++t)
+        classifiers.push_back(std::make_unique<ObjectClassifier>(settings.rule, settings.maxPeriod));
+    std::vector<Tally> tallies(threads);
+
+    std::mutex progressMutex;
+    long long done = 0;
+    auto task = [&](int index, int worker) {
+        const long long first = static_cast<long long>(index) * kSoupsPerTask;
+        const long long last = std::min(first + kSoupsPerTask, settings.soups);
+        for (long long i = first; i < last; ++i)
+            runSoup(settings, settings.seed + static_cast<std::uint64_t>(i),
+                    *classifiers[worker], tallies[worker]);
+        if (progress) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            done += last - first;
+            progress(done, settings.soups);
+        }
+    };
+    WorkStealingScheduler::run(static_cast<int>(taskCount), threads, task);
+
+    CensusReport report;
+    std::unordered_map<std::string, CensusEntry> merged;
+    for (int t = 0; t < threads; ++t) {
+        const Tally& tally = tallies[t];
+        report.soups += tally.soups;
+        report.unsettled += tally.unsettled;
+        report.objects += tally.objects;
+        report.generations += tally.generations;
+        report.classifySeconds += tally.classifySeconds;
+        report.cacheHits += classifiers[t]->cacheHits();
+        report.cacheMisses += classifiers[t]->cacheMisses();
+        for (const auto& entry : tally.entries) {
+            auto it = merged.find(entry.first);
+            if (it == merged.end()) {
+                merged.emplace(entry.first, entry.second);
+                continue;
+            }
+            it->second.count += entry.second.count;
+            it->second.sampleSeed = std::min(it->second.sampleSeed, entry.second.sampleSeed);
+        }
+    }
+    for (auto& entry : merged) report.entries.push_back(std::move(entry.second));
+    std::sort(report.entries.begin(), report.entries.end(),
+              [](const CensusEntry& a, const CensusEntry& b) {
+                  if (a.count != b.count) return a.count > b.count;
+                  return a.object.code < b.object.code;
+              });
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <functional>
+#include "CensusReport.h"
+
+// Recensement des objets produits par des soupes aléatoires : chaque soupe
+// est avancée dans un univers creux (SparseLife) jusqu'à stabilisation,
+// puis ses cellules sont séparées en objets (ObjectShape::separate) et
+// chaque objet est classé (ObjectClassifier, un par thread, avec cache).
+//
+// Une soupe est stabilisée quand l'univers revient à une génération déjà
+// vue, ou quand sa population est périodique depuis plusieurs périodes :
+// les vaisseaux qui s'éloignent empêchent l'univers de se répéter mais pas
+// la population. Les soupes sont réparties par paquets entre les threads
+// (WorkStealingScheduler) ; le résultat ne dépend pas du nombre de threads.
+class CensusService {
+public:
+    // appelé après chaque paquet de soupes (sous verrou, un appel à la fois)
+    typedef std::function<void(long long done, long long total)> Progress;
+
+    static CensusReport run(const CensusSettings& settings,
+                            const Progress& progress = Progress());
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include "SimulationCheckpoint.h"
+
+// Port d'application : enregistrement et relecture des points de reprise.
+class ICheckpointStore {
+public:
+    virtual ~ICheckpointStore() = default;
+    // enregistre checkpoint ; une implémentation asynchrone peut en échanger
+    // le contenu avec un tampon à elle (checkpoint contient alors un ancien
+    // point de reprise, réutilisable par l'appelant)
+    virtual void save(SimulationCheckpoint& checkpoint) const = 0;
+    virtual SimulationCheckpoint load(const std::string& path) const = 0;
+    // attend la fin des écritures en cours et relance leurs erreurs
+    virtual void finish() const {}
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "HaloTransport.h"
+#include "RuleSpec.h"
+#include "TileStore.h"
+
+// Port d'application : ressources système des moteurs qui sortent du
+// processus de simulation. Le moteur réparti en reçoit son transport, le
+// moteur hors mémoire son stockage en tuiles.
+class IEngineResources {
+public:
+    virtual ~IEngineResources() = default;
+    // transport d'un nouveau DistributedLife (non démarré)
+    virtual std::unique_ptr<HaloTransport> createTransport() const = 0;
+    // stockage en tuiles existant, repris en place
+    virtual std::unique_ptr<TileStore> openTiles(const std::string& path) const = 0;
+    // nouveau stockage vide rows x cols à la génération 0 (remplace path)
+    virtual std::unique_ptr<TileStore> createTiles(const std::string& path, int rows, int cols,
+                                                   bool toroidal, const RuleSpec& rule) const = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include "Grid.h"
+#include "StateGrid.h"
 
 // Port d'application : export d'une grille.
 class IGridExporter {
@@ -9,4 +10,14 @@ public:
     virtual void exportGrid(const Grid& grid,
                             const std::string& baseName,
                             int iteration) const = 0;
+    // grille multi-états ; par défaut, seules les cellules vivantes (état 1)
+    virtual void exportStates(const StateGrid& states,
+                              const std::string& baseName,
+                              int iteration) const {
+        Grid alive;
+        states.aliveInto(alive);
+        exportGrid(alive, baseName, iteration);
+    }
+    // fin de simulation : vide et ferme ce qui doit l'être (journal, ...)
+    virtual void finish() const {}
 };
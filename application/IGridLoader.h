@@ -1,10 +1,15 @@
 #pragma once
 #include <string>
 #include "Grid.h"
+#include "StateGrid.h"
 
 // Port d'application : chargement d'une grille initiale.
 class IGridLoader {
 public:
     virtual ~IGridLoader() = default;
     virtual Grid loadGrid(const std::string& path, bool toroidal) const = 0;
+    // grille multi-états (règles Generations) ; par défaut, vivantes de loadGrid() à l'état 1
+    virtual StateGrid loadStates(const std::string& path, bool toroidal) const {
+        return StateGrid(loadGrid(path, toroidal));
+    }
 };
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+#include "SimulationMetrics.h"
+
+// Port d'application : destination des mesures par génération.
+class IMetricsSink {
+public:
+    virtual ~IMetricsSink() = default;
+    // count mesures consécutives, de la plus ancienne à la plus récente
+    virtual void write(const GenerationMetrics* metrics, std::size_t count) const = 0;
+    virtual void finish() const {}
+};
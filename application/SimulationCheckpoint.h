@@ -0,0 +1,11 @@
+#pragma once
+#include "EngineCheckpoint.h"
+#include "SimulationConfig.h"
+
+// Point de reprise d'une simulation : configuration de la simulation
+// interrompue, numérotation des exports et état du moteur.
+struct SimulationCheckpoint {
+    SimulationConfig config;
+    int lastExported = 0; // dernière génération exportée
+    EngineCheckpoint engine;
+};
@@ -1,5 +1,24 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include "RuleSpec.h"
+#include "StepKernel.h"
+
+// Moteur de simulation :
+//  - Dense  : GameOfLife, grille fixe (bornée ou torique) stockée en bits
+//  - Sparse : SparseLife, univers non borné ne stockant que les blocs vivants
+//  - HashLife : quadtree mémoïsé, avance de 2^k générations par pas
+//  - Distributed : DistributedLife, grille fixe découpée en bandes calculées
+//                  par des processus distincts
+//  - Tiled : TiledLife, grille fixe stockée dans un fichier projeté en
+//            mémoire (<base>.tiles), réécrit en place à chaque génération
+enum class Engine { Dense, Sparse, HashLife, Distributed, Tiled };
+
+// Format d'export du mode console :
+//  - Text : un fichier texte <base>_<n>.txt par génération
+//  - Log  : un seul journal binaire <base>.golog (images + deltas, index)
+enum class OutputFormat { Text, Log };
 
 struct SimulationConfig {
     std::string inputFile;
@@ -7,4 +26,34 @@ struct SimulationConfig {
     int maxIterations = 100;
     bool toroidal = false;
     bool graphicMode = false;
+    Engine engine = Engine::Dense;            // dense (defaut), creux, hashlife, reparti ou en fichier
+    RuleSpec rule = RuleSpec::conway();       // regle B/S (--rule B36/S23, ...)
+    StepKernel kernel = StepKernel::Bitwise; // noyau binaire si la regle est une LifeRule
+    int threads = 1;                          // threads de calcul (0 = tous les coeurs)
+    int workers = 0;                          // moteur reparti : processus de calcul (0 = un par coeur)
+    int tiledRows = 0;                        // moteur en fichier : dimensions (0 = celles du motif)
+    int tiledCols = 0;
+    int cycleHistory = 64;                    // generations memorisees pour detecter les cycles
+    bool stopOnCycle = true;                  // arret des qu'un oscillateur est detecte
+    int hashlifeStepLog2 = 0;                 // hashlife : 2^k generations par pas
+    std::size_t hashlifeMaxNodes = std::size_t(1) << 22; // hashlife : taille du cache de noeuds
+    // fenetre exportee/affichee par les moteurs non bornes (vide = rectangle englobant)
+    long long viewTop = 0;
+    long long viewLeft = 0;
+    int viewRows = 0;
+    int viewCols = 0;
+    OutputFormat outputFormat = OutputFormat::Text;
+    int logKeyframeInterval = 64;             // journal : une image complete toutes les N generations
+    int exportEvery = 1;                      // export toutes les K generations (0 = derniere seulement)
+    int exportQueue = 4;                      // instantanes en attente d'ecriture (0 = export synchrone)
+    std::string checkpointFile;               // point de reprise (vide = aucun)
+    int checkpointEvery = 1000;               // point de reprise toutes les N generations
+    bool collectMetrics = false;              // mesures par generation et resume en fin de simulation
+    std::string metricsFile;                  // mesures en .csv ou .jsonl (vide = resume seul)
+    int metricsHistory = 1024;                // generations gardees en memoire
+    // recensement : soupes aleatoires soupRows x soupCols, graines soupSeed, soupSeed+1...
+    int soupRows = 16;
+    int soupCols = 16;
+    double soupDensity = 0.5;
+    std::uint64_t soupSeed = 1;
 };
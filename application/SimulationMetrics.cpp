@@ -0,0 +1,83 @@
+#include "SimulationMetrics.h"
+#include "IMetricsSink.h"
+#include <algorithm>
+#include <stdexcept>
+
+int LatencyHistogram::bucketOf(std::uint64_t nanos) {
+    // valeurs < 2^kSubBits : une classe par valeur
+    if (nanos < (1u << kSubBits)) return static_cast<int>(nanos);
+    const int msb = 63 - __builtin_clzll(nanos);
+    const int sub = static_cast<int>((nanos >> (msb - kSubBits)) & ((1u << kSubBits) - 1));
+    return ((msb - kSubBits + 1) << kSubBits) + sub;
+}
+
+std::int64_t LatencyHistogram::upperBound(int bucket) {
+    if (bucket < (1 << kSubBits)) return bucket;
+    const int msb = (bucket >> kSubBits) + kSubBits - 1;
+    const int sub = bucket & ((1 << kSubBits) - 1);
+    const std::uint64_t low = (std::uint64_t(1) << msb)
+                            + (static_cast<std::uint64_t>(sub) << (msb - kSubBits));
+    return static_cast<std::int64_t>(low + (std::uint64_t(1) << (msb - kSubBits)) - 1);
+}
+
+void LatencyHistogram::record(std::int64_t nanos) {
+    if (nanos < 0) nanos = 0;
+    ++m_buckets[bucketOf(static_cast<std::uint64_t>(nanos))];
+    ++m_count;
+    m_sum += nanos;
+    m_max = std::max(m_max, nanos);
+}
+
+std::int64_t LatencyHistogram::percentile(double p) const {
+    if (m_count == 0) return 0;
+    const long long rank = std::max(1LL, static_cast<long long>(p * m_count + 0.5));
+    long long seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += m_buckets[b];
+        if (seen >= rank) return std::min(upperBound(b), m_max);
+    }
+    return m_max;
+}
+
+MetricsRecorder::MetricsRecorder(int capacity, const IMetricsSink* sink)
+    : m_sink(sink)
+{
+    if (capacity <= 0) {
+        throw std::invalid_argument("Historique des mesures vide");
+    }
+    m_ring.resize(capacity);
+}
+
+void MetricsRecorder::record(const GenerationMetrics& metrics) {
+    m_ring[m_next] = metrics;
+    m_next = (m_next + 1) % capacity();
+    m_size = std::min(m_size + 1, capacity());
+    m_step.record(metrics.stepNanos);
+    if (metrics.exportNanos > 0) m_export.record(metrics.exportNanos);
+    ++m_generations;
+    m_births += metrics.births;
+    m_deaths += metrics.deaths;
+    if (m_sink && ++m_unsent == capacity()) flush();
+}
+
+const GenerationMetrics& MetricsRecorder::recent(int k) const {
+    if (k < 0 || k >= m_size) {
+        throw std::out_of_range("Mesure hors de l'historique");
+    }
+    return m_ring[(m_next - 1 - k + 2 * capacity()) % capacity()];
+}
+
+void MetricsRecorder::flush() {
+    // les m_unsent dernieres mesures, en une ou deux tranches contigues
+    const int first = (m_next - m_unsent + capacity()) % capacity();
+    const int head = std::min(m_unsent, capacity() - first);
+    if (head > 0) m_sink->write(&m_ring[first], head);
+    if (m_unsent > head) m_sink->write(&m_ring[0], m_unsent - head);
+    m_unsent = 0;
+}
+
+void MetricsRecorder::finish() {
+    if (!m_sink) return;
+    if (m_unsent > 0) flush();
+    m_sink->finish();
+}
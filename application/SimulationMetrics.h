@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BoundingBox.h"
+
+// Mesures d'une génération, relevées par SimulationService.
+struct GenerationMetrics {
+    int iteration = 0;
+    std::int64_t stepNanos = 0;   // durée du pas
+    std::int64_t exportNanos = 0; // durée de l'appel d'export (0 : pas d'export)
+    long long population = 0;
+    long long births = 0;
+    long long deaths = 0;
+    long long activeTiles = 0;    // unités recalculées
+    BoundingBox activeRegion;     // zone modifiée (voir LifeEngine::activeRegion)
+
+    long long changed() const { return births + deaths; }
+};
+
+// Histogramme de durées à classes logarithmiques (8 sous-classes par
+// puissance de 2, erreur relative < 12,5 %) : enregistrement en O(1), sans
+// allocation, centiles sur toute la simulation.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : m_buckets(kBuckets, 0) {}
+
+    void record(std::int64_t nanos);
+    // borne haute de la classe contenant le centile p (0..1)
+    std::int64_t percentile(double p) const;
+
+    long long count() const { return m_count; }
+    std::int64_t max() const { return m_max; }
+    double mean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+private:
+    static const int kSubBits = 3;
+    static const int kBuckets = 64 << kSubBits;
+
+    static int bucketOf(std::uint64_t nanos);
+    static std::int64_t upperBound(int bucket);
+
+    std::vector<long long> m_buckets;
+    long long m_count = 0;
+    std::int64_t m_sum = 0;
+    std::int64_t m_max = 0;
+};
+
+class IMetricsSink;
+
+// Mesures des dernières générations dans un tampon circulaire pré-alloué,
+// histogrammes des durées et totaux. Si un puits est fourni, les mesures
+// lui sont transmises par lots d'une capacité du tampon (et à finish()).
+class MetricsRecorder {
+public:
+    explicit MetricsRecorder(int capacity = 1024, const IMetricsSink* sink = nullptr);
+
+    void record(const GenerationMetrics& metrics);
+    void finish(); // transmet les mesures en attente au puits
+
+    int size() const { return m_size; }
+    int capacity() const { return static_cast<int>(m_ring.size()); }
+    // k-ième génération la plus récente (0 = dernière)
+    const GenerationMetrics& recent(int k) const;
+
+    const LatencyHistogram& stepLatency() const { return m_step; }
+    const LatencyHistogram& exportLatency() const { return m_export; }
+    long long generations() const { return m_generations; }
+    long long totalBirths() const { return m_births; }
+    long long totalDeaths() const { return m_deaths; }
+
+private:
+    void flush();
+
+    std::vector<GenerationMetrics> m_ring;
+    int m_next = 0;
+    int m_size = 0;
+    int m_unsent = 0; // mesures pas encore transmises au puits
+    const IMetricsSink* m_sink;
+    LatencyHistogram m_step;
+    LatencyHistogram m_export;
+    long long m_generations = 0;
+    long long m_births = 0;
+    long long m_deaths = 0;
+};
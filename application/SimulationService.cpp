@@ -1,44 +1,265 @@
 #include "SimulationService.h"
-#include "ConwayRule.h"
+#include "DistributedLife.h"
+#include "GameOfLife.h"
+#include "GenerationsLife.h"
+#include "HashLife.h"
+#include "LifeRule.h"
+#include "SparseLife.h"
+#include "TiledLife.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 
 SimulationService::SimulationService(const SimulationConfig& config,
                                      const IGridLoader& loader,
                                      const IGridExporter* exporter,
-                                     std::unique_ptr<Rule> rule)
+                                     std::unique_ptr<Rule> rule,
+                                     const ICheckpointStore* checkpoints,
+                                     const SimulationCheckpoint* resumeFrom,
+                                     const IEngineResources* resources)
     : m_config(config),
       m_loader(loader),
-      m_exporter(exporter),
-      m_rule(std::move(rule))
+      m_exporter(nullptr),
+      m_rule(std::move(rule)),
+      m_checkpoints(nullptr)
 {
-    // Charger la grille initiale via le port de chargement
-    Grid initial = m_loader.loadGrid(m_config.inputFile, m_config.toroidal);
     if (!m_rule) {
-        m_rule = std::make_unique<ConwayRule>();
+        m_rule = std::make_unique<LifeRule>(m_config.rule);
+    }
+    // les moteurs non bornes calculent directement une regle B/S
+    const RuleSpec* spec = LifeRule::specOf(*m_rule);
+
+    // regle Generations : grille multi-etats dense
+    if (spec && spec->isGenerations()) {
+        if (checkpoints || resumeFrom) {
+            throw std::invalid_argument("Les points de reprise ne gerent pas les regles multi-etats");
+        }
+        if (m_config.engine != Engine::Dense) {
+            throw std::invalid_argument("Les regles multi-etats demandent le moteur dense");
+        }
+        StateGrid states = m_loader.loadStates(m_config.inputFile, m_config.toroidal);
+        m_engine = std::make_unique<GenerationsLife>(states, *spec, m_config.maxIterations,
+                                                     m_config.cycleHistory);
+        attach(exporter, nullptr);
+        return;
+    }
+
+    // moteur en fichier : un fichier .tiles en entree est poursuivi en place
+    const std::string& input = m_config.inputFile;
+    const bool tiledInput = m_config.engine == Engine::Tiled && !resumeFrom
+        && input.size() > 6 && input.compare(input.size() - 6, 6, ".tiles") == 0;
+
+    // Charger la grille initiale via le port de chargement (ou la
+    // generation du point de reprise)
+    Grid initial = resumeFrom ? resumeFrom->engine.grid
+                 : tiledInput ? Grid()
+                              : m_loader.loadGrid(m_config.inputFile, m_config.toroidal);
+    switch (m_config.engine) {
+    case Engine::Sparse: {
+        if (!spec) {
+            throw std::invalid_argument("Le moteur creux ne gere que les regles B/S");
+        }
+        auto sparse = std::make_unique<SparseLife>(initial, m_config.maxIterations,
+                                                   m_config.cycleHistory, *spec);
+        sparse->setView(m_config.viewTop, m_config.viewLeft, m_config.viewRows, m_config.viewCols);
+        m_engine = std::move(sparse);
+        break;
+    }
+    case Engine::HashLife: {
+        if (!spec) {
+            throw std::invalid_argument("Le moteur hashlife ne gere que les regles B/S");
+        }
+        auto hashlife = std::make_unique<HashLife>(initial, m_config.maxIterations,
+                                                   m_config.hashlifeStepLog2,
+                                                   m_config.hashlifeMaxNodes,
+                                                   m_config.cycleHistory, *spec);
+        hashlife->setView(m_config.viewTop, m_config.viewLeft, m_config.viewRows, m_config.viewCols);
+        m_engine = std::move(hashlife);
+        break;
+    }
+    case Engine::Tiled: {
+        if (!spec) {
+            throw std::invalid_argument("Le moteur en fichier ne gere que les regles B/S");
+        }
+        if (!resources) {
+            throw std::invalid_argument("Le moteur en fichier n'est pas disponible ici");
+        }
+        std::unique_ptr<TileStore> store;
+        if (tiledInput) {
+            store = resources->openTiles(input);
+        } else {
+            // grille de --size (par defaut celle du motif), motif au centre
+            const std::string base = m_config.outputBaseName.empty() ? "output" : m_config.outputBaseName;
+            const int rows = m_config.tiledRows > 0 ? m_config.tiledRows : initial.rows();
+            const int cols = m_config.tiledCols > 0 ? m_config.tiledCols : initial.cols();
+            if (rows < initial.rows() || cols < initial.cols()) {
+                throw std::invalid_argument("Grille plus petite que le motif (--size)");
+            }
+            store = resources->createTiles(base + ".tiles", rows, cols, m_config.toroidal, *spec);
+            store->place(initial, (rows - initial.rows()) / 2, (cols - initial.cols()) / 2);
+        }
+        auto tiled = std::make_unique<TiledLife>(std::move(store), m_config.maxIterations,
+                                                 m_config.cycleHistory);
+        tiled->setView(m_config.viewTop, m_config.viewLeft, m_config.viewRows, m_config.viewCols);
+        m_engine = std::move(tiled);
+        break;
+    }
+    case Engine::Distributed:
+        if (!spec) {
+            throw std::invalid_argument("Le moteur reparti ne gere que les regles B/S");
+        }
+        if (!resources) {
+            throw std::invalid_argument("Le moteur reparti n'est pas disponible ici");
+        }
+        m_engine = std::make_unique<DistributedLife>(initial, resources->createTransport(),
+                                                     m_config.maxIterations, m_config.workers,
+                                                     m_config.cycleHistory, *spec);
+        break;
+    case Engine::Dense:
+    default:
+        m_engine = std::make_unique<GameOfLife>(initial, std::move(m_rule), m_config.maxIterations,
+                                                m_config.kernel, m_config.threads,
+                                                m_config.cycleHistory);
+        break;
+    }
+
+    if (resumeFrom && !m_engine->supportsCheckpoint()) {
+        throw std::invalid_argument("Les points de reprise demandent le moteur dense");
+    }
+    attach(exporter, checkpoints);
+    if (resumeFrom) {
+        m_engine->restoreCheckpoint(resumeFrom->engine);
+        m_lastExported = resumeFrom->lastExported;
+        m_lastCheckpoint = m_engine->currentIteration();
     }
-    m_game = std::make_unique<GameOfLife>(initial, std::move(m_rule), m_config.maxIterations);
 }
 
+void SimulationService::attach(const IGridExporter* exporter, const ICheckpointStore* checkpoints) {
+    if (checkpoints && m_engine->currentStates()) {
+        throw std::invalid_argument("Les points de reprise ne gerent pas les regles multi-etats");
+    }
+    if (checkpoints && !m_engine->supportsCheckpoint()) {
+        throw std::invalid_argument("Les points de reprise demandent le moteur dense");
+    }
+    // le fichier de tuiles tient lieu d'export
+    m_exporter = m_config.engine == Engine::Tiled ? nullptr : exporter;
+    m_checkpoints = checkpoints;
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+std::int64_t nanosSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+} // namespace
+
 void SimulationService::step() {
-    if (!m_game) return;
-    m_game->step();
-    if (m_exporter) {
-        std::string base = m_config.outputBaseName.empty() ? "output" : m_config.outputBaseName;
-        m_exporter->exportGrid(m_game->currentGrid(), base, m_game->currentIteration());
+    if (!m_engine) return;
+    Clock::time_point start;
+    if (m_metrics) start = Clock::now();
+    m_engine->step();
+    GenerationMetrics metrics;
+    if (m_metrics) metrics.stepNanos = nanosSince(start);
+
+    const int iteration = m_engine->currentIteration();
+    // hashlife avance de 2^k generations : on exporte des qu'un multiple
+    // du pas est franchi
+    const int every = m_config.exportEvery;
+    if (m_exporter && every > 0 && iteration / every != m_lastExported / every) {
+        if (m_metrics) start = Clock::now();
+        exportCurrent();
+        // export asynchrone : copie et attente d'une place dans la file
+        if (m_metrics) metrics.exportNanos = std::max<std::int64_t>(nanosSince(start), 1);
+    }
+    if (m_metrics) {
+        const StepStats& stats = m_engine->lastStepStats();
+        metrics.iteration = iteration;
+        metrics.population = m_engine->population();
+        metrics.births = stats.births;
+        metrics.deaths = stats.deaths;
+        metrics.activeTiles = m_engine->activeTiles();
+        metrics.activeRegion = m_engine->activeRegion();
+        m_metrics->record(metrics);
     }
+    const int checkpointEvery = m_config.checkpointEvery;
+    if (m_checkpoints && checkpointEvery > 0
+        && iteration / checkpointEvery != m_lastCheckpoint / checkpointEvery) {
+        saveCheckpoint();
+    }
+}
+
+void SimulationService::finish() {
+    if (!m_engine) return;
+    const int iteration = m_engine->currentIteration();
+    if (m_exporter && iteration != m_lastExported) {
+        exportCurrent();
+    }
+    if (m_checkpoints) {
+        if (iteration != m_lastCheckpoint) saveCheckpoint();
+        m_checkpoints->finish();
+    }
+    if (m_exporter) m_exporter->finish();
+    if (m_metrics) m_metrics->finish();
+}
+
+void SimulationService::enableMetrics(int history, const IMetricsSink* sink) {
+    m_metrics = std::make_unique<MetricsRecorder>(history, sink);
+}
+
+void SimulationService::saveCheckpoint() {
+    m_checkpoint.config = m_config;
+    m_checkpoint.lastExported = m_lastExported;
+    m_engine->saveCheckpoint(m_checkpoint.engine);
+    m_checkpoints->save(m_checkpoint);
+    m_lastCheckpoint = m_engine->currentIteration();
+}
+
+void SimulationService::exportCurrent() {
+    std::string base = m_config.outputBaseName.empty() ? "output" : m_config.outputBaseName;
+    if (const StateGrid* states = m_engine->currentStates())
+        m_exporter->exportStates(*states, base, m_engine->currentIteration());
+    else
+        m_exporter->exportGrid(m_engine->currentGrid(), base, m_engine->currentIteration());
+    m_lastExported = m_engine->currentIteration();
 }
 
 const Grid& SimulationService::currentGrid() const {
-    return m_game->currentGrid();
+    return m_engine->currentGrid();
+}
+
+const StateGrid* SimulationService::currentStates() const {
+    return m_engine->currentStates();
 }
 
 bool SimulationService::isStable() const {
-    return m_game->isStable();
+    return m_engine->isStable();
 }
 
 bool SimulationService::hasFinished() const {
-    return m_game->hasFinished();
+    if (m_engine->hasFinished()) return true;
+    // oscillateur : les generations suivantes ne font que repeter le cycle
+    return m_config.stopOnCycle && m_engine->detectedPeriod() > 0;
+}
+
+int SimulationService::detectedPeriod() const {
+    return m_engine->detectedPeriod();
 }
 
 int SimulationService::currentIteration() const {
-    return m_game->currentIteration();
+    return m_engine->currentIteration();
+}
+
+long long SimulationService::activeTiles() const {
+    return m_engine->activeTiles();
+}
+
+long long SimulationService::tileCount() const {
+    return m_engine->tileCount();
+}
+
+long long SimulationService::population() const {
+    return m_engine->population();
 }
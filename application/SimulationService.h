@@ -2,9 +2,13 @@
 #include <memory>
 #include <string>
 #include "SimulationConfig.h"
-#include "GameOfLife.h"
+#include "LifeEngine.h"
 #include "IGridLoader.h"
 #include "IGridExporter.h"
+#include "ICheckpointStore.h"
+#include "IEngineResources.h"
+#include "IMetricsSink.h"
+#include "SimulationMetrics.h"
 #include "Rule.h"
 
 // Façade applicative orchestrant une simulation, indépendante de l'UI.
@@ -13,19 +17,60 @@ public:
     SimulationService(const SimulationConfig& config,
                       const IGridLoader& loader,
                       const IGridExporter* exporter,
-                      std::unique_ptr<Rule> rule);
+                      std::unique_ptr<Rule> rule,
+                      const ICheckpointStore* checkpoints = nullptr,
+                      const SimulationCheckpoint* resumeFrom = nullptr,
+                      const IEngineResources* resources = nullptr);
+    // checkpoints : point de reprise toutes les config.checkpointEvery
+    // générations et en fin de simulation (moteur dense, règles B/S).
+    // resumeFrom : reprend à cet état au lieu de charger config.inputFile.
+    // resources : ressources système des moteurs réparti et en fichier
+    // (obligatoires pour eux seuls).
 
-    void step(); // exécute une itération (et exporte si un exporter est fourni)
+    // remplace l'exporter et le magasin de points de reprise (nuls :
+    // désactivés), mêmes règles qu'au constructeur. Le moteur réparti crée
+    // ses processus (fork) dans le constructeur : un appelant dont
+    // l'exporter ou le magasin démarrent un thread construit le service
+    // sans eux, puis les branche ici (voir DistributedLife.h).
+    void attach(const IGridExporter* exporter, const ICheckpointStore* checkpoints);
+
+    // exécute une itération ; exporte si un exporter est fourni et que la
+    // génération tombe sur le pas d'export (SimulationConfig::exportEvery)
+    void step();
+    // exporte la dernière génération si elle ne l'a pas été, enregistre un
+    // dernier point de reprise puis termine l'export et les points de
+    // reprise : les erreurs d'écriture remontent ici
+    void finish();
+
+    // mesures par génération (durées du pas et de l'export, bilan, zone
+    // active) dans un tampon de history générations, transmises à sink s'il
+    // est fourni. Désactivées par défaut : aucun relevé d'horloge.
+    void enableMetrics(int history = 1024, const IMetricsSink* sink = nullptr);
+    const MetricsRecorder* metrics() const { return m_metrics.get(); } // nullptr si désactivées
 
     const Grid& currentGrid() const;
+    const StateGrid* currentStates() const; // nullptr hors règles Generations
     bool isStable() const;
-    bool hasFinished() const;
+    bool hasFinished() const;    // stable, cycle détecté (si stopOnCycle) ou max atteint
     int currentIteration() const;
+    int detectedPeriod() const;  // 0 si aucun cycle détecté
+    long long activeTiles() const; // tuiles recalculées au dernier pas
+    long long tileCount() const;
+    long long population() const;
+    const LifeEngine& engine() const { return *m_engine; }
 
 private:
+    void exportCurrent();
+    void saveCheckpoint();
+
     SimulationConfig m_config;
     const IGridLoader& m_loader;
     const IGridExporter* m_exporter; // peut être nul pour le mode graphique
     std::unique_ptr<Rule> m_rule;
-    std::unique_ptr<GameOfLife> m_game;
+    std::unique_ptr<LifeEngine> m_engine; // moteur choisi selon la configuration et la regle
+    int m_lastExported = 0;               // derniere generation exportee
+    const ICheckpointStore* m_checkpoints; // peut etre nul
+    SimulationCheckpoint m_checkpoint;    // tampon reutilise d'un point de reprise a l'autre
+    int m_lastCheckpoint = 0;
+    std::unique_ptr<MetricsRecorder> m_metrics; // nul si les mesures sont desactivees
 };
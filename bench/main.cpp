@@ -0,0 +1,289 @@
+#include "EnsembleLife.h"
+#include "GameOfLife.h"
+#include "GridExporter.h"
+#include "InitialStateLoader.h"
+#include "LifeKernel.h"
+#include "LifeRule.h"
+#include "RandomSoup.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Mesures de débit : pas de simulation, chargement et export de grilles.
+// Chaque mesure fait un tour de chauffe puis `reps` répétitions ; on
+// rapporte la médiane et le 95e centile du temps par répétition, convertis
+// en cellules par seconde. Les grilles sont des soupes aléatoires à graine
+// fixe (RandomSoup) : deux exécutions mesurent exactement le même travail.
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options {
+    int reps = 7;
+    int minSize = 64;
+    int maxSize = 16384;
+    int threads = 1;
+    std::string filter;   // "step", "soups", "ensemble", "load", "export" ou vide (tout)
+    std::string jsonPath; // sortie JSON (vide = aucune)
+};
+
+struct Result {
+    std::string kind;     // step, soups, ensemble, load, export
+    int rows = 0;
+    int cols = 0;
+    double density = 0.0;
+    bool toroidal = false;
+    double cellsPerRep = 0.0;  // cellules traitées par répétition
+    double bytesPerRep = 0.0;  // octets lus ou écrits (E/S), 0 sinon
+    double median = 0.0;       // secondes par répétition
+    double p95 = 0.0;
+};
+
+double seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// temps par répétition, trié
+template <class F>
+std::vector<double> measure(int reps, F run) {
+    run(); // chauffe : caches, pages du fichier, pool de threads
+    std::vector<double> times;
+    for (int i = 0; i < reps; ++i) {
+        Clock::time_point start = Clock::now();
+        run();
+        times.push_back(seconds(start));
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+// centile par rang le plus proche
+double percentile(const std::vector<double>& sorted, double p) {
+    std::size_t rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void summarise(Result& result, const std::vector<double>& times) {
+    result.median = percentile(times, 0.5);
+    result.p95 = percentile(times, 0.95);
+}
+
+std::vector<int> sizes(const Options& options) {
+    std::vector<int> out;
+    for (int n = options.minSize; n <= options.maxSize; n *= 4) out.push_back(n);
+    return out;
+}
+
+Result benchStep(const Options& options, int size, double density, bool toroidal) {
+    Result result;
+    result.kind = "step";
+    result.rows = result.cols = size;
+    result.density = density;
+    result.toroidal = toroidal;
+
+    Grid soup = RandomSoup::make(size, size, density, 0x5EEDull + size, toroidal);
+    GameOfLife game(soup, std::make_unique<LifeRule>(RuleSpec::conway()), INT_MAX,
+                    StepKernel::Bitwise, options.threads);
+    // ~10^8 cellules par repetition, au moins un pas
+    const double cells = static_cast<double>(size) * size;
+    const int steps = std::max(1, static_cast<int>(1e8 / cells));
+    result.cellsPerRep = cells * steps;
+    summarise(result, measure(options.reps, [&] {
+        for (int i = 0; i < steps; ++i) game.step();
+    }));
+    return result;
+}
+
+// 64 soupes 32 x 32 menees a leur fin (stables ou 1000 generations) : une
+// par GameOfLife (soups) ou toutes dans un EnsembleLife (ensemble). Meme
+// travail utile des deux cotes : les generations calculees par soupe.
+Result benchSoups(const Options& options, bool ensemble) {
+    Result result;
+    result.kind = ensemble ? "ensemble" : "soups";
+    result.rows = result.cols = 32;
+    result.density = 0.35;
+    const int maxIterations = 1000;
+    std::vector<Grid> soups;
+    for (int l = 0; l < EnsembleLife::kLanes; ++l)
+        soups.push_back(RandomSoup::make(32, 32, result.density, 0x50ull + l));
+
+    long long generations = 0;
+    auto runAlone = [&] {
+        generations = 0;
+        for (const Grid& soup : soups) {
+            GameOfLife game(soup, std::make_unique<LifeRule>(RuleSpec::conway()), maxIterations);
+            while (!game.hasFinished()) game.step();
+            generations += game.currentIteration();
+        }
+    };
+    auto runEnsemble = [&] {
+        EnsembleLife lanes(soups, RuleSpec::conway(), maxIterations);
+        while (lanes.finishedMask() != lanes.laneMask()) lanes.step();
+    };
+    std::vector<double> times = ensemble ? measure(options.reps, runEnsemble)
+                                         : measure(options.reps, runAlone);
+    if (ensemble) runAlone();
+    result.cellsPerRep = 32.0 * 32.0 * generations;
+    summarise(result, times);
+    return result;
+}
+
+long long fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in ? static_cast<long long>(in.tellg()) : 0;
+}
+
+Result benchExport(const Options& options, int size) {
+    Result result;
+    result.kind = "export";
+    result.rows = result.cols = size;
+    result.density = 0.35;
+    Grid soup = RandomSoup::make(size, size, result.density, 0xE5ull + size);
+    result.cellsPerRep = static_cast<double>(size) * size;
+    summarise(result, measure(options.reps, [&] {
+        GridExporter::exportGrid(soup, "bench_export", 0);
+    }));
+    result.bytesPerRep = static_cast<double>(fileSize("bench_export_0.txt"));
+    std::remove("bench_export_0.txt");
+    return result;
+}
+
+Result benchLoad(const Options& options, int size) {
+    Result result;
+    result.kind = "load";
+    result.rows = result.cols = size;
+    result.density = 0.35;
+    GridExporter::exportGrid(RandomSoup::make(size, size, result.density, 0x10Dull + size),
+                             "bench_load", 0);
+    result.cellsPerRep = static_cast<double>(size) * size;
+    result.bytesPerRep = static_cast<double>(fileSize("bench_load_0.txt"));
+    long long population = 0;
+    summarise(result, measure(options.reps, [&] {
+        population += InitialStateLoader::loadFromFile("bench_load_0.txt").population();
+    }));
+    std::remove("bench_load_0.txt");
+    return result;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(8) << "mesure" << std::right
+              << std::setw(8) << "taille" << std::setw(9) << "densite"
+              << std::setw(8) << "tore" << std::setw(14) << "cell/s med"
+              << std::setw(14) << "cell/s p95" << std::setw(11) << "Mo/s med" << "\n";
+}
+
+void print(const Result& r) {
+    std::cout << std::left << std::setw(8) << r.kind << std::right
+              << std::setw(8) << r.rows << std::setw(9) << r.density
+              << std::setw(8) << (r.toroidal ? "oui" : "non")
+              << std::setw(14) << std::setprecision(3) << r.cellsPerRep / r.median
+              << std::setw(14) << r.cellsPerRep / r.p95;
+    if (r.bytesPerRep > 0) std::cout << std::setw(11) << r.bytesPerRep / r.median / 1e6;
+    std::cout << std::endl;
+}
+
+void writeJson(const std::string& path, const Options& options, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + path);
+    }
+    out << std::setprecision(9);
+    out << "{\n"
+        << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+        << "  \"isa\": \"" << LifeKernel::isaName(LifeKernel::activeIsa()) << "\",\n"
+        << "  \"threads\": " << options.threads << ",\n"
+        << "  \"repetitions\": " << options.reps << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"kind\": \"" << r.kind << "\", \"rows\": " << r.rows
+            << ", \"cols\": " << r.cols << ", \"density\": " << r.density
+            << ", \"toroidal\": " << (r.toroidal ? "true" : "false")
+            << ", \"cells_per_rep\": " << r.cellsPerRep
+            << ", \"bytes_per_rep\": " << r.bytesPerRep
+            << ", \"median_s\": " << r.median << ", \"p95_s\": " << r.p95
+            << ", \"median_cells_per_s\": " << r.cellsPerRep / r.median
+            << ", \"p95_cells_per_s\": " << r.cellsPerRep / r.p95 << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    if (!out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + path);
+    }
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Valeur manquante pour " + arg);
+            return argv[++i];
+        };
+        if (arg == "--quick") { options.maxSize = 1024; options.reps = 3; }
+        else if (arg == "--reps") options.reps = std::max(1, std::stoi(value()));
+        else if (arg == "--min-size") options.minSize = std::max(1, std::stoi(value()));
+        else if (arg == "--max-size") options.maxSize = std::stoi(value());
+        else if (arg == "--threads") options.threads = std::stoi(value());
+        else if (arg == "--only") options.filter = value();
+        else if (arg == "--json") options.jsonPath = value();
+        else throw std::invalid_argument("Option inconnue : " + arg);
+    }
+    return options;
+}
+
+bool selected(const Options& options, const char* kind) {
+    return options.filter.empty() || options.filter == kind;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parseOptions(argc, argv);
+        std::vector<Result> results;
+        printHeader();
+
+        if (selected(options, "step")) {
+            const double densities[] = { 0.1, 0.35 };
+            for (int size : sizes(options))
+                for (double density : densities)
+                    for (int toroidal = 0; toroidal < 2; ++toroidal) {
+                        results.push_back(benchStep(options, size, density, toroidal != 0));
+                        print(results.back());
+                    }
+        }
+        for (int ensemble = 0; ensemble < 2; ++ensemble) {
+            if (!selected(options, ensemble ? "ensemble" : "soups")) continue;
+            results.push_back(benchSoups(options, ensemble != 0));
+            print(results.back());
+        }
+        // E/S texte : au plus 4096^2 (fichier de 32 Mo)
+        for (int size : sizes(options)) {
+            if (size > 4096) break;
+            if (selected(options, "load")) {
+                results.push_back(benchLoad(options, size));
+                print(results.back());
+            }
+            if (selected(options, "export")) {
+                results.push_back(benchExport(options, size));
+                print(results.back());
+            }
+        }
+
+        if (!options.jsonPath.empty()) writeJson(options.jsonPath, options, results);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
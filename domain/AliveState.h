@@ -5,4 +5,10 @@ class AliveState : public CellState {
 public:
     bool isAlive() const override { return true; }
     CellState* clone() const override { return new AliveState(*this); }
+
+    // instance partagée et immuable (poids-mouche), ne pas libérer
+    static const AliveState& instance() {
+        static const AliveState shared;
+        return shared;
+    }
 };
@@ -0,0 +1,24 @@
+#pragma once
+#include <stdexcept>
+
+// Rectangle englobant les cellules vivantes d'un univers non borné
+// (coordonnées signées, vide si bottom < top).
+struct BoundingBox {
+    long long top = 0;
+    long long left = 0;
+    long long bottom = -1;
+    long long right = -1;
+
+    bool empty() const { return bottom < top; }
+    long long rows() const { return empty() ? 0 : bottom - top + 1; }
+    long long cols() const { return empty() ? 0 : right - left + 1; }
+};
+
+// refuse de matérialiser en grille dense une fenêtre démesurée
+inline void checkViewSize(const BoundingBox& box) {
+    const long long maxSide = 1LL << 30;
+    if (box.rows() > maxSide || box.cols() > maxSide
+        || box.rows() * box.cols() > (1LL << 32)) {
+        throw std::runtime_error("Fenetre d'export trop grande : definir une vue (--view)");
+    }
+}
@@ -1,63 +1,33 @@
 #pragma once
 #include "CellState.h"
 
+class Grid;
+
+// Vue légère sur une cellule d'une Grid. Le stockage réel est compact
+// (un bit par cellule) : Cell ne possède aucun état alloué et conserve
+// seulement l'API historique (row/col, isAlive, setState).
 class Cell {
 private:
+    Grid* m_grid;
     int m_row;
     int m_col;
-    CellState* m_state;
 
 public:
-    Cell(int row, int col, CellState* state)
-        : m_row(row), m_col(col), m_state(state) {}
-
-    // deep copy
-    Cell(const Cell& other)
-        : m_row(other.m_row), m_col(other.m_col),
-          m_state(other.m_state ? other.m_state->clone() : nullptr) {}
-
-    // move
-    Cell(Cell&& other) noexcept
-        : m_row(other.m_row), m_col(other.m_col), m_state(other.m_state) {
-        other.m_state = nullptr;
-    }
-
-    Cell& operator=(const Cell& other) {
-        if (this != &other) {
-            m_row = other.m_row;
-            m_col = other.m_col;
-            delete m_state;
-            m_state = other.m_state ? other.m_state->clone() : nullptr;
-        }
-        return *this;
-    }
-
-    Cell& operator=(Cell&& other) noexcept {
-        if (this != &other) {
-            m_row = other.m_row;
-            m_col = other.m_col;
-            delete m_state;
-            m_state = other.m_state;
-            other.m_state = nullptr;
-        }
-        return *this;
-    }
-
-    ~Cell() {
-        delete m_state;
-    }
+    Cell(Grid* grid, int row, int col)
+        : m_grid(grid), m_row(row), m_col(col) {}
 
     int row() const { return m_row; }
     int col() const { return m_col; }
 
-    bool isAlive() const {
-        return m_state && m_state->isAlive();
-    }
+    bool isAlive() const;
 
-    void setState(CellState* newState) {
-        delete m_state;
-        m_state = newState;
-    }
+    // prend possession de l'état fourni : seul le bit vivant/mort est
+    // conservé dans la grille, l'objet est libéré aussitôt
+    void setState(CellState* newState);
+    // copie le bit vivant/mort d'un état (partagé ou non), sans en prendre
+    // possession
+    void setState(const CellState& state);
 
-    const CellState* state() const { return m_state; }
+    // état partagé (AliveState/DeadState statiques), ne pas libérer
+    const CellState* state() const;
 };
@@ -1,20 +1,8 @@
 #pragma once
-#include "Rule.h"
-#include "AliveState.h"
-#include "DeadState.h"
+#include "LifeRule.h"
 
-class ConwayRule : public Rule {
+// B3/S23 : naissance sur 3 voisins, survie sur 2 ou 3
+class ConwayRule : public LifeRule {
 public:
-    CellState* nextState(const Cell& cell,
-                         const Grid& grid) const override {
-        int alive = grid.countAliveNeighbors(cell.row(), cell.col());
-        bool cur = cell.isAlive();
-
-        if (cur && (alive == 2 || alive == 3))
-            return new AliveState();
-        if (!cur && alive == 3)
-            return new AliveState();
-
-        return new DeadState();
-    }
+    ConwayRule() : LifeRule(RuleSpec::conway()) {}
 };
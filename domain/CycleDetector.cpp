@@ -0,0 +1,48 @@
+#include "CycleDetector.h"
+#include <algorithm>
+
+CycleDetector::CycleDetector(int historySize)
+    : m_entries(static_cast<std::size_t>(std::max(historySize, 1))),
+      m_next(0),
+      m_count(0),
+      m_period(0)
+{
+}
+
+int CycleDetector::record(std::uint64_t hash, long long population, int iteration) {
+    // la plus recente generation identique donne la plus petite periode
+    m_period = 0;
+    const int size = static_cast<int>(m_entries.size());
+    for (int k = 1; k <= m_count; ++k) {
+        const Entry& e = m_entries[(m_next - k + size) % size];
+        if (e.hash == hash && e.population == population) {
+            m_period = iteration - e.iteration;
+            break;
+        }
+    }
+
+    m_entries[m_next] = Entry{ hash, population, iteration };
+    m_next = (m_next + 1) % size;
+    if (m_count < size) ++m_count;
+    return m_period;
+}
+
+void CycleDetector::history(std::vector<Entry>& out) const {
+    const int size = static_cast<int>(m_entries.size());
+    out.clear();
+    for (int k = m_count; k >= 1; --k)
+        out.push_back(m_entries[(m_next - k + size) % size]);
+}
+
+void CycleDetector::restore(const std::vector<Entry>& entries, int period) {
+    const int size = static_cast<int>(m_entries.size());
+    const int skip = std::max(static_cast<int>(entries.size()) - size, 0);
+    m_next = 0;
+    m_count = 0;
+    for (std::size_t i = skip; i < entries.size(); ++i) {
+        m_entries[m_next] = entries[i];
+        m_next = (m_next + 1) % size;
+        ++m_count;
+    }
+    m_period = period;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Historique circulaire des empreintes (hash 64 bits + population) des
+// dernières générations : détecte le retour à une génération déjà vue.
+class CycleDetector {
+public:
+    struct Entry {
+        std::uint64_t hash;
+        long long population;
+        int iteration;
+    };
+
+private:
+    std::vector<Entry> m_entries;
+    int m_next;
+    int m_count;
+    int m_period;
+
+public:
+    explicit CycleDetector(int historySize = 64);
+
+    // enregistre une génération ; retourne la période détectée (0 si aucune)
+    int record(std::uint64_t hash, long long population, int iteration);
+
+    int period() const { return m_period; } // 1 = stable, N = oscillateur
+    int historySize() const { return static_cast<int>(m_entries.size()); }
+
+    // historique de la plus ancienne à la plus récente génération (points
+    // de reprise) ; restore() ne garde que les historySize() dernières
+    void history(std::vector<Entry>& out) const;
+    void restore(const std::vector<Entry>& entries, int period);
+};
@@ -5,4 +5,10 @@ class DeadState : public CellState {
 public:
     bool isAlive() const override { return false; }
     CellState* clone() const override { return new DeadState(*this); }
+
+    // instance partagée et immuable (poids-mouche), ne pas libérer
+    static const DeadState& instance() {
+        static const DeadState shared;
+        return shared;
+    }
 };
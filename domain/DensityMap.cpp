@@ -0,0 +1,200 @@
+#include "DensityMap.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+
+std::uint64_t lowBits(int n) {
+    return n >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1;
+}
+
+// cellules vivantes des colonnes [begin, end) d'une ligne compacte
+int countBits(const std::uint64_t* words, int begin, int end) {
+    const int first = begin >> 6;
+    const int last = (end - 1) >> 6;
+    if (first == last)
+        return __builtin_popcountll((words[first] >> (begin & 63)) & lowBits(end - begin));
+    int count = __builtin_popcountll(words[first] >> (begin & 63));
+    for (int w = first + 1; w < last; ++w) count += __builtin_popcountll(words[w]);
+    return count + __builtin_popcountll(words[last] & lowBits(((end - 1) & 63) + 1));
+}
+
+int countAlive(const std::uint8_t* cells, int begin, int end) {
+    return static_cast<int>(std::count(cells + begin, cells + end, std::uint8_t(1)));
+}
+
+void checkRegion(int gridRows, int gridCols, int row0, int col0, int rows, int cols, int block) {
+    if (block <= 0 || rows <= 0 || cols <= 0 || row0 < 0 || col0 < 0
+        || row0 + rows > gridRows || col0 + cols > gridCols) {
+        throw std::invalid_argument("Region de reduction hors de la grille");
+    }
+}
+
+// ligne de blocs outRow ; rowCount(r, begin, end) compte une ligne de
+// cellules. Parcours ligne par ligne (acces contigus), par paquets de
+// kChunk blocs accumules sur la pile.
+template <class Count>
+void sampleBlocks(int row0, int col0, int rows, int cols, int block, int outRow,
+                  std::uint8_t* out, Count rowCount)
+{
+    const int kChunk = 256;
+    const int rBegin = row0 + outRow * block;
+    const int rEnd = std::min(rBegin + block, row0 + rows);
+    const int outCols = DensityMap::blockCount(cols, block);
+    for (int j0 = 0; j0 < outCols; j0 += kChunk) {
+        const int j1 = std::min(j0 + kChunk, outCols);
+        long long alive[kChunk] = {};
+        for (int r = rBegin; r < rEnd; ++r) {
+            for (int j = j0; j < j1; ++j) {
+                const int cBegin = col0 + j * block;
+                alive[j - j0] += rowCount(r, cBegin, std::min(cBegin + block, col0 + cols));
+            }
+        }
+        for (int j = j0; j < j1; ++j) {
+            const int cBegin = col0 + j * block;
+            const long long area = static_cast<long long>(rEnd - rBegin)
+                                 * (std::min(cBegin + block, col0 + cols) - cBegin);
+            out[j] = static_cast<std::uint8_t>((alive[j - j0] * 255 + area / 2) / area);
+        }
+    }
+}
+
+// popcount par champs de Width bits (2, 4, ..., 64) : reduction SWAR, chaque
+// champ du resultat porte le nombre de bits a 1 du champ correspondant
+template <int Width>
+inline std::uint64_t fieldCounts(std::uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    if (Width == 2) return x;
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    if (Width == 4) return x;
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    if (Width == 8) return x;
+    x = (x + (x >> 8)) & 0x00FF00FF00FF00FFull;
+    if (Width == 16) return x;
+    x = (x + (x >> 16)) & 0x0000FFFF0000FFFFull;
+    if (Width == 32) return x;
+    return (x + (x >> 32)) & 0xFFFFFFFFull;
+}
+
+// Blocs puissance de deux alignes sur col0 (Width = min(block, 64)) : chaque
+// mot est compte champ par champ (un champ = un bloc, ou un mot entier pour
+// les blocs de plus de 64 colonnes), sans comptage bloc par bloc.
+template <int Width>
+void sampleAligned(const Grid& grid, int row0, int col0, int rows, int cols, int block,
+                   int outRow, std::uint8_t* out)
+{
+    const int kChunk = 256;                       // blocs par paquet
+    const int kFields = 64 / Width;
+    const std::uint64_t fieldMask = lowBits(Width);
+    const int blockShift = __builtin_ctz(static_cast<unsigned>(block));
+    const int rBegin = row0 + outRow * block;
+    const int rEnd = std::min(rBegin + block, row0 + rows);
+    const int colEnd = col0 + cols;
+    const int outCols = DensityMap::blockCount(cols, block);
+
+    for (int j0 = 0; j0 < outCols; j0 += kChunk) {
+        const int j1 = std::min(j0 + kChunk, outCols);
+        const int cBegin = col0 + j0 * block;
+        const int cEnd = std::min(col0 + j1 * block, colEnd);
+        const int wBegin = cBegin >> 6;
+        const int wLast = (cEnd - 1) >> 6;
+        const std::uint64_t lastMask = lowBits(((cEnd - 1) & 63) + 1);
+        long long alive[kChunk] = {};
+        std::uint64_t sums[kChunk] = {}; // champs de 8 bits et plus : lignes sommees par mot
+
+        for (int r = rBegin; r < rEnd; ++r) {
+            const std::uint64_t* words = grid.rowWords(r);
+            for (int w = wBegin; w <= wLast; ++w) {
+                const std::uint64_t x = fieldCounts<Width>(w == wLast ? words[w] & lastMask : words[w]);
+                if (Width == 64) {
+                    alive[((w * 64 - col0) >> blockShift) - j0] += static_cast<long long>(x);
+                }
+                else if (Width >= 8) {
+                    sums[w - wBegin] += x; // au plus Width * Width par champ
+                }
+                else {
+                    // champs de 2 ou 4 bits : repartis a chaque ligne
+                    for (int f = 0; f < kFields; ++f) {
+                        const int col = w * 64 + f * Width;
+                        if (col >= cBegin && col < cEnd)
+                            alive[((col - col0) >> blockShift) - j0] += (x >> (f * Width)) & fieldMask;
+                    }
+                }
+            }
+        }
+        if (Width >= 8 && Width < 64) {
+            for (int w = wBegin; w <= wLast; ++w)
+                for (int f = 0; f < kFields; ++f) {
+                    const int col = w * 64 + f * Width;
+                    if (col >= cBegin && col < cEnd)
+                        alive[((col - col0) >> blockShift) - j0] += (sums[w - wBegin] >> (f * Width)) & fieldMask;
+                }
+        }
+
+        for (int j = j0; j < j1; ++j) {
+            const int bBegin = col0 + j * block;
+            const long long area = static_cast<long long>(rEnd - rBegin)
+                                 * (std::min(bBegin + block, colEnd) - bBegin);
+            out[j] = static_cast<std::uint8_t>((alive[j - j0] * 255 + area / 2) / area);
+        }
+    }
+}
+
+// faux si la region ne se prete pas au comptage par champs
+bool sampleAligned(const Grid& grid, int row0, int col0, int rows, int cols, int block,
+                   int outRow, std::uint8_t* out)
+{
+    const int width = std::min(block, 64);
+    if (block < 2 || (block & (block - 1)) != 0 || col0 % width != 0) return false;
+    switch (width) {
+    case 2:  sampleAligned<2>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    case 4:  sampleAligned<4>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    case 8:  sampleAligned<8>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    case 16: sampleAligned<16>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    case 32: sampleAligned<32>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    default: sampleAligned<64>(grid, row0, col0, rows, cols, block, outRow, out); break;
+    }
+    return true;
+}
+
+} // namespace
+
+void DensityMap::sampleRow(const Grid& grid, int row0, int col0, int rows, int cols,
+                           int block, int outRow, std::uint8_t* out)
+{
+    checkRegion(grid.rows(), grid.cols(), row0, col0, rows, cols, block);
+    if (sampleAligned(grid, row0, col0, rows, cols, block, outRow, out)) return;
+    sampleBlocks(row0, col0, rows, cols, block, outRow, out,
+                 [&grid](int r, int begin, int end) { return countBits(grid.rowWords(r), begin, end); });
+}
+
+void DensityMap::sampleRow(const StateGrid& states, int row0, int col0, int rows, int cols,
+                           int block, int outRow, std::uint8_t* out)
+{
+    checkRegion(states.rows(), states.cols(), row0, col0, rows, cols, block);
+    sampleBlocks(row0, col0, rows, cols, block, outRow, out,
+                 [&states](int r, int begin, int end) { return countAlive(states.row(r), begin, end); });
+}
+
+void DensityMap::sample(const Grid& grid, int row0, int col0, int rows, int cols,
+                        int block, std::vector<std::uint8_t>& out)
+{
+    checkRegion(grid.rows(), grid.cols(), row0, col0, rows, cols, block);
+    const int outRows = blockCount(rows, block);
+    const int outCols = blockCount(cols, block);
+    out.resize(static_cast<std::size_t>(outRows) * outCols);
+    for (int i = 0; i < outRows; ++i)
+        sampleRow(grid, row0, col0, rows, cols, block, i, &out[static_cast<std::size_t>(i) * outCols]);
+}
+
+void DensityMap::sample(const StateGrid& states, int row0, int col0, int rows, int cols,
+                        int block, std::vector<std::uint8_t>& out)
+{
+    checkRegion(states.rows(), states.cols(), row0, col0, rows, cols, block);
+    const int outRows = blockCount(rows, block);
+    const int outCols = blockCount(cols, block);
+    out.resize(static_cast<std::size_t>(outRows) * outCols);
+    for (int i = 0; i < outRows; ++i)
+        sampleRow(states, row0, col0, rows, cols, block, i, &out[static_cast<std::size_t>(i) * outCols]);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "StateGrid.h"
+
+// Réduction d'une région de grille en blocs de block×block cellules : un
+// niveau 0..255 par bloc, proportionnel à la part de cellules vivantes
+// (état 1 pour les grilles multi-états). Sert aux vues dézoomées, où un
+// pixel d'écran couvre plusieurs cellules : seule la région demandée est
+// lue, le coût suit le nombre de blocs produits et non la taille de la
+// grille.
+//
+// La région [row0, row0 + rows) × [col0, col0 + cols) doit être dans la
+// grille. out reçoit blockRows(rows, block) lignes de blockCols(cols, block)
+// niveaux ; les blocs du bord droit et du bas peuvent être partiels, leur
+// niveau est rapporté à leur surface réelle.
+class DensityMap {
+public:
+    static int blockCount(int cells, int block) { return (cells + block - 1) / block; }
+
+    static void sample(const Grid& grid, int row0, int col0, int rows, int cols,
+                       int block, std::vector<std::uint8_t>& out);
+    static void sample(const StateGrid& states, int row0, int col0, int rows, int cols,
+                       int block, std::vector<std::uint8_t>& out);
+
+    // une seule ligne de blocs (outRow = indice de la ligne de blocs dans la
+    // région) : met à jour une vue déjà réduite après un changement local
+    static void sampleRow(const Grid& grid, int row0, int col0, int rows, int cols,
+                          int block, int outRow, std::uint8_t* out);
+    static void sampleRow(const StateGrid& states, int row0, int col0, int rows, int cols,
+                          int block, int outRow, std::uint8_t* out);
+};
@@ -0,0 +1,141 @@
+#include "DistributedLife.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+DistributedLife::DistributedLife(const Grid& initial,
+                                 std::unique_ptr<HaloTransport> transport,
+                                 int maxIterations,
+                                 int workers,
+                                 int cycleHistory,
+                                 const RuleSpec& rule)
+    : m_rows(initial.rows()),
+      m_cols(initial.cols()),
+      m_toroidal(initial.toroidal()),
+      m_maxIterations(maxIterations),
+      m_transport(std::move(transport)),
+      m_population(initial.population()),
+      m_hash(initial.hash()),
+      m_cycles(cycleHistory),
+      m_grid(initial)
+{
+    if (!m_transport) {
+        throw std::invalid_argument("Le moteur reparti demande un transport");
+    }
+    if (rule.isGenerations()) {
+        throw std::invalid_argument("Regle multi-etats : utiliser GenerationsLife");
+    }
+    if (m_rows == 0 || m_cols == 0) {
+        throw std::invalid_argument("Le moteur reparti demande une grille non vide");
+    }
+    m_rowKernel = LifeKernel::RowKernel(rule);
+    if (workers <= 0) workers = WorkerPool::hardwareThreads();
+    workers = std::min(workers, m_rows);
+
+    // bandes de hauteurs egales a une ligne pres
+    m_layout.wordsPerRow = initial.wordsPerRow();
+    m_layout.firstRows.resize(workers + 1);
+    for (int w = 0; w <= workers; ++w)
+        m_layout.firstRows[w] = static_cast<int>(static_cast<long long>(m_rows) * w / workers);
+    m_reports.resize(workers);
+
+    m_transport->start(m_layout, initial, [this](int worker) { runWorker(worker); });
+    m_cycles.record(m_hash, m_population, 0);
+}
+
+DistributedLife::~DistributedLife() {
+    // les travailleurs s'arretent avant la destruction du reste du moteur
+    m_transport.reset();
+}
+
+// Un travailleur ne connait que sa bande et, a chaque generation, la
+// derniere ligne de son voisin du dessus et la premiere de celui du
+// dessous. Sa generation locale sert de parite aux lignes de bord.
+void DistributedLife::runWorker(int worker) {
+    HaloTransport& transport = *m_transport;
+    const int rows = m_layout.rows(worker);
+    const int words = m_layout.wordsPerRow;
+    const std::uint64_t firstIndex = static_cast<std::uint64_t>(m_layout.firstRows[worker]) * words;
+    // hors tore, les bords haut et bas de la grille restent morts
+    const bool hasAbove = m_toroidal || worker > 0;
+    const bool hasBelow = m_toroidal || worker + 1 < m_layout.workers();
+
+    Grid strip(rows, m_cols, false);
+    Grid next(rows, m_cols, false);
+    std::vector<std::uint64_t> above(words), below(words);
+    transport.receiveStrip(worker, strip.rowWords(0));
+    int generation = 0;
+    transport.sendHalo(worker, generation, strip.rowWords(0), strip.rowWords(rows - 1));
+
+    for (;;) {
+        const HaloTransport::Command command = transport.receiveCommand(worker);
+        if (command == HaloTransport::Command::Stop) return;
+        if (command == HaloTransport::Command::Gather) {
+            transport.sendStrip(worker, strip.rowWords(0));
+            continue;
+        }
+        transport.receiveHalo(worker, generation, above.data(), below.data());
+        StepStats stats;
+        for (int r = 0; r < rows; ++r) {
+            const std::uint64_t* up = r > 0 ? strip.rowWords(r - 1)
+                                            : (hasAbove ? above.data() : nullptr);
+            const std::uint64_t* down = r + 1 < rows ? strip.rowWords(r + 1)
+                                                     : (hasBelow ? below.data() : nullptr);
+            LifeKernel::stepRow(up, strip.rowWords(r), down, next.rowWords(r),
+                                m_cols, m_toroidal, m_rowKernel);
+            accumulateRow(stats, strip.rowWords(r), next.rowWords(r), words,
+                          firstIndex + static_cast<std::uint64_t>(r) * words);
+        }
+        strip.swap(next);
+        ++generation;
+        transport.sendHalo(worker, generation, strip.rowWords(0), strip.rowWords(rows - 1));
+        transport.sendReport(worker, stats);
+    }
+}
+
+void DistributedLife::step() {
+    m_transport->sendCommand(HaloTransport::Command::Step);
+    m_transport->receiveReports(m_reports);
+    StepStats stats;
+    for (const StepStats& report : m_reports) stats += report;
+    ++m_currentIteration;
+
+    m_lastStats = stats;
+    m_population += stats.births - stats.deaths;
+    m_hash += stats.hashDelta;
+    m_cycles.record(m_hash, m_population, m_currentIteration);
+}
+
+bool DistributedLife::hasFinished() const {
+    if (m_currentIteration == 0) return false; // aucune etape effectuee
+    return isStable() || m_currentIteration >= m_maxIterations;
+}
+
+const Grid& DistributedLife::currentGrid() const {
+    if (m_gridIteration != m_currentIteration) {
+        m_transport->sendCommand(HaloTransport::Command::Gather);
+        m_transport->receiveGrid(m_grid);
+        m_gridIteration = m_currentIteration;
+    }
+    return m_grid;
+}
+
+void DistributedLife::saveCheckpoint(EngineCheckpoint& checkpoint) const {
+    checkpoint.grid = currentGrid();
+    checkpoint.iteration = m_currentIteration;
+    checkpoint.lastStats = m_lastStats;
+    checkpoint.period = m_cycles.period();
+    m_cycles.history(checkpoint.history);
+}
+
+void DistributedLife::restoreCheckpoint(const EngineCheckpoint& checkpoint) {
+    // les travailleurs ont deja leur bande : seule la grille de
+    // construction est acceptee
+    if (!checkpoint.grid.equals(currentGrid()) || checkpoint.grid.toroidal() != m_toroidal) {
+        throw std::invalid_argument("Point de reprise incompatible avec la grille");
+    }
+    m_currentIteration = checkpoint.iteration;
+    m_gridIteration = m_currentIteration;
+    m_lastStats = checkpoint.lastStats;
+    m_cycles.restore(checkpoint.history, checkpoint.period);
+}
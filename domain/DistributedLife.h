@@ -0,0 +1,85 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "HaloTransport.h"
+#include "LifeEngine.h"
+#include "LifeKernel.h"
+#include "RuleSpec.h"
+#include "StepStats.h"
+
+// Moteur dense réparti : la grille est découpée en bandes de lignes
+// complètes, chacune calculée par un travailleur (un processus avec
+// SharedMemoryTransport) qui n'en garde que sa part en mémoire. À
+// chaque génération, les travailleurs échangent leurs lignes de bord avec
+// leurs voisins ; les bandes couvrant toute la largeur, le repli torique
+// gauche/droite reste local et seul le repli haut/bas passe par un échange
+// (entre la dernière et la première bande).
+//
+// Le coordinateur (ce processus) recueille le bilan de chaque bande :
+// population, empreinte, stabilité, cycles et hasFinished() se comportent
+// comme ceux de GameOfLife. La grille complète n'est assemblée qu'à la
+// demande (currentGrid(), exports, points de reprise).
+class DistributedLife : public LifeEngine {
+public:
+    // transport : fourni par l'appelant (infrastructure), démarré ici.
+    // workers : nombre de bandes (0 = un par coeur), borné au nombre de
+    // lignes. Lève std::invalid_argument sans transport, pour une grille
+    // vide ou une règle multi-états. Un transport par processus (fork)
+    // impose de construire le moteur avant tout autre thread du processus
+    // (voir SharedMemoryTransport.h).
+    DistributedLife(const Grid& initial,
+                    std::unique_ptr<HaloTransport> transport,
+                    int maxIterations,
+                    int workers = 0,
+                    int cycleHistory = 64,
+                    const RuleSpec& rule = RuleSpec::conway());
+    ~DistributedLife() override;
+
+    DistributedLife(const DistributedLife&) = delete;
+    DistributedLife& operator=(const DistributedLife&) = delete;
+
+    void step() override;
+    bool isStable() const override { return m_lastStats.changed() == 0; }
+    bool hasFinished() const override;
+    int currentIteration() const override { return m_currentIteration; }
+    int detectedPeriod() const override { return m_cycles.period(); }
+    long long population() const override { return m_population; }
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+
+    // bandes rassemblées depuis les travailleurs (une fois par génération)
+    const Grid& currentGrid() const override;
+
+    // toutes les bandes sont calculées à chaque pas
+    long long activeTiles() const override { return workers(); }
+    long long tileCount() const override { return workers(); }
+    int workers() const { return m_layout.workers(); }
+    int firstRow(int worker) const { return m_layout.firstRows[worker]; }
+
+    bool supportsCheckpoint() const override { return true; }
+    void saveCheckpoint(EngineCheckpoint& checkpoint) const override;
+    // checkpoint.grid doit être la grille de construction du moteur
+    void restoreCheckpoint(const EngineCheckpoint& checkpoint) override;
+
+private:
+    void runWorker(int worker); // boucle d'un travailleur (processus fils)
+
+    int m_rows;
+    int m_cols;
+    bool m_toroidal;
+    int m_maxIterations;
+    LifeKernel::RowKernel m_rowKernel;
+    HaloTransport::Layout m_layout;
+    std::unique_ptr<HaloTransport> m_transport;
+
+    int m_currentIteration = 0;
+    StepStats m_lastStats;
+    long long m_population;
+    std::uint64_t m_hash;
+    CycleDetector m_cycles;
+    std::vector<StepStats> m_reports;
+
+    mutable Grid m_grid;               // dernière grille assemblée
+    mutable int m_gridIteration = 0;   // génération de m_grid
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <vector>
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "StepStats.h"
+
+// État d'un moteur à deux états suffisant pour reprendre une simulation à
+// l'identique : génération courante, compteur d'itérations, bilan du
+// dernier pas (stabilité) et historique de détection des cycles.
+// Réutilisable d'un point de reprise à l'autre : à dimensions égales, la
+// copie de la grille ne réalloue pas.
+struct EngineCheckpoint {
+    Grid grid;
+    int iteration = 0;
+    StepStats lastStats;
+    int period = 0;
+    std::vector<CycleDetector::Entry> history; // de la plus ancienne à la plus récente
+};
@@ -0,0 +1,316 @@
+#include "EnsembleLife.h"
+#include "LifeKernel.h"
+#include "LifeWord.h"
+#include "StepStats.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENSEMBLE_X86 1
+#endif
+
+namespace {
+
+typedef std::uint64_t u64;
+
+// transposition d'une matrice 64 x 64 bits en place : le bit j de a[i]
+// passe au bit i de a[j] (echanges de blocs de 32, 16, ..., 1)
+void transpose64(u64 a[64]) {
+    u64 m = 0x00000000FFFFFFFFull;
+    for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            const u64 t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+// une ligne de cellules [1, cols] (bordure en 0 et cols + 1), V cellules
+// voisines par operation ; retourne les voies modifiees de la ligne
+template <class R, class V>
+__attribute__((always_inline)) inline u64 ensembleRow(
+    const RuleSpec& rule, const u64* up, const u64* mid, const u64* down, u64* out,
+    int cols, u64 active)
+{
+    const int width = sizeof(V) / sizeof(u64);
+    V keep, changed;
+    for (int k = 0; k < width; ++k) {
+        keep[k] = active;
+        changed[k] = 0;
+    }
+    int c = 1;
+    for (; c + width - 1 <= cols; c += width) {
+        V n[3][3];
+        const u64* src[3] = { up, mid, down };
+        for (int k = 0; k < 3; ++k)
+            for (int d = 0; d < 3; ++d) std::memcpy(&n[k][d], src[k] + c - 1 + d, sizeof(V));
+        V next;
+        R::template word<V>(rule, n[0][0], n[0][1], n[0][2], n[1][0], n[1][1], n[1][2],
+                            n[2][0], n[2][1], n[2][2], next);
+        // voies inactives : cellule recopiee
+        next = (next & keep) | (n[1][1] & ~keep);
+        changed |= next ^ n[1][1];
+        std::memcpy(out + c, &next, sizeof(V));
+    }
+    u64 rowChanged = 0;
+    for (int k = 0; k < width; ++k) rowChanged |= changed[k];
+    for (; c <= cols; ++c) {
+        u64 next;
+        R::template word<u64>(rule, up[c - 1], up[c], up[c + 1], mid[c - 1], mid[c], mid[c + 1],
+                              down[c - 1], down[c], down[c + 1], next);
+        next = (next & active) | (mid[c] & ~active);
+        rowChanged |= next ^ mid[c];
+        out[c] = next;
+    }
+    return rowChanged;
+}
+
+typedef u64 v1u64 __attribute__((vector_size(8)));
+
+template <class R>
+u64 rowScalar(const RuleSpec& rule, const u64* up, const u64* mid, const u64* down, u64* out,
+              int cols, u64 active)
+{
+    return ensembleRow<R, v1u64>(rule, up, mid, down, out, cols, active);
+}
+
+#ifdef ENSEMBLE_X86
+typedef u64 v2u64 __attribute__((vector_size(16)));
+typedef u64 v4u64 __attribute__((vector_size(32)));
+
+template <class R>
+__attribute__((target("sse2")))
+u64 rowSse2(const RuleSpec& rule, const u64* up, const u64* mid, const u64* down, u64* out,
+            int cols, u64 active)
+{
+    return ensembleRow<R, v2u64>(rule, up, mid, down, out, cols, active);
+}
+
+// transpose64() sur 16 vecteurs de 4 mots : echanges de blocs de 32 a 4
+// entre vecteurs, de 2 et 1 par permutation des mots de deux vecteurs
+__attribute__((target("avx2")))
+void transposeAvx2(u64 a[64]) {
+    typedef long long v4i64 __attribute__((vector_size(32)));
+    v4u64 v[16];
+    std::memcpy(v, a, sizeof(v));
+    u64 m = 0x00000000FFFFFFFFull;
+    for (int j = 32; j >= 4; j >>= 1, m ^= m << j) {
+        const int jv = j / 4;
+        for (int k = 0; k < 16; k = ((k | jv) + 1) & ~jv) {
+            const v4u64 t = ((v[k] >> j) ^ v[k | jv]) & m;
+            v[k] ^= t << j;
+            v[k | jv] ^= t;
+        }
+    }
+    const v4i64 low = { 0, 1, 4, 5 }, high = { 2, 3, 6, 7 };
+    const v4i64 even = { 0, 2, 4, 6 }, odd = { 1, 3, 5, 7 };
+    const v4i64 mixLow = { 0, 4, 1, 5 }, mixHigh = { 2, 6, 3, 7 };
+    for (int k = 0; k < 16; k += 2) {
+        v4u64 lo = __builtin_shuffle(v[k], v[k + 1], low);
+        v4u64 hi = __builtin_shuffle(v[k], v[k + 1], high);
+        v4u64 t = ((lo >> 2) ^ hi) & 0x3333333333333333ull;
+        lo ^= t << 2;
+        hi ^= t;
+        const v4u64 x = __builtin_shuffle(lo, hi, low);
+        const v4u64 y = __builtin_shuffle(lo, hi, high);
+        lo = __builtin_shuffle(x, y, even);
+        hi = __builtin_shuffle(x, y, odd);
+        t = ((lo >> 1) ^ hi) & 0x5555555555555555ull;
+        lo ^= t << 1;
+        hi ^= t;
+        v[k] = __builtin_shuffle(lo, hi, mixLow);
+        v[k + 1] = __builtin_shuffle(lo, hi, mixHigh);
+    }
+    std::memcpy(a, v, sizeof(v));
+}
+
+template <class R>
+__attribute__((target("avx2")))
+u64 rowAvx2(const RuleSpec& rule, const u64* up, const u64* mid, const u64* down, u64* out,
+            int cols, u64 active)
+{
+    return ensembleRow<R, v4u64>(rule, up, mid, down, out, cols, active);
+}
+#endif
+
+} // namespace
+
+EnsembleLife::EnsembleLife(const std::vector<Grid>& initial,
+                           const RuleSpec& rule,
+                           int maxIterations,
+                           int cycleHistory)
+    : m_rows(0),
+      m_cols(0),
+      m_toroidal(false),
+      m_lanes(static_cast<int>(initial.size())),
+      m_rule(rule),
+      m_maxIterations(maxIterations),
+      m_wordsPerRow(0),
+      m_unchanged(~std::uint64_t(0))
+{
+    if (initial.empty() || m_lanes > kLanes) {
+        throw std::invalid_argument("Ensemble : 1 a 64 grilles attendues");
+    }
+    if (rule.isGenerations()) {
+        throw std::invalid_argument("Regle multi-etats : utiliser GenerationsLife");
+    }
+    m_rows = initial[0].rows();
+    m_cols = initial[0].cols();
+    m_toroidal = initial[0].toroidal();
+    for (const Grid& g : initial) {
+        if (g.rows() != m_rows || g.cols() != m_cols || g.toroidal() != m_toroidal) {
+            throw std::invalid_argument("Ensemble : grilles de dimensions differentes");
+        }
+    }
+
+    m_cells.assign(static_cast<std::size_t>(m_rows + 2) * (m_cols + 2), 0);
+    m_next = m_cells;
+    m_rowChanged.assign(m_rows, 0);
+    for (int l = 0; l < m_lanes; ++l) {
+        const std::uint64_t bit = std::uint64_t(1) << l;
+        for (int r = 0; r < m_rows; ++r)
+            for (int c = 0; c < m_cols; ++c)
+                if (initial[l].isAlive(r, c)) cell(m_cells, r, c) |= bit;
+    }
+
+    m_wordsPerRow = initial[0].wordsPerRow();
+    const std::size_t laneWords = static_cast<std::size_t>(m_rows) * m_wordsPerRow;
+    m_laneWords.resize(laneWords * m_lanes);
+    for (int l = 0; l < m_lanes; ++l)
+        std::copy_n(initial[l].rowWords(0), laneWords, &m_laneWords[l * laneWords]);
+
+    m_iteration.assign(m_lanes, 0);
+    m_cycles.assign(m_lanes, CycleDetector(cycleHistory));
+    for (int l = 0; l < m_lanes; ++l) {
+        m_population.push_back(initial[l].population());
+        m_hash.push_back(initial[l].hash());
+        m_cycles[l].record(m_hash[l], m_population[l], 0);
+    }
+}
+
+void EnsembleLife::wrapBorder() {
+    const int stride = m_cols + 2;
+    // lignes du haut et du bas, puis colonnes (coins compris)
+    std::copy_n(&m_cells[static_cast<std::size_t>(m_rows) * stride], stride, &m_cells[0]);
+    std::copy_n(&m_cells[stride], stride, &m_cells[static_cast<std::size_t>(m_rows + 1) * stride]);
+    for (int r = 0; r < m_rows + 2; ++r) {
+        std::uint64_t* row = &m_cells[static_cast<std::size_t>(r) * stride];
+        row[0] = row[m_cols];
+        row[m_cols + 1] = row[1];
+    }
+}
+
+// Calcule la generation suivante des voies actives dans m_next ; les autres
+// voies sont recopiees. Les cellules voisines d'une ligne etant des mots
+// contigus, le chemin AVX2 ou SSE2 (LifeKernel::activeIsa()) traite 4 ou 2
+// cellules des 64 voies par operation. Retourne les voies modifiees.
+template <class Kernel>
+std::uint64_t EnsembleLife::stepCells(std::uint64_t active) {
+    typedef u64 (*RowFunction)(const RuleSpec&, const u64*, const u64*, const u64*, u64*, int, u64);
+    RowFunction row = &rowScalar<Kernel>;
+#ifdef ENSEMBLE_X86
+    switch (LifeKernel::activeIsa()) {
+    case LifeKernel::Isa::Avx2: row = &rowAvx2<Kernel>; break;
+    case LifeKernel::Isa::Sse2: row = &rowSse2<Kernel>; break;
+    default: break;
+    }
+#endif
+    const std::size_t stride = m_cols + 2;
+    std::uint64_t changed = 0;
+    for (int r = 1; r <= m_rows; ++r) {
+        const u64* up = &m_cells[(r - 1) * stride];
+        m_rowChanged[r - 1] = row(m_rule, up, up + stride, up + 2 * stride, &m_next[r * stride],
+                                  m_cols, active);
+        changed |= m_rowChanged[r - 1];
+    }
+    return changed;
+}
+
+// Population et empreinte mises a jour comme GameOfLife : ecart entre les
+// deux versions des mots modifies de chaque voie. m_laneWords garde la
+// grille de chaque voie telle que Grid la stocke (mot w de la ligne r =
+// colonnes 64w..64w+63) ; seuls les mots des lignes modifiees sont
+// reconstruits, par transposition 64 x 64 bits si beaucoup de voies ont
+// change, bit par bit sinon.
+void EnsembleLife::updateLanes(std::uint64_t stepped) {
+    void (*transpose)(u64*) = &transpose64;
+#ifdef ENSEMBLE_X86
+    if (LifeKernel::activeIsa() == LifeKernel::Isa::Avx2) transpose = &transposeAvx2;
+#endif
+    const std::size_t stride = m_cols + 2;
+    u64 block[64];
+    for (int r = 0; r < m_rows; ++r) {
+        const u64 rowChanged = m_rowChanged[r];
+        if (!rowChanged) continue;
+        const u64* row = &m_cells[(r + 1) * stride + 1];
+        const bool many = __builtin_popcountll(rowChanged) > 8;
+        for (int w = 0; w < m_wordsPerRow; ++w) {
+            const int first = w * 64;
+            const int count = std::min(64, m_cols - first);
+            if (many) {
+                std::copy_n(row + first, count, block);
+                std::fill(block + count, block + 64, 0);
+                transpose(block);
+            }
+            const std::size_t index = static_cast<std::size_t>(r) * m_wordsPerRow + w;
+            for (u64 lanes = rowChanged; lanes; lanes &= lanes - 1) {
+                const int l = __builtin_ctzll(lanes);
+                u64 after = 0;
+                if (many) {
+                    after = block[l];
+                } else {
+                    for (int j = 0; j < count; ++j) after |= ((row[first + j] >> l) & 1u) << j;
+                }
+                u64& before = m_laneWords[static_cast<std::size_t>(l) * m_rows * m_wordsPerRow + index];
+                if (before == after) continue;
+                m_population[l] += __builtin_popcountll(after) - __builtin_popcountll(before);
+                m_hash[l] += wordHash(index, after) - wordHash(index, before);
+                before = after;
+            }
+        }
+    }
+    for (u64 lanes = stepped; lanes; lanes &= lanes - 1) {
+        const int l = __builtin_ctzll(lanes);
+        ++m_iteration[l];
+        m_cycles[l].record(m_hash[l], m_population[l], m_iteration[l]);
+    }
+}
+
+void EnsembleLife::step(std::uint64_t lanes) {
+    const std::uint64_t active = lanes & laneMask() & ~finishedMask();
+    if (!active) return;
+    if (m_toroidal) wrapBorder();
+    const std::uint64_t changed = m_rule == RuleSpec::conway()
+        ? stepCells<ConwayLifeRule>(active)
+        : stepCells<RuntimeLifeRule>(active);
+    m_cells.swap(m_next);
+    m_unchanged = (m_unchanged & ~active) | (~changed & active);
+    updateLanes(active);
+}
+
+std::uint64_t EnsembleLife::finishedMask() const {
+    // meme test que GameOfLife::hasFinished(), voie par voie
+    std::uint64_t done = 0;
+    for (int l = 0; l < m_lanes; ++l) {
+        if (m_iteration[l] == 0) continue;
+        if (((m_unchanged >> l) & 1u) || m_iteration[l] >= m_maxIterations)
+            done |= std::uint64_t(1) << l;
+    }
+    return done;
+}
+
+std::uint64_t EnsembleLife::cycleMask() const {
+    std::uint64_t cycled = 0;
+    for (int l = 0; l < m_lanes; ++l)
+        if (m_cycles[l].period() > 0) cycled |= std::uint64_t(1) << l;
+    return cycled;
+}
+
+Grid EnsembleLife::laneGrid(int lane) const {
+    Grid grid(m_rows, m_cols, m_toroidal);
+    const std::size_t laneWords = static_cast<std::size_t>(m_rows) * m_wordsPerRow;
+    if (laneWords) std::copy_n(&m_laneWords[lane * laneWords], laneWords, grid.rowWords(0));
+    return grid;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "RuleSpec.h"
+
+// Moteur d'ensemble : jusqu'à 64 grilles indépendantes de mêmes dimensions
+// avancées ensemble. Le stockage est transposé : un mot de 64 bits par
+// cellule, le bit l portant la cellule de la simulation l (« voie » l). Un
+// pas du noyau calcule ainsi la même cellule des 64 simulations, sans
+// décalage de bits entre voisins : adapté aux lots de petites soupes, où le
+// coût fixe d'un GameOfLife par grille domine.
+//
+// Chaque voie reproduit GameOfLife sur sa grille : même génération, même
+// stabilité, même hasFinished() et même période détectée (empreinte et
+// population par voie, CycleDetector de cycleHistory générations). Une voie
+// terminée n'avance plus ; les autres continuent.
+class EnsembleLife {
+public:
+    static const int kLanes = 64;
+
+private:
+    int m_rows;
+    int m_cols;
+    bool m_toroidal;
+    int m_lanes;
+    RuleSpec m_rule;
+    int m_maxIterations;
+    // (rows + 2) x (cols + 2) mots : bordure d'une cellule, nulle en mode
+    // borné, recopiée du bord opposé avant chaque pas en mode torique
+    std::vector<std::uint64_t> m_cells;
+    std::vector<std::uint64_t> m_next;
+    std::vector<std::uint64_t> m_rowChanged; // voies modifiées par ligne au dernier pas
+    // grille de chaque voie au format de Grid (rows x wordsPerRow mots par
+    // voie) : population et empreinte incrémentales, laneGrid()
+    int m_wordsPerRow;
+    std::vector<std::uint64_t> m_laneWords;
+
+    std::uint64_t m_unchanged; // voies inchangées au dernier pas (isStable)
+    std::vector<int> m_iteration;
+    std::vector<long long> m_population;
+    std::vector<std::uint64_t> m_hash;
+    std::vector<CycleDetector> m_cycles;
+
+    std::uint64_t& cell(std::vector<std::uint64_t>& cells, int r, int c) {
+        return cells[static_cast<std::size_t>(r + 1) * (m_cols + 2) + (c + 1)];
+    }
+    void wrapBorder();
+    template <class Kernel>
+    std::uint64_t stepCells(std::uint64_t active);
+    void updateLanes(std::uint64_t stepped);
+
+public:
+    // grilles de mêmes dimensions et même topologie (1 à 64), règle B/S à
+    // deux états ; lève std::invalid_argument sinon
+    EnsembleLife(const std::vector<Grid>& initial,
+                 const RuleSpec& rule,
+                 int maxIterations,
+                 int cycleHistory = 64);
+
+    int lanes() const { return m_lanes; }
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    bool toroidal() const { return m_toroidal; }
+    std::uint64_t laneMask() const {
+        return m_lanes >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << m_lanes) - 1;
+    }
+
+    // un pas des voies de lanes non terminées (par défaut toutes)
+    void step() { step(~std::uint64_t(0)); }
+    void step(std::uint64_t lanes);
+
+    // masques de voies (bit l = simulation l)
+    std::uint64_t stableMask() const { return m_unchanged & laneMask(); } // isStable()
+    std::uint64_t finishedMask() const;                                  // hasFinished()
+    std::uint64_t cycleMask() const;                                     // detectedPeriod() > 0
+
+    int currentIteration(int lane) const { return m_iteration[lane]; }
+    long long population(int lane) const { return m_population[lane]; }
+    int detectedPeriod(int lane) const { return m_cycles[lane].period(); }
+    bool isStable(int lane) const { return (stableMask() >> lane) & 1u; }
+    bool hasFinished(int lane) const { return (finishedMask() >> lane) & 1u; }
+    Grid laneGrid(int lane) const;
+};
@@ -1,37 +1,221 @@
 #include "GameOfLife.h"
+#include "LifeRule.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+// tuile = 64 lignes x 4 mots (256 colonnes)
+const int kTileRows = 64;
+const int kTileWords = 4;
+}
 
 GameOfLife::GameOfLife(const Grid& initial,
                        std::unique_ptr<Rule> rule,
-                       int maxIterations)
+                       int maxIterations,
+                       StepKernel kernel,
+                       int threads,
+                       int cycleHistory)
     : m_grid(initial),
       m_previousGrid(initial),
       m_rule(std::move(rule)),
       m_maxIterations(maxIterations),
-      m_currentIteration(0)
+      m_currentIteration(0),
+      m_bitwise(false),
+      m_population(initial.population()),
+      m_hash(initial.hash()),
+      m_cycles(cycleHistory)
 {
+    // le noyau binaire ne reproduit que les regles B/S : une regle derivee
+    // garde le chemin generique
+    const RuleSpec* spec = m_rule ? LifeRule::specOf(*m_rule) : nullptr;
+    if (spec && spec->isGenerations()) {
+        throw std::invalid_argument("Regle multi-etats : utiliser GenerationsLife");
+    }
+    m_bitwise = kernel == StepKernel::Bitwise && spec != nullptr;
+    if (m_bitwise) m_rowKernel = LifeKernel::RowKernel(*spec);
+
+    if (threads <= 0) threads = WorkerPool::hardwareThreads();
+    if (threads > 1) m_pool = std::make_unique<WorkerPool>(threads);
+
+    m_tileRows = (m_grid.rows() + kTileRows - 1) / kTileRows;
+    m_tileCols = (m_grid.wordsPerRow() + kTileWords - 1) / kTileWords;
+    // au depart tout est a calculer
+    m_dirty.assign(static_cast<std::size_t>(m_tileRows) * m_tileCols, 1);
+    m_nextDirty.assign(m_dirty.size(), 0);
+    m_activeTiles = static_cast<long long>(m_dirty.size());
+    m_bandStats.resize(m_tileRows);
+    if (!m_bitwise) {
+        m_scratch.assign(static_cast<std::size_t>(m_tileRows) * 2 * kTileWords * 64, 0);
+    }
+    m_bandActive.resize(m_tileRows);
+
+    m_cycles.record(m_hash, m_population, 0);
 }
 
-void GameOfLife::step() {
-    // conserve la grille courante pour la detection de stabilite
-    m_previousGrid = m_grid;
-
-    // on repart d'une copie pour conserver la configuration (taille, mode torique)
-    Grid next = m_grid;
-    for (int r = 0; r < m_grid.rows(); ++r)
-        for (int c = 0; c < m_grid.cols(); ++c) {
-            CellState* nextState = m_rule->nextState(m_grid.at(r, c), m_grid);
-            next.at(r, c).setState(nextState);
+// Calcule une tuile. Les tuiles sont alignees sur des mots : deux tuiles
+// n'ecrivent donc jamais dans le meme mot et peuvent etre traitees en
+// parallele.
+StepStats GameOfLife::stepTile(const Grid& src, Grid& dst, int tileRow, int tileCol) {
+    const int rowBegin = tileRow * kTileRows;
+    const int rowEnd = std::min(rowBegin + kTileRows, src.rows());
+    const int wordBegin = tileCol * kTileWords;
+    const int wordEnd = std::min(wordBegin + kTileWords, src.wordsPerRow());
+    if (m_bitwise) {
+        return LifeKernel::stepBlock(src, dst, rowBegin, rowEnd, wordBegin, wordEnd, m_rowKernel);
+    }
+    StepStats stats;
+    const int words = src.wordsPerRow();
+    const int colBegin = wordBegin * 64;
+    const int colEnd = std::min(wordEnd * 64, src.cols());
+    std::uint8_t* neighbours = &m_scratch[static_cast<std::size_t>(tileRow) * 2 * kTileWords * 64];
+    std::uint8_t* next = neighbours + kTileWords * 64;
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        for (int c = colBegin; c < colEnd; ++c)
+            neighbours[c - colBegin] = static_cast<std::uint8_t>(src.countAliveNeighbors(r, c));
+        m_rule->nextRow(src, r, colBegin, colEnd, neighbours, next);
+        // regroupe les resultats en mots (bits de bourrage nuls)
+        std::uint64_t* out = dst.rowWords(r);
+        for (int w = wordBegin; w < wordEnd; ++w) {
+            std::uint64_t word = 0;
+            const int first = w * 64;
+            const int last = std::min(first + 64, colEnd);
+            for (int c = first; c < last; ++c)
+                word |= static_cast<std::uint64_t>(next[c - colBegin] != 0) << (c - first);
+            out[w] = word;
         }
+        accumulateRow(stats, src.rowWords(r) + wordBegin, dst.rowWords(r) + wordBegin,
+                      wordEnd - wordBegin,
+                      static_cast<std::uint64_t>(r) * words + wordBegin);
+    }
+    return stats;
+}
+
+// Une tuile n'est recalculee que si elle ou l'une de ses 8 voisines a change
+// au pas precedent. Sinon elle valait deja la meme chose aux generations
+// n-1 et n, et le tampon arriere (generation n-1) contient donc deja la
+// generation n+1 pour cette tuile.
+bool GameOfLife::tileNeedsStep(int tileRow, int tileCol) const {
+    const bool wrap = m_grid.toroidal();
+    for (int dr = -1; dr <= 1; ++dr) {
+        int tr = tileRow + dr;
+        if (wrap) tr = (tr + m_tileRows) % m_tileRows;
+        if (tr < 0 || tr >= m_tileRows) continue;
+        for (int dc = -1; dc <= 1; ++dc) {
+            int tc = tileCol + dc;
+            if (wrap) tc = (tc + m_tileCols) % m_tileCols;
+            if (tc < 0 || tc >= m_tileCols) continue;
+            if (m_dirty[static_cast<std::size_t>(tr) * m_tileCols + tc]) return true;
+        }
+    }
+    return false;
+}
+
+void GameOfLife::stepTileRow(const Grid& src, Grid& dst, int tileRow) {
+    StepStats stats;
+    int active = 0;
+    for (int tc = 0; tc < m_tileCols; ++tc) {
+        std::size_t index = static_cast<std::size_t>(tileRow) * m_tileCols + tc;
+        bool changed = false;
+        if (tileNeedsStep(tileRow, tc)) {
+            StepStats tile = stepTile(src, dst, tileRow, tc);
+            changed = tile.changed() != 0;
+            stats += tile;
+            ++active;
+        }
+        m_nextDirty[index] = changed ? 1 : 0;
+    }
+    m_bandStats[tileRow] = stats;
+    m_bandActive[tileRow] = active;
+}
 
-    m_grid = std::move(next);
+void GameOfLife::step() {
+    // la generation suivante est ecrite dans le tampon arriere (qui contient
+    // la generation precedente, de meme configuration) puis les deux tampons
+    // sont echanges. Ni copie ni allocation.
+    const Grid& src = m_grid;
+    Grid& dst = m_previousGrid;
+    auto task = [&](int tileRow) { stepTileRow(src, dst, tileRow); };
+    if (m_pool) {
+        // une rangee de tuiles par tache, distribuee dynamiquement
+        m_pool->parallelFor(m_tileRows, task);
+    } else {
+        for (int tr = 0; tr < m_tileRows; ++tr) task(tr);
+    }
+
+    StepStats stats;
+    m_activeTiles = 0;
+    for (int tr = 0; tr < m_tileRows; ++tr) {
+        stats += m_bandStats[tr];
+        m_activeTiles += m_bandActive[tr];
+    }
+    m_dirty.swap(m_nextDirty);
+
+    // m_previousGrid conserve la generation n pour la detection de stabilite
+    m_grid.swap(m_previousGrid);
     ++m_currentIteration;
+
+    m_lastStats = stats;
+    m_population += stats.births - stats.deaths;
+    m_hash += stats.hashDelta;
+    m_cycles.record(m_hash, m_population, m_currentIteration);
 }
 
 bool GameOfLife::isStable() const {
-    return m_grid.equals(m_previousGrid);
+    // avant le premier pas les deux tampons sont identiques
+    return m_lastStats.changed() == 0;
+}
+
+BoundingBox GameOfLife::activeRegion() const {
+    // apres le pas, m_dirty marque les tuiles modifiees
+    BoundingBox box;
+    if (m_currentIteration == 0) return box;
+    int top = m_tileRows, bottom = -1, left = m_tileCols, right = -1;
+    for (int tr = 0; tr < m_tileRows; ++tr) {
+        const std::uint8_t* flags = &m_dirty[static_cast<std::size_t>(tr) * m_tileCols];
+        for (int tc = 0; tc < m_tileCols; ++tc) {
+            if (!flags[tc]) continue;
+            top = std::min(top, tr);
+            bottom = tr;
+            left = std::min(left, tc);
+            right = std::max(right, tc);
+        }
+    }
+    if (bottom < 0) return box;
+    box.top = static_cast<long long>(top) * kTileRows;
+    box.left = static_cast<long long>(left) * kTileWords * 64;
+    box.bottom = std::min<long long>((bottom + 1LL) * kTileRows, m_grid.rows()) - 1;
+    box.right = std::min<long long>((right + 1LL) * kTileWords * 64, m_grid.cols()) - 1;
+    return box;
 }
 
 bool GameOfLife::hasFinished() const {
     if (m_currentIteration == 0) return false; // aucune etape effectuee
     return isStable() || m_currentIteration >= m_maxIterations;
-}
\ No newline at end of file
+}
+
+void GameOfLife::saveCheckpoint(EngineCheckpoint& checkpoint) const {
+    checkpoint.grid = m_grid;
+    checkpoint.iteration = m_currentIteration;
+    checkpoint.lastStats = m_lastStats;
+    checkpoint.period = m_cycles.period();
+    m_cycles.history(checkpoint.history);
+}
+
+void GameOfLife::restoreCheckpoint(const EngineCheckpoint& checkpoint) {
+    const Grid& grid = checkpoint.grid;
+    if (grid.rows() != m_grid.rows() || grid.cols() != m_grid.cols()
+        || grid.toroidal() != m_grid.toroidal()) {
+        throw std::invalid_argument("Point de reprise incompatible avec la grille");
+    }
+    m_grid = grid;
+    m_previousGrid = grid;
+    // le tampon arriere ne contient pas la generation precedente : toutes
+    // les tuiles sont recalculees au pas suivant
+    std::fill(m_dirty.begin(), m_dirty.end(), 1);
+    m_activeTiles = static_cast<long long>(m_dirty.size());
+    m_currentIteration = checkpoint.iteration;
+    m_lastStats = checkpoint.lastStats;
+    m_population = grid.population();
+    m_hash = grid.hash();
+    m_cycles.restore(checkpoint.history, checkpoint.period);
+}
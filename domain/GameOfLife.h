@@ -1,24 +1,94 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <vector>
+#include "CycleDetector.h"
 #include "Grid.h"
+#include "LifeEngine.h"
+#include "LifeKernel.h"
 #include "Rule.h"
+#include "StepKernel.h"
+#include "StepStats.h"
+#include "WorkerPool.h"
 
-class GameOfLife {
+// Moteur dense : toute la grille (bornée ou torique) est stockée en bits.
+class GameOfLife : public LifeEngine {
 private:
+    // double tampon : m_grid = génération courante (avant), m_previousGrid =
+    // génération précédente (arrière), réécrite en place puis échangée
     Grid m_grid;
     Grid m_previousGrid;
     std::unique_ptr<Rule> m_rule;
     int m_maxIterations;
     int m_currentIteration;
+    bool m_bitwise;
+    LifeKernel::RowKernel m_rowKernel;
+    std::unique_ptr<WorkerPool> m_pool; // nul en mode mono-thread
+
+    // tuiles actives : seules les tuiles dont le voisinage a changé au pas
+    // précédent sont recalculées (une rangée de tuiles par tâche)
+    int m_tileRows = 0;
+    int m_tileCols = 0;
+    std::vector<std::uint8_t> m_dirty;     // tuiles modifiées au dernier pas
+    std::vector<std::uint8_t> m_nextDirty;
+    std::vector<StepStats> m_bandStats;    // bilan par rangée de tuiles (pré-alloué)
+    std::vector<int> m_bandActive;
+    long long m_activeTiles = 0;
+    // chemin PerCellRule : voisins et résultats d'une ligne de tuile, une
+    // zone par rangée de tuiles (pré-alloué)
+    std::vector<std::uint8_t> m_scratch;
+
+    // bilan incrémental : changements du dernier pas, population, empreinte
+    StepStats m_lastStats;
+    long long m_population;
+    std::uint64_t m_hash;
+
+    CycleDetector m_cycles;
+
+    StepStats stepTile(const Grid& src, Grid& dst, int tileRow, int tileCol);
+    bool tileNeedsStep(int tileRow, int tileCol) const;
+    void stepTileRow(const Grid& src, Grid& dst, int tileRow);
 
 public:
+    // threads : nombre de threads de calcul (0 = tous les coeurs). Le
+    // résultat est identique au calcul mono-thread : chaque tuile est écrite
+    // par un seul thread. En mode PerCellRule, Rule::nextRow()
+    // doit alors être sûre en concurrence (méthode const sans état).
     GameOfLife(const Grid& initial,
                std::unique_ptr<Rule> rule,
-               int maxIterations);
+               int maxIterations,
+               StepKernel kernel = StepKernel::Bitwise,
+               int threads = 1,
+               int cycleHistory = 64);
+
+    void step() override;              // une itération
+    bool isStable() const override;    // grille inchangée (O(1) : aucun changement au dernier pas)
+    bool hasFinished() const override; // stable ou max atteint
+
+    // période du cycle atteint (1 = stable, N = oscillateur), 0 si aucun
+    // retour à une génération des cycleHistory dernières n'a été observé.
+    // La comparaison porte sur une empreinte 64 bits et la population.
+    int detectedPeriod() const override { return m_cycles.period(); }
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+    long long population() const override { return m_population; }
+
+    // tuiles recalculées au dernier pas, sur tileCount() au total
+    long long activeTiles() const override { return m_activeTiles; }
+    long long tileCount() const override { return static_cast<long long>(m_tileRows) * m_tileCols; }
+    // tuiles modifiées au dernier pas (parcours des drapeaux, à la demande)
+    BoundingBox activeRegion() const override;
+    int currentIteration() const override { return m_currentIteration; }
+    const Grid& currentGrid() const override { return m_grid; }
+    bool usesBitwiseKernel() const { return m_bitwise; }
+    // noyau binaire spécialisé à la compilation pour cette règle
+    bool usesSpecialisedKernel() const { return m_bitwise && m_rowKernel.specialised(); }
+    int threads() const { return m_pool ? m_pool->size() : 1; }
 
-    void step();                 // une itération
-    bool isStable() const;       // grille inchangée
-    bool hasFinished() const;    // stable ou max atteint
-    int currentIteration() const { return m_currentIteration; }
-    const Grid& currentGrid() const { return m_grid; }
+    // copie de la génération courante dans un tampon réutilisé : le pas
+    // n'est retenu que le temps d'un memcpy de la grille
+    bool supportsCheckpoint() const override { return true; }
+    void saveCheckpoint(EngineCheckpoint& checkpoint) const override;
+    // reprend au compteur, à la stabilité et à l'historique des cycles du
+    // point de reprise (grille de mêmes dimensions)
+    void restoreCheckpoint(const EngineCheckpoint& checkpoint) override;
 };
@@ -0,0 +1,145 @@
+#include "GenerationsLife.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+GenerationsLife::GenerationsLife(const StateGrid& initial,
+                                 const RuleSpec& rule,
+                                 int maxIterations,
+                                 int cycleHistory)
+    : m_rule(rule),
+      m_states(initial),
+      m_next(initial),
+      m_maxIterations(maxIterations),
+      m_currentIteration(0),
+      m_changedCells(0),
+      m_population(initial.count(1)),
+      m_hash(0),
+      m_cycles(cycleHistory),
+      m_viewValid(false)
+{
+    if (m_states.maxState() >= m_rule.states) {
+        throw std::invalid_argument("Etat de cellule hors de la regle (" + m_rule.toString() + ")");
+    }
+
+    // table de transition : morte -> naissance, vivante -> survie ou
+    // premier etat mourant, mourante -> etat suivant puis morte
+    const int states = m_rule.states;
+    m_transition.assign(static_cast<std::size_t>(states) * 9, 0);
+    for (int n = 0; n <= 8; ++n) {
+        m_transition[0 * 9 + n] = (m_rule.birth >> n) & 1u;
+        m_transition[1 * 9 + n] = ((m_rule.survival >> n) & 1u) ? 1 : (states > 2 ? 2 : 0);
+        for (int s = 2; s < states; ++s)
+            m_transition[s * 9 + n] = static_cast<std::uint8_t>(s + 1 < states ? s + 1 : 0);
+    }
+
+    const int cols = m_states.cols();
+    m_scratch.assign(static_cast<std::size_t>(4) * (cols + 2), 0);
+
+    for (int r = 0; r < m_states.rows(); ++r) m_hash += rowHash(m_states, r);
+    m_cycles.record(m_hash, m_population, 0);
+}
+
+// vivantes de la ligne r (0/1) dans out[1..cols], avec les colonnes
+// voisines out[0] et out[cols + 1] (repli torique ou vide) ; ligne hors
+// grille = vide
+void GenerationsLife::aliveRow(int r, std::uint8_t* out) const {
+    const int rows = m_states.rows();
+    const int cols = m_states.cols();
+    if (m_states.toroidal()) r = (r + rows) % rows;
+    if (r < 0 || r >= rows) {
+        std::memset(out, 0, cols + 2);
+        return;
+    }
+    const std::uint8_t* cells = m_states.row(r);
+    for (int c = 0; c < cols; ++c) out[c + 1] = cells[c] == 1;
+    const bool wrap = m_states.toroidal() && cols > 0;
+    out[0] = wrap ? out[cols] : 0;
+    out[cols + 1] = wrap ? out[1] : 0;
+}
+
+// empreinte d'une ligne : somme de wordHash() sur ses paquets de 8 octets
+std::uint64_t GenerationsLife::rowHash(const StateGrid& grid, int r) const {
+    const int cols = grid.cols();
+    const int chunks = (cols + 7) / 8;
+    const std::uint8_t* cells = grid.row(r);
+    std::uint64_t hash = 0;
+    for (int k = 0; k < chunks; ++k) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, cells + k * 8, std::min(8, cols - k * 8));
+        hash += wordHash(static_cast<std::uint64_t>(r) * chunks + k, word);
+    }
+    return hash;
+}
+
+void GenerationsLife::step() {
+    const int rows = m_states.rows();
+    const int cols = m_states.cols();
+    const std::size_t stride = static_cast<std::size_t>(cols) + 2;
+    std::uint8_t* lines[3] = { m_scratch.data(), m_scratch.data() + stride,
+                               m_scratch.data() + 2 * stride };
+    std::uint8_t* vertical = m_scratch.data() + 3 * stride;
+    const std::uint8_t* table = m_transition.data();
+
+    StepStats stats;
+    long long changed = 0;
+    if (rows > 0) {
+        aliveRow(-1, lines[0]);
+        aliveRow(0, lines[1]);
+    }
+    for (int r = 0; r < rows; ++r) {
+        aliveRow(r + 1, lines[2]);
+        const std::uint8_t* up = lines[0];
+        const std::uint8_t* mid = lines[1];
+        const std::uint8_t* down = lines[2];
+        for (std::size_t c = 0; c < stride; ++c)
+            vertical[c] = up[c] + mid[c] + down[c];
+
+        const std::uint8_t* cur = m_states.row(r);
+        std::uint8_t* out = m_next.row(r);
+        long long births = 0, deaths = 0, diff = 0;
+        for (int c = 0; c < cols; ++c) {
+            const int n = vertical[c] + vertical[c + 1] + vertical[c + 2] - mid[c + 1];
+            const std::uint8_t s = cur[c];
+            const std::uint8_t next = table[s * 9 + n];
+            out[c] = next;
+            births += (next == 1) & (s != 1);
+            deaths += (s == 1) & (next != 1);
+            diff += next != s;
+        }
+        stats.births += births;
+        stats.deaths += deaths;
+        if (diff) {
+            changed += diff;
+            stats.hashDelta += rowHash(m_next, r) - rowHash(m_states, r);
+        }
+
+        // rotation des lignes : la suivante remplace la plus ancienne
+        std::uint8_t* oldest = lines[0];
+        lines[0] = lines[1];
+        lines[1] = lines[2];
+        lines[2] = oldest;
+    }
+
+    m_states.swap(m_next);
+    ++m_currentIteration;
+    m_lastStats = stats;
+    m_changedCells = changed;
+    m_population += stats.births - stats.deaths;
+    m_hash += stats.hashDelta;
+    m_cycles.record(m_hash, m_population, m_currentIteration);
+    m_viewValid = false;
+}
+
+bool GenerationsLife::hasFinished() const {
+    if (m_currentIteration == 0) return false; // aucune etape effectuee
+    return isStable() || m_currentIteration >= m_maxIterations;
+}
+
+const Grid& GenerationsLife::currentGrid() const {
+    if (!m_viewValid) {
+        m_states.aliveInto(m_view);
+        m_viewValid = true;
+    }
+    return m_view;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "LifeEngine.h"
+#include "RuleSpec.h"
+#include "StateGrid.h"
+#include "StepStats.h"
+
+// Moteur multi-états (règles Generations, ex. Brian's Brain "/2/3") sur une
+// grille dense d'un octet par cellule. Seules les cellules à l'état 1
+// comptent comme voisines ; une génération = une table de transition
+// (état, voisins vivants) -> état suivant, sans branchement ni objet d'état.
+class GenerationsLife : public LifeEngine {
+public:
+    // lève std::invalid_argument si une cellule de initial dépasse
+    // rule.states - 1
+    GenerationsLife(const StateGrid& initial,
+                    const RuleSpec& rule,
+                    int maxIterations,
+                    int cycleHistory = 64);
+
+    void step() override;
+    bool isStable() const override { return m_changedCells == 0; }
+    bool hasFinished() const override;
+    int currentIteration() const override { return m_currentIteration; }
+    int detectedPeriod() const override { return m_cycles.period(); }
+    // cellules vivantes (état 1) ; naissances/morts = entrées/sorties de l'état 1
+    long long population() const override { return m_population; }
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+
+    // cellules vivantes seulement (vue à deux états, recalculée à la demande)
+    const Grid& currentGrid() const override;
+    const StateGrid* currentStates() const override { return &m_states; }
+
+    // lignes recalculées / lignes de la grille
+    long long activeTiles() const override { return m_states.rows(); }
+    long long tileCount() const override { return m_states.rows(); }
+
+    const RuleSpec& rule() const { return m_rule; }
+    long long changedCells() const { return m_changedCells; } // au dernier pas
+
+private:
+    RuleSpec m_rule;
+    StateGrid m_states;
+    StateGrid m_next;                    // tampon arrière, échangé à chaque pas
+    std::vector<std::uint8_t> m_transition; // [état * 9 + voisins] -> état suivant
+    std::vector<std::uint8_t> m_scratch;    // 3 lignes de vivantes + sommes verticales
+
+    int m_maxIterations;
+    int m_currentIteration;
+    StepStats m_lastStats;
+    long long m_changedCells;
+    long long m_population;
+    std::uint64_t m_hash;
+    CycleDetector m_cycles;
+
+    mutable Grid m_view;
+    mutable bool m_viewValid;
+
+    void aliveRow(int r, std::uint8_t* out) const;
+    std::uint64_t rowHash(const StateGrid& grid, int r) const;
+};
@@ -1,19 +1,46 @@
 #include "Grid.h"
 #include "AliveState.h"
 #include "DeadState.h"
+#include "StepStats.h"
+#include <stdexcept>
+#include <utility>
 
 Grid::Grid(int rows, int cols, bool toroidal)
-    : m_rows(rows), m_cols(cols), m_toroidal(toroidal)
+    : m_rows(rows), m_cols(cols), m_toroidal(toroidal),
+      m_wordsPerRow((cols + 63) / 64)
 {
-    m_cells.reserve(m_rows);
-    for (int r = 0; r < m_rows; ++r) {
-        std::vector<Cell> row;
-        row.reserve(m_cols);
-        for (int c = 0; c < m_cols; ++c) {
-            row.emplace_back(r, c, new DeadState());
-        }
-        m_cells.push_back(std::move(row));
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("Dimensions de grille invalides");
     }
+    // toutes les cellules mortes au depart
+    m_words.assign(static_cast<std::size_t>(m_rows) * m_wordsPerRow, 0);
+}
+
+std::uint64_t Grid::lastWordMask() const {
+    int used = m_cols & 63;
+    return used == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << used) - 1;
+}
+
+void Grid::swap(Grid& other) noexcept {
+    std::swap(m_rows, other.m_rows);
+    std::swap(m_cols, other.m_cols);
+    std::swap(m_toroidal, other.m_toroidal);
+    std::swap(m_wordsPerRow, other.m_wordsPerRow);
+    m_words.swap(other.m_words);
+}
+
+long long Grid::population() const {
+    long long count = 0;
+    for (std::uint64_t w : m_words)
+        count += __builtin_popcountll(w);
+    return count;
+}
+
+std::uint64_t Grid::hash() const {
+    std::uint64_t h = 0;
+    for (std::size_t i = 0; i < m_words.size(); ++i)
+        h += wordHash(i, m_words[i]);
+    return h;
 }
 
 int Grid::countAliveNeighbors(int r, int c) const {
@@ -32,7 +59,7 @@ int Grid::countAliveNeighbors(int r, int c) const {
 
             if (rr >= 0 && rr < m_rows &&
                 cc >= 0 && cc < m_cols &&
-                m_cells[rr][cc].isAlive())
+                isAlive(rr, cc))
             {
                 ++count;
             }
@@ -43,9 +70,20 @@ int Grid::countAliveNeighbors(int r, int c) const {
 
 bool Grid::equals(const Grid& other) const {
     if (m_rows != other.m_rows || m_cols != other.m_cols) return false;
-    for (int r = 0; r < m_rows; ++r)
-        for (int c = 0; c < m_cols; ++c)
-            if (at(r,c).isAlive() != other.at(r,c).isAlive())
-                return false;
-    return true;
+    // les bits de bourrage sont toujours nuls : comparaison mot a mot
+    return m_words == other.m_words;
+}
+
+void Cell::setState(CellState* newState) {
+    m_grid->setAlive(m_row, m_col, newState && newState->isAlive());
+    delete newState;
+}
+
+void Cell::setState(const CellState& state) {
+    m_grid->setAlive(m_row, m_col, state.isAlive());
+}
+
+const CellState* Cell::state() const {
+    if (isAlive()) return &AliveState::instance();
+    return &DeadState::instance();
 }
@@ -1,23 +1,59 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include "Cell.h"
 
+// Grille stockée en bits compacts : une cellule par bit, chaque ligne
+// occupe wordsPerRow() mots de 64 bits contigus (bit i du mot w = colonne
+// 64*w + i). Les bits de bourrage au-delà de cols() restent toujours à 0.
 class Grid {
 private:
     int m_rows;
     int m_cols;
     bool m_toroidal;
-    std::vector<std::vector<Cell>> m_cells;
+    int m_wordsPerRow;
+    std::vector<std::uint64_t> m_words;
 
 public:
     Grid(int rows = 0, int cols = 0, bool toroidal = false);
 
     int rows() const { return m_rows; }
     int cols() const { return m_cols; }
+    bool toroidal() const { return m_toroidal; }
 
-    Cell& at(int r, int c)       { return m_cells[r][c]; }
-    const Cell& at(int r, int c) const { return m_cells[r][c]; }
+    // accès de compatibilité : proxy sans allocation
+    Cell at(int r, int c)             { return Cell(this, r, c); }
+    const Cell at(int r, int c) const { return Cell(const_cast<Grid*>(this), r, c); }
 
+    bool isAlive(int r, int c) const {
+        return (rowWords(r)[c >> 6] >> (c & 63)) & 1u;
+    }
+    void setAlive(int r, int c, bool alive) {
+        std::uint64_t bit = std::uint64_t(1) << (c & 63);
+        std::uint64_t& word = rowWords(r)[c >> 6];
+        word = alive ? (word | bit) : (word & ~bit);
+    }
+
+    // accès direct au stockage compact (pour les noyaux de calcul)
+    int wordsPerRow() const { return m_wordsPerRow; }
+    std::uint64_t* rowWords(int r) {
+        return m_words.data() + static_cast<std::size_t>(r) * m_wordsPerRow;
+    }
+    const std::uint64_t* rowWords(int r) const {
+        return m_words.data() + static_cast<std::size_t>(r) * m_wordsPerRow;
+    }
+    std::uint64_t lastWordMask() const; // bits valides du dernier mot d'une ligne
+
+    // échange le contenu de deux grilles sans copie ni allocation
+    void swap(Grid& other) noexcept;
+
+    long long population() const;
+    std::uint64_t hash() const; // empreinte du contenu (voir StepStats.h)
     int countAliveNeighbors(int r, int c) const;
     bool equals(const Grid& other) const;
 };
+
+inline bool Cell::isAlive() const {
+    return m_grid->isAlive(m_row, m_col);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Grid.h"
+#include "StepStats.h"
+
+// Transport entre le coordinateur de DistributedLife et ses travailleurs,
+// chacun propriétaire d'une bande de lignes de la grille. Les échanges se
+// font par tours : le coordinateur envoie une commande, chaque travailleur
+// la reçoit et y répond par un seul message (bilan du pas ou bande).
+//
+// Le voisin du dessus du travailleur w est w - 1, celui du dessous w + 1
+// (modulo le nombre de travailleurs) : la bordure torique entre la dernière
+// et la première bande est un échange comme un autre.
+class HaloTransport {
+public:
+    enum class Command { Step, Gather, Stop };
+
+    // travailleur w : lignes [firstRows[w], firstRows[w + 1]) de la grille
+    struct Layout {
+        std::vector<int> firstRows;
+        int wordsPerRow = 0;
+
+        int workers() const { return static_cast<int>(firstRows.size()) - 1; }
+        int rows(int worker) const { return firstRows[worker + 1] - firstRows[worker]; }
+    };
+
+    typedef std::function<void(int worker)> WorkerMain;
+
+    virtual ~HaloTransport() = default;
+
+    // --- coordinateur ---
+
+    // distribue initial selon layout puis lance main(w) pour chaque
+    // travailleur ; main retourne après la commande Stop
+    virtual void start(const Layout& layout, const Grid& initial, const WorkerMain& main) = 0;
+    // début d'un tour
+    virtual void sendCommand(Command command) = 0;
+    // fin d'un tour Step : bilan de chaque travailleur
+    virtual void receiveReports(std::vector<StepStats>& reports) = 0;
+    // fin d'un tour Gather : bandes recopiées dans grid (dimensions du
+    // découpage)
+    virtual void receiveGrid(Grid& grid) = 0;
+    // commande Stop puis attente des travailleurs (sans effet si déjà fait)
+    virtual void stop() = 0;
+
+    // --- travailleur w ---
+
+    // sa bande initiale (rows(w) x wordsPerRow mots)
+    virtual void receiveStrip(int worker, std::uint64_t* words) = 0;
+    virtual Command receiveCommand(int worker) = 0;
+    // ses lignes de bord à la génération generation, puis celles de ses
+    // voisins à la même génération (above : dernière ligne du voisin du
+    // dessus, below : première ligne du voisin du dessous)
+    virtual void sendHalo(int worker, int generation,
+                          const std::uint64_t* first, const std::uint64_t* last) = 0;
+    virtual void receiveHalo(int worker, int generation,
+                             std::uint64_t* above, std::uint64_t* below) = 0;
+    // réponses : Step, puis Gather
+    virtual void sendReport(int worker, const StepStats& stats) = 0;
+    virtual void sendStrip(int worker, const std::uint64_t* words) = 0;
+};
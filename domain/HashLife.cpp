@@ -0,0 +1,442 @@
+#include "HashLife.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+typedef std::uint64_t u64;
+
+inline u64 mix(u64 z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// règle sur un carré 4x4 (bit r*4+c) : les 4 cellules centrales après
+// une génération (bit 0 = (1,1), 1 = (1,2), 2 = (2,1), 3 = (2,2))
+std::vector<std::uint8_t> life4x4Table(const RuleSpec& rule) {
+    std::vector<std::uint8_t> t(1 << 16);
+    for (int bits = 0; bits < (1 << 16); ++bits) {
+        std::uint8_t out = 0;
+        for (int k = 0; k < 4; ++k) {
+            const int r = 1 + (k >> 1);
+            const int c = 1 + (k & 1);
+            int alive = 0;
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc)
+                    if ((dr || dc) && ((bits >> ((r + dr) * 4 + c + dc)) & 1)) ++alive;
+            const bool cur = (bits >> (r * 4 + c)) & 1;
+            const std::uint16_t mask = cur ? rule.survival : rule.birth;
+            if (mask & (1u << alive)) out |= 1 << k;
+        }
+        t[bits] = out;
+    }
+    return t;
+}
+
+} // namespace
+
+std::size_t HashLife::NodeKeyHash::operator()(const NodeKey& k) const {
+    u64 h = k.child[0];
+    h = h * 0x9E3779B97F4A7C15ull + k.child[1];
+    h = h * 0x9E3779B97F4A7C15ull + k.child[2];
+    h = h * 0x9E3779B97F4A7C15ull + k.child[3];
+    return static_cast<std::size_t>(mix(h));
+}
+
+HashLife::HashLife(const Grid& initial,
+                   int maxIterations,
+                   int stepLog2,
+                   std::size_t maxNodes,
+                   int cycleHistory,
+                   const RuleSpec& rule)
+    : m_maxNodes(maxNodes),
+      m_collections(0),
+      m_root(kDead),
+      m_top(0),
+      m_left(0),
+      m_maxIterations(maxIterations),
+      m_stepLog2(std::max(stepLog2, 0)),
+      m_generation(0),
+      m_stable(true),
+      m_createdLastStep(0),
+      m_cycles(cycleHistory),
+      m_viewValid(false)
+{
+    if (rule.birthOnZero() || rule.isGenerations()) {
+        throw std::invalid_argument("Le moteur hashlife ne gere pas les regles B0 ni multi-etats");
+    }
+    m_life4x4 = life4x4Table(rule);
+    // feuilles : cellule morte (0) et vivante (1)
+    m_nodes.push_back(Node{ {0, 0, 0, 0}, 0, mix(0x51), 0 });
+    m_nodes.push_back(Node{ {0, 0, 0, 0}, 1, mix(0xA7), 0 });
+    m_empty.push_back(kDead);
+
+    int level = 3;
+    while ((1LL << level) < std::max(initial.rows(), initial.cols())) ++level;
+    m_root = build(initial, level, 0, 0);
+
+    Canonical c = canonical();
+    m_cycles.record(m_nodes[c.node].hash ^ mix(u64(c.top) * 31 + u64(c.left)),
+                    population(), 0);
+}
+
+HashLife::NodeId HashLife::join(NodeId nw, NodeId ne, NodeId sw, NodeId se) {
+    NodeKey key = { { nw, ne, sw, se } };
+    auto it = m_index.find(key);
+    if (it != m_index.end()) return it->second;
+
+    const Node& a = m_nodes[nw];
+    const Node& b = m_nodes[ne];
+    const Node& c = m_nodes[sw];
+    const Node& d = m_nodes[se];
+    Node node;
+    node.child[0] = nw; node.child[1] = ne; node.child[2] = sw; node.child[3] = se;
+    node.population = a.population + b.population + c.population + d.population;
+    node.level = a.level + 1;
+    node.hash = mix(a.hash + mix(b.hash + mix(c.hash + mix(d.hash + u64(node.level)))));
+
+    if (m_nodes.size() >= 0xFFFFFFFFu) {
+        throw std::runtime_error("HashLife : capacite d'index des noeuds depassee");
+    }
+    NodeId id = static_cast<NodeId>(m_nodes.size());
+    m_nodes.push_back(node);
+    m_index.emplace(key, id);
+    return id;
+}
+
+HashLife::NodeId HashLife::emptyNode(int level) {
+    while (static_cast<int>(m_empty.size()) <= level) {
+        NodeId e = m_empty.back();
+        m_empty.push_back(join(e, e, e, e));
+    }
+    return m_empty[level];
+}
+
+HashLife::NodeId HashLife::build(const Grid& grid, int level, int top, int left) {
+    if (top >= grid.rows() || left >= grid.cols()) return emptyNode(level);
+    if (level == 0) return grid.isAlive(top, left) ? kAlive : kDead;
+    const int half = 1 << (level - 1);
+    NodeId nw = build(grid, level - 1, top, left);
+    NodeId ne = build(grid, level - 1, top, left + half);
+    NodeId sw = build(grid, level - 1, top + half, left);
+    NodeId se = build(grid, level - 1, top + half, left + half);
+    return join(nw, ne, sw, se);
+}
+
+// place node au centre d'un nœud deux fois plus grand
+HashLife::NodeId HashLife::expand(NodeId node) {
+    const Node n = m_nodes[node];
+    NodeId e = emptyNode(n.level - 1);
+    NodeId nw = join(e, e, e, n.child[0]);
+    NodeId ne = join(e, e, n.child[1], e);
+    NodeId sw = join(e, n.child[2], e, e);
+    NodeId se = join(n.child[3], e, e, e);
+    return join(nw, ne, sw, se);
+}
+
+// carré central, de niveau inférieur
+HashLife::NodeId HashLife::centre(NodeId node) {
+    const Node n = m_nodes[node];
+    return join(m_nodes[n.child[0]].child[3], m_nodes[n.child[1]].child[2],
+                m_nodes[n.child[2]].child[1], m_nodes[n.child[3]].child[0]);
+}
+
+// vrai si toutes les cellules vivantes sont dans le carré central
+bool HashLife::isPadded(NodeId node) const {
+    const Node& n = m_nodes[node];
+    const Node& a = m_nodes[n.child[0]];
+    const Node& b = m_nodes[n.child[1]];
+    const Node& c = m_nodes[n.child[2]];
+    const Node& d = m_nodes[n.child[3]];
+    return a.population == m_nodes[a.child[3]].population
+        && b.population == m_nodes[b.child[2]].population
+        && c.population == m_nodes[c.child[1]].population
+        && d.population == m_nodes[d.child[0]].population;
+}
+
+HashLife::NodeId HashLife::life4x4(NodeId node) {
+    unsigned bits = 0;
+    const Node n = m_nodes[node];
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c) {
+            const Node& quad = m_nodes[n.child[(r >> 1) * 2 + (c >> 1)]];
+            if (quad.child[(r & 1) * 2 + (c & 1)] == kAlive) bits |= 1u << (r * 4 + c);
+        }
+    const std::uint8_t out = m_life4x4[bits];
+    return join(out & 1 ? kAlive : kDead, out & 2 ? kAlive : kDead,
+                out & 4 ? kAlive : kDead, out & 8 ? kAlive : kDead);
+}
+
+// carré central (niveau - 1) de node après 2^j générations, j <= niveau - 2
+HashLife::NodeId HashLife::successor(NodeId node, int j) {
+    const int level = m_nodes[node].level;
+    if (m_nodes[node].population == 0) return emptyNode(level - 1);
+    if (level == 2) return life4x4(node);
+    j = std::min(j, level - 2);
+
+    const u64 key = (u64(node) << 6) | u64(j);
+    auto it = m_results.find(key);
+    if (it != m_results.end()) return it->second;
+
+    // copies : join() peut réallouer m_nodes
+    const Node n = m_nodes[node];
+    const Node a = m_nodes[n.child[0]];
+    const Node b = m_nodes[n.child[1]];
+    const Node c = m_nodes[n.child[2]];
+    const Node d = m_nodes[n.child[3]];
+
+    // 9 sous-carrés de niveau - 1 se chevauchant
+    NodeId s[9];
+    s[0] = n.child[0];
+    s[1] = join(a.child[1], b.child[0], a.child[3], b.child[2]);
+    s[2] = n.child[1];
+    s[3] = join(a.child[2], a.child[3], c.child[0], c.child[1]);
+    s[4] = join(a.child[3], b.child[2], c.child[1], d.child[0]);
+    s[5] = join(b.child[2], b.child[3], d.child[0], d.child[1]);
+    s[6] = n.child[2];
+    s[7] = join(c.child[1], d.child[0], c.child[3], d.child[2]);
+    s[8] = n.child[3];
+
+    NodeId r[9];
+    for (int k = 0; k < 9; ++k) r[k] = successor(s[k], j);
+
+    NodeId result;
+    if (j < level - 2) {
+        // déjà avancés de 2^j : on ne garde que les centres
+        auto inner = [&](NodeId p, NodeId q, NodeId u, NodeId v) {
+            return join(m_nodes[p].child[3], m_nodes[q].child[2],
+                        m_nodes[u].child[1], m_nodes[v].child[0]);
+        };
+        NodeId nw = inner(r[0], r[1], r[3], r[4]);
+        NodeId ne = inner(r[1], r[2], r[4], r[5]);
+        NodeId sw = inner(r[3], r[4], r[6], r[7]);
+        NodeId se = inner(r[4], r[5], r[7], r[8]);
+        result = join(nw, ne, sw, se);
+    } else {
+        // deux demi-pas de 2^(j-1)
+        NodeId nw = successor(join(r[0], r[1], r[3], r[4]), j);
+        NodeId ne = successor(join(r[1], r[2], r[4], r[5]), j);
+        NodeId sw = successor(join(r[3], r[4], r[6], r[7]), j);
+        NodeId se = successor(join(r[4], r[5], r[7], r[8]), j);
+        result = join(nw, ne, sw, se);
+    }
+    m_results.emplace(key, result);
+    return result;
+}
+
+void HashLife::advance(int log2Generations) {
+    if (log2Generations < 0) log2Generations = 0;
+    if (log2Generations > 62) {
+        throw std::invalid_argument("HashLife : pas de 2^k generations avec k > 62");
+    }
+    if (m_nodes.size() > m_maxNodes) collect();
+
+    const std::size_t nodesBefore = m_nodes.size();
+    const long long popBefore = population();
+    const Canonical before = canonical();
+
+    // marge : le motif doit tenir dans le carré central, et la racine doit
+    // être assez grande pour que 2^k générations restent dans le résultat
+    while (m_nodes[m_root].level < log2Generations + 2 || !isPadded(m_root)) {
+        const long long half = 1LL << (m_nodes[m_root].level - 1);
+        m_root = expand(m_root);
+        m_top -= half;
+        m_left -= half;
+    }
+    // expand() recule le coin de 2^(niveau-1), le résultat central
+    // l'avance d'autant : m_top / m_left sont inchangés
+    m_root = successor(expand(m_root), log2Generations);
+
+    m_generation += 1ULL << log2Generations;
+    m_createdLastStep = static_cast<long long>(m_nodes.size() - nodesBefore);
+
+    const Canonical after = canonical();
+    m_stable = after.node == before.node && after.top == before.top && after.left == before.left;
+
+    const long long popAfter = population();
+    m_lastStats = StepStats();
+    if (popAfter > popBefore) m_lastStats.births = popAfter - popBefore;
+    else m_lastStats.deaths = popBefore - popAfter;
+    const u64 hash = m_nodes[after.node].hash ^ mix(u64(after.top) * 31 + u64(after.left));
+    m_lastStats.hashDelta = hash - (m_nodes[before.node].hash ^ mix(u64(before.top) * 31 + u64(before.left)));
+    m_cycles.record(hash, popAfter, currentIteration());
+    m_viewValid = false;
+}
+
+// retire la bordure vide : deux représentations d'un même état au même
+// endroit donnent alors le même nœud (grâce au partage de structure)
+HashLife::Canonical HashLife::canonical() {
+    Canonical c = { m_root, m_top, m_left };
+    while (m_nodes[c.node].level > 2 && isPadded(c.node)) {
+        const long long quarter = 1LL << (m_nodes[c.node].level - 2);
+        c.node = centre(c.node);
+        c.top += quarter;
+        c.left += quarter;
+    }
+    return c;
+}
+
+// ramasse-miettes : reconstruit le cache avec les seuls nœuds accessibles
+// depuis la racine (les résultats mémoïsés sont oubliés)
+void HashLife::collect() {
+    std::vector<Node> nodes;
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> index;
+    std::unordered_map<NodeId, NodeId> remap;
+    nodes.push_back(m_nodes[kDead]);
+    nodes.push_back(m_nodes[kAlive]);
+    remap[kDead] = kDead;
+    remap[kAlive] = kAlive;
+
+    // parcours postfixe itératif (la profondeur vaut le niveau de la racine)
+    std::vector<std::pair<NodeId, bool>> stack;
+    stack.push_back({ m_root, false });
+    while (!stack.empty()) {
+        auto [id, expanded] = stack.back();
+        stack.pop_back();
+        if (remap.count(id)) continue;
+        const Node& n = m_nodes[id];
+        if (!expanded) {
+            stack.push_back({ id, true });
+            for (int q = 0; q < 4; ++q)
+                if (!remap.count(n.child[q])) stack.push_back({ n.child[q], false });
+            continue;
+        }
+        Node copy = n;
+        NodeKey key;
+        for (int q = 0; q < 4; ++q) {
+            copy.child[q] = remap[n.child[q]];
+            key.child[q] = copy.child[q];
+        }
+        NodeId nid = static_cast<NodeId>(nodes.size());
+        nodes.push_back(copy);
+        index.emplace(key, nid);
+        remap[id] = nid;
+    }
+
+    m_root = remap[m_root];
+    m_nodes.swap(nodes);
+    m_index.swap(index);
+    m_results.clear();
+    m_empty.assign(1, kDead);
+    ++m_collections;
+}
+
+bool HashLife::hasFinished() const {
+    if (m_generation == 0) return false; // aucune etape effectuee
+    return isStable() || m_generation >= static_cast<unsigned long long>(m_maxIterations);
+}
+
+int HashLife::currentIteration() const {
+    return m_generation > static_cast<unsigned long long>(INT_MAX)
+         ? INT_MAX : static_cast<int>(m_generation);
+}
+
+long long HashLife::population() const {
+    return static_cast<long long>(m_nodes[m_root].population);
+}
+
+bool HashLife::isAlive(long long row, long long col) const {
+    NodeId id = m_root;
+    long long top = m_top, left = m_left;
+    int level = m_nodes[id].level;
+    if (row < top || col < left || row >= top + (1LL << level) || col >= left + (1LL << level))
+        return false;
+    while (level > 0) {
+        const long long half = 1LL << (level - 1);
+        int q = 0;
+        if (row >= top + half) { q += 2; top += half; }
+        if (col >= left + half) { q += 1; left += half; }
+        id = m_nodes[id].child[q];
+        --level;
+    }
+    return id == kAlive;
+}
+
+void HashLife::extent(NodeId node, long long top, long long left, int side,
+                      bool& found, long long& best) const
+{
+    const Node& n = m_nodes[node];
+    if (n.population == 0) return;
+    const long long size = 1LL << n.level;
+    // ce carré peut-il améliorer la meilleure extrémité connue ?
+    const long long edge = side == 0 ? top : side == 1 ? top + size - 1
+                         : side == 2 ? left : left + size - 1;
+    if (found && ((side == 0 || side == 2) ? edge >= best : edge <= best)) return;
+    if (n.level == 0) {
+        best = edge;
+        found = true;
+        return;
+    }
+    const long long half = size / 2;
+    // sous-carrés du côté recherché d'abord
+    static const int order[4][4] = {
+        { 0, 1, 2, 3 }, { 2, 3, 0, 1 }, { 0, 2, 1, 3 }, { 1, 3, 0, 2 }
+    };
+    for (int k = 0; k < 4; ++k) {
+        const int q = order[side][k];
+        extent(n.child[q], top + (q >> 1) * half, left + (q & 1) * half, side, found, best);
+    }
+}
+
+BoundingBox HashLife::boundingBox() const {
+    BoundingBox box;
+    if (population() == 0) return box;
+    long long values[4];
+    for (int side = 0; side < 4; ++side) {
+        bool found = false;
+        values[side] = 0;
+        extent(m_root, m_top, m_left, side, found, values[side]);
+    }
+    box.top = values[0];
+    box.bottom = values[1];
+    box.left = values[2];
+    box.right = values[3];
+    return box;
+}
+
+void HashLife::fill(NodeId node, long long top, long long left, Grid& grid,
+                    long long winTop, long long winLeft) const
+{
+    const Node& n = m_nodes[node];
+    if (n.population == 0) return;
+    const long long size = 1LL << n.level;
+    if (top + size <= winTop || left + size <= winLeft
+        || top >= winTop + grid.rows() || left >= winLeft + grid.cols()) return;
+    if (n.level == 0) {
+        grid.setAlive(static_cast<int>(top - winTop), static_cast<int>(left - winLeft), true);
+        return;
+    }
+    const long long half = size / 2;
+    for (int q = 0; q < 4; ++q)
+        fill(n.child[q], top + (q >> 1) * half, left + (q & 1) * half, grid, winTop, winLeft);
+}
+
+Grid HashLife::window(long long top, long long left, int rows, int cols) const {
+    Grid grid(rows, cols, false);
+    fill(m_root, m_top, m_left, grid, top, left);
+    return grid;
+}
+
+void HashLife::setView(long long top, long long left, int rows, int cols) {
+    m_viewBox = BoundingBox();
+    if (rows > 0 && cols > 0) {
+        m_viewBox.top = top;
+        m_viewBox.left = left;
+        m_viewBox.bottom = top + rows - 1;
+        m_viewBox.right = left + cols - 1;
+    }
+    m_viewValid = false;
+}
+
+const Grid& HashLife::currentGrid() const {
+    if (!m_viewValid) {
+        BoundingBox box = m_viewBox.empty() ? boundingBox() : m_viewBox;
+        checkViewSize(box);
+        m_view = window(box.top, box.left,
+                        static_cast<int>(box.rows()), static_cast<int>(box.cols()));
+        m_viewValid = true;
+    }
+    return m_view;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "BoundingBox.h"
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "LifeEngine.h"
+#include "RuleSpec.h"
+#include "StepStats.h"
+
+// Moteur HashLife (règle B/S sans B0, univers non borné) : quadtree à partage de
+// structure (chaque nœud distinct n'existe qu'une fois) et mémoïsation du
+// résultat central de chaque nœud, ce qui permet d'avancer de 2^k
+// générations en un seul appel. Le cache de nœuds est borné : au-delà de
+// maxNodes, les nœuds inaccessibles depuis la racine sont collectés.
+class HashLife : public LifeEngine {
+public:
+    // la cellule (r, c) de initial est placée en (r, c) ; le mode torique
+    // est ignoré. Chaque step() avance de 2^stepLog2 générations. Lève
+    // std::invalid_argument pour une règle B0 ou multi-états.
+    HashLife(const Grid& initial,
+             int maxIterations,
+             int stepLog2 = 0,
+             std::size_t maxNodes = std::size_t(1) << 22,
+             int cycleHistory = 64,
+             const RuleSpec& rule = RuleSpec::conway());
+
+    void advance(int log2Generations); // avance de 2^log2Generations générations
+    unsigned long long generation() const { return m_generation; }
+
+    void step() override { advance(m_stepLog2); }
+    bool isStable() const override { return m_stable; }
+    bool hasFinished() const override;
+    int currentIteration() const override; // génération (bornée à INT_MAX)
+    int detectedPeriod() const override { return m_cycles.period(); }
+    long long population() const override;
+    // bilan net : la population seule est connue (naissances - morts)
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+
+    // vue dense de la fenêtre définie par setView(), ou à défaut du
+    // rectangle englobant (recalculée à la demande)
+    const Grid& currentGrid() const override;
+    void setView(long long top, long long left, int rows, int cols);
+
+    // nœuds créés au dernier pas / nœuds en cache
+    long long activeTiles() const override { return m_createdLastStep; }
+    long long tileCount() const override { return static_cast<long long>(m_nodes.size()); }
+
+    bool isAlive(long long row, long long col) const;
+    BoundingBox boundingBox() const;
+    Grid window(long long top, long long left, int rows, int cols) const;
+
+    std::size_t nodeCount() const { return m_nodes.size(); }
+    int collections() const { return m_collections; } // ramasse-miettes effectués
+
+private:
+    typedef std::uint32_t NodeId;
+
+    struct Node {
+        NodeId child[4];          // nw, ne, sw, se (feuilles : inutilisés)
+        std::uint64_t population;
+        std::uint64_t hash;       // empreinte structurelle (stable au GC)
+        int level;                // côté = 2^level
+    };
+
+    struct NodeKey {
+        NodeId child[4];
+        bool operator==(const NodeKey& o) const {
+            return child[0] == o.child[0] && child[1] == o.child[1]
+                && child[2] == o.child[2] && child[3] == o.child[3];
+        }
+    };
+    struct NodeKeyHash {
+        std::size_t operator()(const NodeKey& k) const;
+    };
+
+    // racine normalisée (bordure vide retirée) pour comparer deux états
+    struct Canonical {
+        NodeId node;
+        long long top;
+        long long left;
+    };
+
+    static constexpr NodeId kDead = 0;
+    static constexpr NodeId kAlive = 1;
+
+    NodeId join(NodeId nw, NodeId ne, NodeId sw, NodeId se);
+    NodeId emptyNode(int level);
+    NodeId build(const Grid& grid, int level, int top, int left);
+    NodeId expand(NodeId node);
+    NodeId centre(NodeId node);
+    bool isPadded(NodeId node) const;
+    NodeId life4x4(NodeId node);
+    NodeId successor(NodeId node, int j);
+    Canonical canonical();
+    void collect();
+
+    void fill(NodeId node, long long top, long long left, Grid& grid,
+              long long winTop, long long winLeft) const;
+    // extrémité des cellules vivantes d'un côté (0 haut, 1 bas, 2 gauche, 3 droite)
+    void extent(NodeId node, long long top, long long left, int side,
+                bool& found, long long& best) const;
+
+    std::vector<std::uint8_t> m_life4x4; // carré 4x4 -> centre 2x2 après un pas
+    std::vector<Node> m_nodes;
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> m_index;
+    std::unordered_map<std::uint64_t, NodeId> m_results; // (nœud, j) -> résultat
+    std::vector<NodeId> m_empty;                        // nœud vide par niveau
+    std::size_t m_maxNodes;
+    int m_collections;
+
+    NodeId m_root;
+    long long m_top;    // coordonnées du coin haut-gauche de la racine
+    long long m_left;
+
+    int m_maxIterations;
+    int m_stepLog2;
+    unsigned long long m_generation;
+    bool m_stable;
+    StepStats m_lastStats;
+    long long m_createdLastStep;
+    CycleDetector m_cycles;
+
+    BoundingBox m_viewBox;
+    mutable Grid m_view;
+    mutable bool m_viewValid;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdexcept>
+#include "BoundingBox.h"
+#include "EngineCheckpoint.h"
+#include "Grid.h"
+#include "StateGrid.h"
+#include "StepStats.h"
+
+// Interface commune des moteurs de simulation (grille dense, univers
+// creux...) pilotés par SimulationService.
+class LifeEngine {
+public:
+    virtual ~LifeEngine() = default;
+
+    virtual void step() = 0;                   // une itération
+    virtual bool isStable() const = 0;         // aucun changement au dernier pas
+    virtual bool hasFinished() const = 0;      // stable ou max atteint
+    virtual int currentIteration() const = 0;
+    virtual int detectedPeriod() const = 0;    // 1 = stable, N = oscillateur, 0 = aucun
+    virtual long long population() const = 0;
+    virtual const StepStats& lastStepStats() const = 0; // naissances/morts du dernier pas
+
+    // vue dense de l'état courant (exportable via IGridExporter)
+    virtual const Grid& currentGrid() const = 0;
+    // états multiples (règles Generations), nullptr pour un moteur à deux états
+    virtual const StateGrid* currentStates() const { return nullptr; }
+
+    // unités de calcul (tuiles, blocs) recalculées au dernier pas, et
+    // nombre d'unités stockées
+    virtual long long activeTiles() const = 0;
+    virtual long long tileCount() const = 0;
+    // rectangle englobant les cellules modifiées au dernier pas, à la
+    // granularité des unités de calcul ; vide si rien n'a changé ou si le
+    // moteur ne le suit pas (hashlife, Generations)
+    virtual BoundingBox activeRegion() const { return BoundingBox(); }
+
+    // points de reprise : copie de l'état complet, puis restauration sur un
+    // moteur construit à partir de checkpoint.grid
+    virtual bool supportsCheckpoint() const { return false; }
+    virtual void saveCheckpoint(EngineCheckpoint&) const {
+        throw std::logic_error("Moteur sans point de reprise");
+    }
+    virtual void restoreCheckpoint(const EngineCheckpoint&) {
+        throw std::logic_error("Moteur sans point de reprise");
+    }
+};
@@ -0,0 +1,274 @@
+#include "LifeKernel.h"
+#include "LifeWord.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIFE_KERNEL_X86 1
+#endif
+
+namespace {
+
+typedef std::uint64_t u64;
+
+// voisins ouest/est du mot wi d'une ligne (bit i <- colonne i-1 / i+1)
+inline u64 westOf(const u64* row, int wi, int cols, bool wrap) {
+    u64 carry;
+    if (wi > 0)
+        carry = row[wi - 1] >> 63;
+    else
+        carry = wrap ? (row[(cols - 1) >> 6] >> ((cols - 1) & 63)) & 1u : 0;
+    return (row[wi] << 1) | carry;
+}
+
+inline u64 eastOf(const u64* row, int wi, int words, int cols, bool wrap) {
+    if (wi + 1 < words)
+        return (row[wi] >> 1) | (row[wi + 1] << 63);
+    u64 carry = wrap ? (row[0] & 1u) : 0;
+    return (row[wi] >> 1) | (carry << ((cols - 1) & 63));
+}
+
+template <class R>
+inline void scalarWord(const RuleSpec& rule, const u64* up, const u64* cur, const u64* down,
+                       u64* out, int wi, int words, int cols, bool wrap)
+{
+    u64 r;
+    R::template word<u64>(rule, westOf(up, wi, cols, wrap), up[wi], eastOf(up, wi, words, cols, wrap),
+                  westOf(cur, wi, cols, wrap), cur[wi], eastOf(cur, wi, words, cols, wrap),
+                  westOf(down, wi, cols, wrap), down[wi], eastOf(down, wi, words, cols, wrap),
+                  r);
+    out[wi] = r;
+}
+
+// mots intérieurs [begin, end) : les voisins wi-1 et wi+1 existent toujours
+template <class R, class V>
+__attribute__((always_inline)) inline int interiorWords(
+    const RuleSpec& rule, const u64* up, const u64* cur, const u64* down, u64* out, int begin, int end)
+{
+    const int lanes = sizeof(V) / sizeof(u64);
+    int wi = begin;
+    for (; wi + lanes <= end; wi += lanes) {
+        V rows[3][3];
+        const u64* src[3] = { up, cur, down };
+        for (int k = 0; k < 3; ++k) {
+            V prev, mid, next;
+            std::memcpy(&prev, src[k] + wi - 1, sizeof(V));
+            std::memcpy(&mid,  src[k] + wi,     sizeof(V));
+            std::memcpy(&next, src[k] + wi + 1, sizeof(V));
+            rows[k][0] = (mid << 1) | (prev >> 63);
+            rows[k][1] = mid;
+            rows[k][2] = (mid >> 1) | (next << 63);
+        }
+        V r;
+        R::template word<V>(rule, rows[0][0], rows[0][1], rows[0][2],
+                    rows[1][0], rows[1][1], rows[1][2],
+                    rows[2][0], rows[2][1], rows[2][2], r);
+        std::memcpy(out + wi, &r, sizeof(V));
+    }
+    return wi;
+}
+
+template <class R>
+int interiorScalar(const RuleSpec& rule, const u64* up, const u64* cur, const u64* down,
+                   u64* out, int begin, int end)
+{
+    return interiorWords<R, u64>(rule, up, cur, down, out, begin, end);
+}
+
+#ifdef LIFE_KERNEL_X86
+typedef u64 v2u64 __attribute__((vector_size(16)));
+typedef u64 v4u64 __attribute__((vector_size(32)));
+
+template <class R>
+__attribute__((target("sse2")))
+int interiorSse2(const RuleSpec& rule, const u64* up, const u64* cur, const u64* down,
+                 u64* out, int begin, int end)
+{
+    return interiorWords<R, v2u64>(rule, up, cur, down, out, begin, end);
+}
+
+template <class R>
+__attribute__((target("avx2")))
+int interiorAvx2(const RuleSpec& rule, const u64* up, const u64* cur, const u64* down,
+                 u64* out, int begin, int end)
+{
+    return interiorWords<R, v4u64>(rule, up, cur, down, out, begin, end);
+}
+#endif
+
+LifeKernel::Isa detectIsa() {
+#ifdef LIFE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return LifeKernel::Isa::Avx2;
+    if (__builtin_cpu_supports("sse2")) return LifeKernel::Isa::Sse2;
+#endif
+    return LifeKernel::Isa::Scalar;
+}
+
+std::atomic<int>& activeIsaSlot() {
+    static std::atomic<int> slot(static_cast<int>(detectIsa()));
+    return slot;
+}
+
+const u64* zeroRow(int words) {
+    thread_local std::vector<u64> zeros;
+    if (static_cast<int>(zeros.size()) < words) zeros.assign(words, 0);
+    return zeros.data();
+}
+
+// une ligne pour la règle R (voir LifeKernel::stepRowWords)
+template <class R>
+void stepRowFor(const RuleSpec& rule,
+                const u64* up, const u64* cur, const u64* down, u64* out,
+                int cols, bool wrapCols, int wordBegin, int wordEnd)
+{
+    const int words = (cols + 63) / 64;
+    if (wordBegin >= wordEnd) return;
+    if (!up)   up = zeroRow(words);
+    if (!down) down = zeroRow(words);
+
+    // premier et dernier mots de la ligne : bords (repli torique ou vide)
+    int wi = wordBegin;
+    if (wi == 0) {
+        scalarWord<R>(rule, up, cur, down, out, 0, words, cols, wrapCols);
+        wi = 1;
+    }
+    const int interiorEnd = std::min(wordEnd, words - 1);
+    if (wi < interiorEnd) {
+        switch (LifeKernel::activeIsa()) {
+#ifdef LIFE_KERNEL_X86
+        case LifeKernel::Isa::Avx2: wi = interiorAvx2<R>(rule, up, cur, down, out, wi, interiorEnd); break;
+        case LifeKernel::Isa::Sse2: wi = interiorSse2<R>(rule, up, cur, down, out, wi, interiorEnd); break;
+#endif
+        default: break;
+        }
+        interiorScalar<R>(rule, up, cur, down, out, wi, interiorEnd);
+    }
+    if (wordEnd == words && words > 1)
+        scalarWord<R>(rule, up, cur, down, out, words - 1, words, cols, wrapCols);
+
+    // les bits de bourrage doivent rester nuls
+    int used = cols & 63;
+    if (wordEnd == words && used != 0) out[words - 1] &= (u64(1) << used) - 1;
+}
+
+typedef void (*RowFunction)(const RuleSpec&, const u64*, const u64*, const u64*, u64*,
+                            int, bool, int, int);
+
+// règles courantes, spécialisées à la compilation
+#define LIFE_RULE(b, s) { RuleSpec{ b, s }, &stepRowFor<FixedLifeRule<b, s>> }
+const struct {
+    RuleSpec rule;
+    RowFunction row;
+} kSpecialised[] = {
+    LIFE_RULE(0x008, 0x00C), // B3/S23 Conway
+    LIFE_RULE(0x048, 0x00C), // B36/S23 HighLife
+    LIFE_RULE(0x1C8, 0x1D8), // B3678/S34678 Day & Night
+    LIFE_RULE(0x004, 0x000), // B2/S Seeds
+    LIFE_RULE(0x008, 0x1FF), // B3/S012345678 Life sans mort
+    LIFE_RULE(0x008, 0x03E), // B3/S12345 Maze
+    LIFE_RULE(0x148, 0x034), // B368/S245 Morley
+    LIFE_RULE(0x048, 0x026), // B36/S125 2x2
+    LIFE_RULE(0x0AA, 0x0AA), // B1357/S1357 Replicator
+};
+#undef LIFE_RULE
+
+} // namespace
+
+LifeKernel::Isa LifeKernel::bestIsa() {
+    static const Isa best = detectIsa();
+    return best;
+}
+
+LifeKernel::Isa LifeKernel::activeIsa() {
+    return static_cast<Isa>(activeIsaSlot().load(std::memory_order_relaxed));
+}
+
+void LifeKernel::forceIsa(Isa isa) {
+    if (static_cast<int>(isa) > static_cast<int>(bestIsa())) isa = bestIsa();
+    activeIsaSlot().store(static_cast<int>(isa), std::memory_order_relaxed);
+}
+
+const char* LifeKernel::isaName(Isa isa) {
+    switch (isa) {
+    case Isa::Avx2: return "avx2";
+    case Isa::Sse2: return "sse2";
+    default:        return "scalar";
+    }
+}
+
+LifeKernel::RowKernel::RowKernel(const RuleSpec& rule)
+    : m_rule(rule),
+      m_row(&stepRowFor<RuntimeLifeRule>),
+      m_specialised(false)
+{
+    for (const auto& entry : kSpecialised) {
+        if (entry.rule == rule) {
+            m_row = entry.row;
+            m_specialised = true;
+            break;
+        }
+    }
+}
+
+void LifeKernel::stepRow(const std::uint64_t* up,
+                         const std::uint64_t* cur,
+                         const std::uint64_t* down,
+                         std::uint64_t* out,
+                         int cols,
+                         bool wrapCols,
+                         const RowKernel& kernel)
+{
+    kernel(up, cur, down, out, cols, wrapCols, 0, (cols + 63) / 64);
+}
+
+void LifeKernel::stepRowWords(const std::uint64_t* up,
+                              const std::uint64_t* cur,
+                              const std::uint64_t* down,
+                              std::uint64_t* out,
+                              int cols,
+                              bool wrapCols,
+                              int wordBegin,
+                              int wordEnd,
+                              const RowKernel& kernel)
+{
+    kernel(up, cur, down, out, cols, wrapCols, wordBegin, wordEnd);
+}
+
+StepStats LifeKernel::stepBlock(const Grid& src, Grid& dst,
+                                int rowBegin, int rowEnd,
+                                int wordBegin, int wordEnd,
+                                const RowKernel& kernel)
+{
+    StepStats stats;
+    const int rows = src.rows();
+    const int words = src.wordsPerRow();
+    const bool wrap = src.toroidal();
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        const std::uint64_t* up = nullptr;
+        const std::uint64_t* down = nullptr;
+        if (r > 0)             up = src.rowWords(r - 1);
+        else if (wrap)         up = src.rowWords(rows - 1);
+        if (r + 1 < rows)      down = src.rowWords(r + 1);
+        else if (wrap)         down = src.rowWords(0);
+        kernel(up, src.rowWords(r), down, dst.rowWords(r), src.cols(), wrap,
+               wordBegin, wordEnd);
+        // bilan tant que la ligne est en cache
+        accumulateRow(stats, src.rowWords(r) + wordBegin, dst.rowWords(r) + wordBegin,
+                      wordEnd - wordBegin,
+                      static_cast<std::uint64_t>(r) * words + wordBegin);
+    }
+    return stats;
+}
+
+StepStats LifeKernel::stepRows(const Grid& src, Grid& dst, int rowBegin, int rowEnd,
+                               const RowKernel& kernel)
+{
+    return stepBlock(src, dst, rowBegin, rowEnd, 0, src.wordsPerRow(), kernel);
+}
+
+StepStats LifeKernel::step(const Grid& src, Grid& dst, const RowKernel& kernel) {
+    return stepRows(src, dst, 0, src.rows(), kernel);
+}
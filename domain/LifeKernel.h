@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include "Grid.h"
+#include "RuleSpec.h"
+#include "StepStats.h"
+
+// Noyau Life-like (B/S) sur le stockage compact de Grid : 64 cellules par
+// mot grâce à un comptage de voisins par additionneurs binaires. Les mots
+// intérieurs d'une ligne passent par un chemin AVX2 ou SSE2 choisi à
+// l'exécution, avec repli scalaire portable.
+class LifeKernel {
+public:
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    // Calcul d'une ligne pour une règle, choisi une fois (par simulation) :
+    // les règles courantes (Conway, HighLife, Day & Night, Seeds...) ont
+    // une version spécialisée à la compilation, les autres une version
+    // générique qui lit les masques B/S.
+    class RowKernel {
+    public:
+        explicit RowKernel(const RuleSpec& rule = RuleSpec::conway());
+
+        const RuleSpec& rule() const { return m_rule; }
+        bool specialised() const { return m_specialised; }
+
+        void operator()(const std::uint64_t* up,
+                        const std::uint64_t* cur,
+                        const std::uint64_t* down,
+                        std::uint64_t* out,
+                        int cols,
+                        bool wrapCols,
+                        int wordBegin,
+                        int wordEnd) const
+        {
+            m_row(m_rule, up, cur, down, out, cols, wrapCols, wordBegin, wordEnd);
+        }
+
+    private:
+        typedef void (*RowFunction)(const RuleSpec&,
+                                    const std::uint64_t*, const std::uint64_t*,
+                                    const std::uint64_t*, std::uint64_t*,
+                                    int, bool, int, int);
+        RuleSpec m_rule;
+        RowFunction m_row;
+        bool m_specialised;
+    };
+
+    static Isa bestIsa();              // meilleur jeu d'instructions disponible
+    static Isa activeIsa();
+    static void forceIsa(Isa isa);     // borné à bestIsa() (tests, mesures)
+    static const char* isaName(Isa isa);
+
+    // dst = génération suivante de src (mêmes dimensions, même mode torique),
+    // retourne le bilan des changements
+    // (B3/S23 par défaut)
+    static StepStats step(const Grid& src, Grid& dst,
+                          const RowKernel& kernel = RowKernel());
+    // idem, restreint aux lignes [rowBegin, rowEnd)
+    static StepStats stepRows(const Grid& src, Grid& dst, int rowBegin, int rowEnd,
+                              const RowKernel& kernel = RowKernel());
+    // idem, restreint au bloc lignes [rowBegin, rowEnd) x mots [wordBegin, wordEnd)
+    static StepStats stepBlock(const Grid& src, Grid& dst,
+                               int rowBegin, int rowEnd,
+                               int wordBegin, int wordEnd,
+                               const RowKernel& kernel = RowKernel());
+
+    // une ligne : up/down = lignes voisines (nullptr = hors grille),
+    // wrapCols = bords gauche/droit reliés
+    static void stepRow(const std::uint64_t* up,
+                        const std::uint64_t* cur,
+                        const std::uint64_t* down,
+                        std::uint64_t* out,
+                        int cols,
+                        bool wrapCols,
+                        const RowKernel& kernel = RowKernel());
+    // idem, restreint aux mots [wordBegin, wordEnd) de la ligne
+    static void stepRowWords(const std::uint64_t* up,
+                             const std::uint64_t* cur,
+                             const std::uint64_t* down,
+                             std::uint64_t* out,
+                             int cols,
+                             bool wrapCols,
+                             int wordBegin,
+                             int wordEnd,
+                             const RowKernel& kernel = RowKernel());
+};
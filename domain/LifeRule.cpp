@@ -0,0 +1,45 @@
+#include "LifeRule.h"
+#include "AliveState.h"
+#include "ConwayRule.h"
+#include "DeadState.h"
+#include <typeinfo>
+
+CellState* LifeRule::nextState(const Cell& cell, const Grid& grid) const {
+    const std::uint16_t mask = cell.isAlive() ? m_spec.survival : m_spec.birth;
+    if (mask & (1u << grid.countAliveNeighbors(cell.row(), cell.col())))
+        return new AliveState();
+    return new DeadState();
+}
+
+const CellState& LifeRule::next(const Cell& cell, const Grid& grid, int neighbours) const {
+    // classe derivee : ses redefinitions passent avant la regle B/S
+    if (!specOf(*this)) return Rule::next(cell, grid, neighbours);
+    const std::uint16_t mask = cell.isAlive() ? m_spec.survival : m_spec.birth;
+    if (mask & (1u << neighbours))
+        return AliveState::instance();
+    return DeadState::instance();
+}
+
+void LifeRule::nextRow(const Grid& grid,
+                       int row,
+                       int colBegin,
+                       int colEnd,
+                       const std::uint8_t* neighbours,
+                       std::uint8_t* out) const
+{
+    if (!specOf(*this)) {
+        Rule::nextRow(grid, row, colBegin, colEnd, neighbours, out);
+        return;
+    }
+    for (int c = colBegin; c < colEnd; ++c) {
+        const std::uint16_t mask = grid.isAlive(row, c) ? m_spec.survival : m_spec.birth;
+        out[c - colBegin] = (mask >> neighbours[c - colBegin]) & 1u;
+    }
+}
+
+const RuleSpec* LifeRule::specOf(const Rule& rule) {
+    if (typeid(rule) != typeid(LifeRule) && typeid(rule) != typeid(ConwayRule)) {
+        return nullptr;
+    }
+    return &static_cast<const LifeRule&>(rule).spec();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "Rule.h"
+#include "RuleSpec.h"
+
+// Règle Life-like quelconque (B/S) appliquée cellule par cellule. Les
+// moteurs reconnaissent cette classe (et ConwayRule) et la remplacent par
+// leurs noyaux binaires.
+//
+// Une classe dérivée garde les versions par défaut de Rule : ce qu'elle
+// redéfinit (nextState(), next() ou nextRow()) est bien appelé, et ce
+// qu'elle ne redéfinit pas retombe sur la règle B/S via nextState().
+class LifeRule : public Rule {
+public:
+    explicit LifeRule(const RuleSpec& spec) : m_spec(spec) {}
+
+    CellState* nextState(const Cell& cell,
+                         const Grid& grid) const override;
+    // états partagés, aucune allocation (LifeRule et ConwayRule exactement)
+    const CellState& next(const Cell& cell,
+                          const Grid& grid,
+                          int neighbours) const override;
+    void nextRow(const Grid& grid,
+                 int row,
+                 int colBegin,
+                 int colEnd,
+                 const std::uint8_t* neighbours,
+                 std::uint8_t* out) const override;
+
+    const RuleSpec& spec() const { return m_spec; }
+
+    // spécification de rule si son calcul est exactement celui de LifeRule,
+    // nullptr sinon (une classe dérivée garde le chemin générique)
+    static const RuleSpec* specOf(const Rule& rule);
+
+private:
+    RuleSpec m_spec;
+};
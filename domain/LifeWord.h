@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include "RuleSpec.h"
+
+// B3/S23 sur des vecteurs de bits : chaque argument porte un voisin
+// (déjà décalé) pour 64 cellules par mot ; V = std::uint64_t ou type
+// vectoriel (extensions GCC). Partagé par les moteurs à stockage compact.
+template <class V>
+__attribute__((always_inline)) inline void lifeWord(
+    const V& uw, const V& u, const V& ue,
+    const V& w,  const V& c, const V& e,
+    const V& dw, const V& d, const V& de,
+    V& out)
+{
+    // somme de chaque rangée (haut : 0..3, milieu : 0..2, bas : 0..3)
+    V u0 = uw ^ u ^ ue;
+    V u1 = (uw & u) | (ue & (uw ^ u));
+    V m0 = w ^ e;
+    V m1 = w & e;
+    V d0 = dw ^ d ^ de;
+    V d1 = (dw & d) | (de & (dw ^ d));
+
+    // unites puis paires : total = s0 + 2 * (x0 + 2 * (x1 + t1))
+    V s0 = u0 ^ m0 ^ d0;
+    V c0 = (u0 & m0) | (d0 & (u0 ^ m0));
+    V t0 = u1 ^ m1 ^ d1;
+    V t1 = (u1 & m1) | (d1 & (u1 ^ m1));
+    V x0 = t0 ^ c0;
+    V x1 = t0 & c0;
+
+    // 3 voisins, ou 2 voisins et cellule vivante
+    out = x0 & ~(x1 | t1) & (s0 | c);
+}
+
+// nombre de voisins (0..8) en tranches de bits : n = n0 + 2 n1 + 4 n2 + 8 n3
+template <class V>
+__attribute__((always_inline)) inline void neighbourCount(
+    const V& uw, const V& u, const V& ue,
+    const V& w,  const V& e,
+    const V& dw, const V& d, const V& de,
+    V& n0, V& n1, V& n2, V& n3)
+{
+    V u0 = uw ^ u ^ ue;
+    V u1 = (uw & u) | (ue & (uw ^ u));
+    V m0 = w ^ e;
+    V m1 = w & e;
+    V d0 = dw ^ d ^ de;
+    V d1 = (dw & d) | (de & (dw ^ d));
+
+    V c0 = (u0 & m0) | (d0 & (u0 ^ m0));
+    V t0 = u1 ^ m1 ^ d1;
+    V t1 = (u1 & m1) | (d1 & (u1 ^ m1));
+    V x1 = t0 & c0;
+
+    n0 = u0 ^ m0 ^ d0;
+    n1 = t0 ^ c0;
+    n2 = x1 ^ t1;
+    n3 = x1 & t1;
+}
+
+// cellules ayant exactement N voisins (paramètres de sortie : pas de
+// retour de vecteur par valeur, dont l'ABI dépend du jeu d'instructions)
+template <int N, class V>
+__attribute__((always_inline)) inline void countIs(
+    const V& n0, const V& n1, const V& n2, const V& n3, V& eq)
+{
+    eq = ((N & 1) ? n0 : ~n0) & ((N & 2) ? n1 : ~n1)
+       & ((N & 4) ? n2 : ~n2) & ((N & 8) ? n3 : ~n3);
+}
+
+// Règle connue à la compilation : les comptes absents de Birth et Survival
+// disparaissent, B3/S23 garde l'expression simplifiée de lifeWord().
+template <unsigned Birth, unsigned Survival>
+struct FixedLifeRule {
+    template <int N, class V>
+    __attribute__((always_inline)) static inline void term(
+        const V& n0, const V& n1, const V& n2, const V& n3, const V& c, V& out)
+    {
+        constexpr bool born = (Birth >> N) & 1u;
+        constexpr bool survives = (Survival >> N) & 1u;
+        if constexpr (born || survives) {
+            V eq;
+            countIs<N>(n0, n1, n2, n3, eq);
+            if constexpr (born && survives) out |= eq;
+            else if constexpr (born) out |= eq & ~c;
+            else out |= eq & c;
+        }
+    }
+
+    template <class V, int... N>
+    __attribute__((always_inline)) static inline void combine(
+        const V& n0, const V& n1, const V& n2, const V& n3, const V& c, V& out,
+        std::integer_sequence<int, N...>)
+    {
+        out = c ^ c;
+        (term<N>(n0, n1, n2, n3, c, out), ...);
+    }
+
+    template <class V>
+    __attribute__((always_inline)) static inline void word(
+        const RuleSpec&,
+        const V& uw, const V& u, const V& ue,
+        const V& w,  const V& c, const V& e,
+        const V& dw, const V& d, const V& de,
+        V& out)
+    {
+        if constexpr (RuleSpec{ Birth, Survival } == RuleSpec::conway()) {
+            lifeWord<V>(uw, u, ue, w, c, e, dw, d, de, out);
+        } else {
+            V n0, n1, n2, n3;
+            neighbourCount<V>(uw, u, ue, w, e, dw, d, de, n0, n1, n2, n3);
+            combine<V>(n0, n1, n2, n3, c, out, std::make_integer_sequence<int, 9>());
+        }
+    }
+};
+
+typedef FixedLifeRule<RuleSpec::conway().birth, RuleSpec::conway().survival> ConwayLifeRule;
+
+// Règle lue à l'exécution : parcourt les 9 comptes possibles.
+struct RuntimeLifeRule {
+    template <class V>
+    __attribute__((always_inline)) static inline void word(
+        const RuleSpec& rule,
+        const V& uw, const V& u, const V& ue,
+        const V& w,  const V& c, const V& e,
+        const V& dw, const V& d, const V& de,
+        V& out)
+    {
+        V n0, n1, n2, n3;
+        neighbourCount<V>(uw, u, ue, w, e, dw, d, de, n0, n1, n2, n3);
+        V born = c ^ c;
+        V survives = born;
+        for (int n = 0; n <= 8; ++n) {
+            const bool b = (rule.birth >> n) & 1u;
+            const bool s = (rule.survival >> n) & 1u;
+            if (!b && !s) continue;
+            V eq = ((n & 1) ? n0 : ~n0) & ((n & 2) ? n1 : ~n1)
+                 & ((n & 4) ? n2 : ~n2) & ((n & 8) ? n3 : ~n3);
+            if (b) born |= eq;
+            if (s) survives |= eq;
+        }
+        out = (born & ~c) | (survives & c);
+    }
+};
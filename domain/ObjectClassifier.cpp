@@ -0,0 +1,133 @@
+#include "ObjectClassifier.h"
+#include "SparseLife.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// objets usuels de B3/S23 (une phase, '1' = vivante)
+const struct {
+    const char* name;
+    std::vector<const char*> rows;
+} kKnownObjects[] = {
+    { "bloc", { "11", "11" } },
+    { "ruche", { ".11.", "1..1", ".11." } },
+    { "pain", { ".11.", "1..1", ".1.1", "..1." } },
+    { "bateau", { "11.", "1.1", ".1." } },
+    { "navire", { "11.", "1.1", ".11" } },
+    { "baignoire", { ".1.", "1.1", ".1." } },
+    { "mare", { ".11.", "1..1", "1..1", ".11." } },
+    { "long bateau", { ".1..", "1.1.", ".1.1", "..11" } },
+    { "peniche", { ".1..", "1.1.", ".1.1", "..1." } },
+    { "mangue", { ".11..", "1..1.", ".1..1", "..11." } },
+    { "clignotant", { "111" } },
+    { "crapaud", { ".111", "111." } },
+    { "balise", { "11..", "11..", "..11", "..11" } },
+    { "pulsar", { "..111...111..", ".............", "1....1.1....1", "1....1.1....1",
+                  "1....1.1....1", "..111...111..", ".............", "..111...111..",
+                  "1....1.1....1", "1....1.1....1", "1....1.1....1", ".............",
+                  "..111...111.." } },
+    { "pentadecathlon", { "..1....1..", "11.1111.11", "..1....1.." } },
+    { "planeur", { ".1.", "..1", "111" } },
+    { "vaisseau leger", { ".1..1", "1....", "1...1", "1111." } },
+    { "vaisseau moyen", { "...1..", ".1...1", "1.....", "1....1", "11111." } },
+    { "vaisseau lourd", { "...11..", ".1....1", "1......", "1.....1", "111111." } },
+};
+
+ObjectShape shapeOf(const std::vector<const char*>& rows) {
+    std::vector<ObjectShape::Cell> cells;
+    for (std::size_t r = 0; r < rows.size(); ++r)
+        for (std::size_t c = 0; rows[r][c]; ++c)
+            if (rows[r][c] == '1') cells.emplace_back(r, c);
+    return ObjectShape::fromCells(cells);
+}
+
+} // namespace
+
+const char* ObjectClass::kindName(Kind kind) {
+    switch (kind) {
+    case Kind::StillLife: return "stable";
+    case Kind::Oscillator: return "oscillateur";
+    case Kind::Spaceship: return "vaisseau";
+    case Kind::Other: return "autre";
+    }
+    return "?";
+}
+
+ObjectClassifier::ObjectClassifier(const RuleSpec& rule, int maxPeriod, std::size_t maxCacheEntries)
+    : m_rule(rule),
+      m_maxPeriod(std::max(maxPeriod, 1)),
+      m_maxCacheEntries(std::max<std::size_t>(maxCacheEntries, 1))
+{
+    if (!m_rule.isConway()) return;
+    std::vector<ObjectShape> phases;
+    for (const auto& known : kKnownObjects) {
+        const ObjectClass found = evolve(shapeOf(known.rows), phases);
+        m_names[found.code] = known.name;
+    }
+}
+
+// Avance l'objet seul ; phases recoit la forme canonique de chaque phase
+// d'un objet periodique.
+ObjectClass ObjectClassifier::evolve(const ObjectShape& shape, std::vector<ObjectShape>& phases) const {
+    ObjectClass result;
+    phases.assign(1, shape.canonical());
+    Grid initial(shape.rows, shape.cols, false);
+    for (std::uint32_t cell : shape.cells)
+        initial.setAlive(static_cast<int>(cell >> 16), static_cast<int>(cell & 0xFFFFu), true);
+    SparseLife life(initial, m_maxPeriod, 1, m_rule);
+
+    // au-dela, l'objet grandit : ce n'est ni un oscillateur ni un vaisseau
+    const std::size_t maxPopulation = 8 * shape.population() + 64;
+    std::vector<ObjectShape::Cell> cells;
+    for (int t = 1; t <= m_maxPeriod; ++t) {
+        life.step();
+        if (life.population() == 0
+            || static_cast<std::size_t>(life.population()) > maxPopulation) break;
+        life.liveCells(cells);
+        long long top = 0, left = 0;
+        ObjectShape next = ObjectShape::fromCells(cells, &top, &left);
+        if (next != shape) {
+            phases.push_back(next.canonical());
+            continue;
+        }
+        result.period = t;
+        const int dr = static_cast<int>(std::llabs(top));
+        const int dc = static_cast<int>(std::llabs(left));
+        result.dx = std::max(dr, dc);
+        result.dy = std::min(dr, dc);
+        if (result.dx > 0) result.kind = ObjectClass::Kind::Spaceship;
+        else result.kind = t == 1 ? ObjectClass::Kind::StillLife : ObjectClass::Kind::Oscillator;
+        result.code = std::min_element(phases.begin(), phases.end())->code();
+        return result;
+    }
+    phases.resize(1);
+    result.code = phases[0].code();
+    return result;
+}
+
+const ObjectClass& ObjectClassifier::classify(const ObjectShape& shape) {
+    auto it = m_cache.find(shape);
+    if (it != m_cache.end()) {
+        ++m_hits;
+        return it->second;
+    }
+    if (m_cache.size() >= m_maxCacheEntries) m_cache.clear();
+
+    // meme objet deja vu dans une autre orientation ou une autre phase
+    ObjectShape canonical = shape.canonical();
+    it = m_cache.find(canonical);
+    if (it != m_cache.end()) {
+        ++m_hits;
+        ObjectClass found = it->second;
+        return m_cache.emplace(shape, std::move(found)).first->second;
+    }
+
+    ++m_misses;
+    std::vector<ObjectShape> phases;
+    ObjectClass found = evolve(shape, phases);
+    auto name = m_names.find(found.code);
+    if (name != m_names.end()) found.name = name->second;
+    for (ObjectShape& phase : phases) m_cache.emplace(std::move(phase), found);
+    return m_cache.emplace(shape, std::move(found)).first->second;
+}
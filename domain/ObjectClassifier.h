@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ObjectShape.h"
+#include "RuleSpec.h"
+
+// Nature d'un objet isolé, indépendante de sa position, de son orientation
+// et de sa phase.
+struct ObjectClass {
+    enum class Kind { StillLife, Oscillator, Spaceship, Other };
+
+    Kind kind = Kind::Other;
+    int period = 0;     // 1 pour une nature morte, 0 pour Other
+    int dx = 0;         // vaisseau : déplacement par période (dx >= dy >= 0)
+    int dy = 0;
+    std::string code;   // plus petite forme canonique de ses phases (ObjectShape::code)
+    std::string name;   // nom usuel (règle B3/S23), vide si inconnu
+
+    static const char* kindName(Kind kind);
+};
+
+// Classement d'objets par simulation isolée : l'objet est avancé jusqu'à
+// retrouver sa forme (même orientation), au plus maxPeriod générations.
+// Même place : nature morte ou oscillateur ; déplacé : vaisseau ; sinon
+// (disparition, croissance, période plus longue) : Other.
+//
+// Les résultats sont mis en cache par forme, telle que vue puis canonique,
+// avec toutes les phases d'un objet périodique : une forme déjà rencontrée
+// coûte une recherche dans une table. Le cache est vidé au-delà de
+// maxCacheEntries formes. Un classeur par thread (pas de verrou).
+class ObjectClassifier {
+public:
+    explicit ObjectClassifier(const RuleSpec& rule = RuleSpec::conway(),
+                              int maxPeriod = 64,
+                              std::size_t maxCacheEntries = std::size_t(1) << 16);
+
+    // shape : forme normalisée (ObjectShape::fromCells). La référence reste
+    // valide jusqu'au prochain appel.
+    const ObjectClass& classify(const ObjectShape& shape);
+
+    long long cacheHits() const { return m_hits; }
+    long long cacheMisses() const { return m_misses; }
+    std::size_t cacheSize() const { return m_cache.size(); }
+
+private:
+    ObjectClass evolve(const ObjectShape& shape, std::vector<ObjectShape>& phases) const;
+
+    RuleSpec m_rule;
+    int m_maxPeriod;
+    std::size_t m_maxCacheEntries;
+    std::unordered_map<ObjectShape, ObjectClass, ObjectShape::Hash> m_cache;
+    std::unordered_map<std::string, std::string> m_names; // code -> nom usuel
+    long long m_hits = 0;
+    long long m_misses = 0;
+};
@@ -0,0 +1,144 @@
+#include "ObjectShape.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+const int kMaxSide = 65536;
+
+std::uint32_t pack(int r, int c) {
+    return (static_cast<std::uint32_t>(r) << 16) | static_cast<std::uint32_t>(c);
+}
+
+struct CellHash {
+    std::size_t operator()(const ObjectShape::Cell& cell) const {
+        std::uint64_t z = static_cast<std::uint64_t>(cell.first) * 0x9E3779B97F4A7C15ull
+                        ^ static_cast<std::uint64_t>(cell.second);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        return static_cast<std::size_t>(z ^ (z >> 31));
+    }
+};
+
+} // namespace
+
+ObjectShape ObjectShape::fromCells(const std::vector<Cell>& cells, long long* top, long long* left) {
+    if (cells.empty()) {
+        throw std::invalid_argument("Objet vide");
+    }
+    long long r0 = cells[0].first, r1 = r0, c0 = cells[0].second, c1 = c0;
+    for (const Cell& cell : cells) {
+        r0 = std::min(r0, cell.first);
+        r1 = std::max(r1, cell.first);
+        c0 = std::min(c0, cell.second);
+        c1 = std::max(c1, cell.second);
+    }
+    if (r1 - r0 >= kMaxSide || c1 - c0 >= kMaxSide) {
+        throw std::invalid_argument("Objet trop grand");
+    }
+    ObjectShape shape;
+    shape.rows = static_cast<int>(r1 - r0 + 1);
+    shape.cols = static_cast<int>(c1 - c0 + 1);
+    shape.cells.reserve(cells.size());
+    for (const Cell& cell : cells)
+        shape.cells.push_back(pack(static_cast<int>(cell.first - r0), static_cast<int>(cell.second - c0)));
+    std::sort(shape.cells.begin(), shape.cells.end());
+    if (top) *top = r0;
+    if (left) *left = c0;
+    return shape;
+}
+
+ObjectShape ObjectShape::transformed(int t) const {
+    ObjectShape out;
+    const bool swap = t & 1;
+    out.rows = swap ? cols : rows;
+    out.cols = swap ? rows : cols;
+    out.cells.reserve(cells.size());
+    for (std::uint32_t cell : cells) {
+        int r = static_cast<int>(cell >> 16);
+        int c = static_cast<int>(cell & 0xFFFFu);
+        if (swap) std::swap(r, c);
+        if (t & 2) r = out.rows - 1 - r;
+        if (t & 4) c = out.cols - 1 - c;
+        out.cells.push_back(pack(r, c));
+    }
+    std::sort(out.cells.begin(), out.cells.end());
+    return out;
+}
+
+ObjectShape ObjectShape::canonical() const {
+    ObjectShape best = *this;
+    for (int t = 1; t < 8; ++t) {
+        ObjectShape image = transformed(t);
+        if (image < best) best = std::move(image);
+    }
+    return best;
+}
+
+bool ObjectShape::operator<(const ObjectShape& o) const {
+    if (rows != o.rows) return rows < o.rows;
+    if (cols != o.cols) return cols < o.cols;
+    return cells < o.cells;
+}
+
+std::uint64_t ObjectShape::hash() const {
+    std::uint64_t h = static_cast<std::uint64_t>(rows) * 0x9E3779B97F4A7C15ull + cols;
+    for (std::uint32_t cell : cells) {
+        h = (h ^ cell) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+std::string ObjectShape::code() const {
+    static const char kHex[] = "0123456789abcdef";
+    std::string text = std::to_string(rows) + "x" + std::to_string(cols) + ":";
+    const int digits = (cols + 3) / 4;
+    std::vector<int> row(digits);
+    std::size_t i = 0;
+    for (int r = 0; r < rows; ++r) {
+        std::fill(row.begin(), row.end(), 0);
+        for (; i < cells.size() && static_cast<int>(cells[i] >> 16) == r; ++i) {
+            const int c = static_cast<int>(cells[i] & 0xFFFFu);
+            row[c / 4] |= 1 << (c % 4);
+        }
+        // zeros de droite omis
+        int used = digits;
+        while (used > 1 && row[used - 1] == 0) --used;
+        if (r > 0) text += '.';
+        for (int d = 0; d < used; ++d) text += kHex[row[d]];
+    }
+    return text;
+}
+
+void ObjectShape::separate(const std::vector<Cell>& cells,
+                           std::vector<std::vector<Cell>>& objects)
+{
+    objects.clear();
+    std::unordered_map<Cell, int, CellHash> index;
+    index.reserve(cells.size() * 2);
+    for (std::size_t i = 0; i < cells.size(); ++i)
+        index.emplace(cells[i], static_cast<int>(i));
+
+    // parcours en largeur sur le voisinage 5 x 5
+    std::vector<char> seen(cells.size(), 0);
+    std::vector<int> queue;
+    for (std::size_t start = 0; start < cells.size(); ++start) {
+        if (seen[start]) continue;
+        seen[start] = 1;
+        queue.assign(1, static_cast<int>(start));
+        objects.emplace_back();
+        std::vector<Cell>& object = objects.back();
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            const Cell cell = cells[queue[q]];
+            object.push_back(cell);
+            for (int dr = -2; dr <= 2; ++dr)
+                for (int dc = -2; dc <= 2; ++dc) {
+                    auto it = index.find(Cell(cell.first + dr, cell.second + dc));
+                    if (it == index.end() || seen[it->second]) continue;
+                    seen[it->second] = 1;
+                    queue.push_back(it->second);
+                }
+        }
+    }
+}
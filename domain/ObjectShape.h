@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forme d'un objet isolé : ses cellules vivantes ramenées au coin de son
+// rectangle englobant, triées (ligne * 65536 + colonne). Deux objets de
+// même forme au même endroit près ont la même ObjectShape.
+struct ObjectShape {
+    typedef std::pair<long long, long long> Cell; // (ligne, colonne) dans l'univers
+
+    int rows = 0;
+    int cols = 0;
+    std::vector<std::uint32_t> cells;
+
+    // cellules quelconques (non vides, côtés < 65536) ; top/left reçoivent
+    // le coin du rectangle englobant. Lève std::invalid_argument sinon.
+    static ObjectShape fromCells(const std::vector<Cell>& cells,
+                                 long long* top = nullptr, long long* left = nullptr);
+
+    // plus petite des 8 images par rotation et symétrie : deux objets
+    // superposables par une isométrie ont la même forme canonique
+    ObjectShape canonical() const;
+    // image t (0..7) : bit 0 = échange lignes/colonnes, bit 1 = miroir
+    // vertical, bit 2 = miroir horizontal
+    ObjectShape transformed(int t) const;
+
+    // code texte « LxC:r0.r1... », chaque ligne en hexadécimal (chiffre i =
+    // colonnes 4i..4i+3, bit de poids faible à gauche)
+    std::string code() const;
+
+    std::size_t population() const { return cells.size(); }
+    std::uint64_t hash() const;
+
+    bool operator==(const ObjectShape& o) const {
+        return rows == o.rows && cols == o.cols && cells == o.cells;
+    }
+    bool operator!=(const ObjectShape& o) const { return !(*this == o); }
+    bool operator<(const ObjectShape& o) const;
+
+    struct Hash {
+        std::size_t operator()(const ObjectShape& shape) const {
+            return static_cast<std::size_t>(shape.hash());
+        }
+    };
+
+    // Sépare des cellules vivantes en objets : deux cellules à distance de
+    // Tchebychev au plus 2 appartiennent au même objet (au-delà, elles
+    // n'ont aucun voisin commun et n'interagissent pas à la génération
+    // suivante). Chaque objet est une liste de cellules de l'univers.
+    static void separate(const std::vector<Cell>& cells,
+                         std::vector<std::vector<Cell>>& objects);
+};
@@ -0,0 +1,40 @@
+#include "RandomSoup.h"
+#include <stdexcept>
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+Grid RandomSoup::make(int rows, int cols, double density,
+                      std::uint64_t seed, bool toroidal)
+{
+    if (density < 0.0 || density > 1.0) {
+        throw std::invalid_argument("Densite hors de [0, 1]");
+    }
+    Grid grid(rows, cols, toroidal);
+    // seuil sur 32 bits : deux cellules par tirage de 64 bits
+    const std::uint64_t threshold = static_cast<std::uint64_t>(density * 4294967296.0);
+    std::uint64_t state = seed;
+    for (int r = 0; r < rows; ++r) {
+        std::uint64_t* words = grid.rowWords(r);
+        for (int w = 0; w < grid.wordsPerRow(); ++w) {
+            std::uint64_t word = 0;
+            for (int b = 0; b < 64; b += 2) {
+                const std::uint64_t x = splitmix64(state);
+                word |= static_cast<std::uint64_t>((x & 0xFFFFFFFFu) < threshold) << b;
+                word |= static_cast<std::uint64_t>((x >> 32) < threshold) << (b + 1);
+            }
+            words[w] = word;
+        }
+        // bits de bourrage nuls
+        if (grid.wordsPerRow() > 0) words[grid.wordsPerRow() - 1] &= grid.lastWordMask();
+    }
+    return grid;
+}
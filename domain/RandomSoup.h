@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include "Grid.h"
+
+// Soupe aléatoire reproductible : chaque cellule est vivante avec la
+// probabilité density. Le générateur (splitmix64) est défini ici plutôt que
+// par <random> : une graine donne la même grille sur toute plateforme et
+// toute bibliothèque standard.
+class RandomSoup {
+public:
+    static Grid make(int rows, int cols, double density,
+                     std::uint64_t seed, bool toroidal = false);
+};
@@ -0,0 +1,49 @@
+#include "Rule.h"
+#include "AliveState.h"
+#include "DeadState.h"
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// regle dont next() par defaut attend nextState() sur ce thread : y revenir
+// signifie que ni next() ni nextState() ne sont redefinies
+thread_local const Rule* t_defaultNext = nullptr;
+
+struct DefaultNextGuard {
+    explicit DefaultNextGuard(const Rule* rule) : previous(t_defaultNext) {
+        if (previous == rule) {
+            throw std::logic_error("Regle sans calcul : redefinir nextState(), next() ou nextRow()");
+        }
+        t_defaultNext = rule;
+    }
+    ~DefaultNextGuard() { t_defaultNext = previous; }
+
+    const Rule* previous;
+};
+
+} // namespace
+
+CellState* Rule::nextState(const Cell& cell, const Grid& grid) const {
+    return next(cell, grid, grid.countAliveNeighbors(cell.row(), cell.col())).clone();
+}
+
+const CellState& Rule::next(const Cell& cell, const Grid& grid, int) const {
+    // interface historique : l'etat alloue est remplace par son poids-mouche
+    DefaultNextGuard guard(this);
+    std::unique_ptr<CellState> state(nextState(cell, grid));
+    if (state && state->isAlive()) return AliveState::instance();
+    return DeadState::instance();
+}
+
+void Rule::nextRow(const Grid& grid,
+                   int row,
+                   int colBegin,
+                   int colEnd,
+                   const std::uint8_t* neighbours,
+                   std::uint8_t* out) const
+{
+    for (int c = colBegin; c < colEnd; ++c) {
+        out[c - colBegin] = next(grid.at(row, c), grid, neighbours[c - colBegin]).isAlive() ? 1 : 0;
+    }
+}
@@ -1,12 +1,38 @@
 #pragma once
+#include <cstdint>
 #include "Cell.h"
 #include "Grid.h"
 
+// Règle d'évolution. Une règle redéfinit au choix :
+//  - nextRow() : calcul par lot d'une portion de ligne, sans allocation ;
+//  - next()    : état suivant d'une cellule, sous forme d'état partagé
+//                (AliveState::instance(), DeadState::instance()...) ;
+//  - nextState() : interface historique, retourne un NOUVEL état (new).
+// Chaque méthode a une version par défaut fondée sur les autres : il
+// suffit d'en redéfinir une. Une règle qui n'en redéfinit aucune lève
+// std::logic_error au premier calcul au lieu de boucler.
 class Rule {
 public:
     virtual ~Rule() = default;
 
-    // retourne un NOUVEL état (utiliser new)
+    // retourne un NOUVEL état (utiliser new) ; défaut : copie de next()
     virtual CellState* nextState(const Cell& cell,
-                                 const Grid& grid) const = 0;
+                                 const Grid& grid) const;
+
+    // état suivant de cell, qui a neighbours voisins vivants ; l'état
+    // retourné doit survivre à l'appel (poids-mouche). Défaut : nextState(),
+    // dont le résultat est libéré aussitôt.
+    virtual const CellState& next(const Cell& cell,
+                                  const Grid& grid,
+                                  int neighbours) const;
+
+    // cellules [colBegin, colEnd) de la ligne row : neighbours[i] = voisins
+    // vivants de la cellule colBegin + i, écrire 1 (vivante) ou 0 dans
+    // out[i]. Défaut : next() cellule par cellule.
+    virtual void nextRow(const Grid& grid,
+                         int row,
+                         int colBegin,
+                         int colEnd,
+                         const std::uint8_t* neighbours,
+                         std::uint8_t* out) const;
 };
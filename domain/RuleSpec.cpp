@@ -0,0 +1,84 @@
+#include "RuleSpec.h"
+#include <cctype>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// chiffres 0..8 de [pos, end) -> masque ; faux si autre caractere
+bool digitsMask(const std::string& text, std::size_t pos, std::size_t end,
+                std::uint16_t& mask)
+{
+    mask = 0;
+    for (std::size_t i = pos; i < end; ++i) {
+        const char ch = text[i];
+        if (ch < '0' || ch > '8') return false;
+        mask |= static_cast<std::uint16_t>(1u << (ch - '0'));
+    }
+    return true;
+}
+
+// nombre d'etats de [pos, end) : entier 2..255
+bool statesCount(const std::string& text, std::size_t pos, std::size_t end,
+                 std::uint8_t& states)
+{
+    if (pos >= end || end - pos > 3) return false;
+    int value = 0;
+    for (std::size_t i = pos; i < end; ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+        value = value * 10 + (text[i] - '0');
+    }
+    if (value < 2 || value > 255) return false;
+    states = static_cast<std::uint8_t>(value);
+    return true;
+}
+
+} // namespace
+
+RuleSpec RuleSpec::parse(const std::string& text) {
+    const std::string error = "Regle invalide (attendu B.../S... ou B.../S.../C...) : " + text;
+    std::vector<std::size_t> bounds = { 0 };
+    for (std::size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '/') bounds.push_back(i + 1);
+    const std::size_t parts = bounds.size();
+    bounds.push_back(text.size() + 1);
+    if (parts < 2 || parts > 3) throw std::invalid_argument(error);
+
+    RuleSpec spec{ 0, 0 };
+    bool seen[3] = { false, false, false }; // B, S, C
+    bool classic = false;
+    for (std::size_t part = 0; part < parts; ++part) {
+        const std::size_t pos = bounds[part];
+        const std::size_t end = bounds[part + 1] - 1;
+        const char tag = pos < end ? static_cast<char>(std::toupper(
+                                         static_cast<unsigned char>(text[pos]))) : '\0';
+        const int slot = tag == 'B' ? 0 : tag == 'S' ? 1 : tag == 'C' ? 2 : -1;
+        if (slot < 0) {
+            // notation classique : survie / naissance [/ etats], sans lettres
+            if (part == 0) classic = true;
+            if (!classic) throw std::invalid_argument(error);
+            bool ok = part == 2 ? statesCount(text, pos, end, spec.states)
+                                : digitsMask(text, pos, end, part == 0 ? spec.survival : spec.birth);
+            if (!ok) throw std::invalid_argument(error);
+            continue;
+        }
+        if (classic || seen[slot]) throw std::invalid_argument(error);
+        seen[slot] = true;
+        bool ok = slot == 2 ? statesCount(text, pos + 1, end, spec.states)
+                            : digitsMask(text, pos + 1, end, slot == 0 ? spec.birth : spec.survival);
+        if (!ok) throw std::invalid_argument(error);
+    }
+    if (!classic && (!seen[0] || !seen[1])) throw std::invalid_argument(error);
+    return spec;
+}
+
+std::string RuleSpec::toString() const {
+    std::string text = "B";
+    for (int n = 0; n <= 8; ++n)
+        if (birth & (1u << n)) text += static_cast<char>('0' + n);
+    text += "/S";
+    for (int n = 0; n <= 8; ++n)
+        if (survival & (1u << n)) text += static_cast<char>('0' + n);
+    if (states > 2) text += "/C" + std::to_string(states);
+    return text;
+}
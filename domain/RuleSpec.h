@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Règle « Life-like » B/S : bit n de birth (resp. survival) = une cellule
+// morte naît (resp. une cellule vivante survit) avec n voisins vivants.
+// Famille Generations (states > 2) : une cellule vivante qui ne survit pas
+// passe par les états 2..states-1 (mourante, ni voisine vivante ni
+// naissance possible) avant de redevenir morte.
+struct RuleSpec {
+    std::uint16_t birth;
+    std::uint16_t survival;
+    std::uint8_t states = 2;
+
+    static constexpr RuleSpec conway() { return RuleSpec{ 1u << 3, (1u << 2) | (1u << 3) }; }
+
+    // "B36/S23", "b3678/s34678", "S23/B3" ou notation classique "23/3"
+    // (survie/naissance) ; Generations : "B2/S/C3" ou "/2/3"
+    // (survie/naissance/états). Lève std::invalid_argument si mal formée.
+    static RuleSpec parse(const std::string& text);
+    std::string toString() const; // forme canonique "B.../S..." ("/C..." si états > 2)
+
+    bool birthOnZero() const { return birth & 1u; } // B0 : le vide s'allume
+    bool isConway() const { return *this == conway(); }
+    bool isGenerations() const { return states > 2; }
+
+    constexpr bool operator==(const RuleSpec& o) const {
+        return birth == o.birth && survival == o.survival && states == o.states;
+    }
+    constexpr bool operator!=(const RuleSpec& o) const { return !(*this == o); }
+};
@@ -0,0 +1,283 @@
+#include "SparseLife.h"
+#include "LifeWord.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+typedef std::uint64_t u64;
+
+// hash d'un mot de bloc : l'index combine la cle du bloc et la ligne
+inline u64 chunkWordIndex(u64 key, int row) {
+    return key * 64 + static_cast<u64>(row);
+}
+
+} // namespace
+
+std::uint64_t SparseLife::key(long long chunkRow, long long chunkCol) {
+    return (static_cast<u64>(static_cast<std::uint32_t>(chunkRow)) << 32)
+         | static_cast<std::uint32_t>(chunkCol);
+}
+
+long long SparseLife::chunkRowOf(std::uint64_t key) {
+    return static_cast<std::int32_t>(key >> 32);
+}
+
+long long SparseLife::chunkColOf(std::uint64_t key) {
+    return static_cast<std::int32_t>(key & 0xFFFFFFFFu);
+}
+
+long long SparseLife::chunkOf(long long coord) {
+    // division par 64 arrondie vers -infini
+    return coord >= 0 ? coord >> kChunkBits : -((-coord + 63) >> kChunkBits);
+}
+
+SparseLife::SparseLife(const Grid& initial, int maxIterations, int cycleHistory,
+                       const RuleSpec& rule)
+    : m_rule(rule),
+      m_maxIterations(maxIterations),
+      m_currentIteration(0),
+      m_population(0),
+      m_hash(0),
+      m_activeChunks(0),
+      m_cycles(cycleHistory),
+      m_viewValid(false)
+{
+    if (m_rule.birthOnZero() || m_rule.isGenerations()) {
+        throw std::invalid_argument("Le moteur creux ne gere pas les regles B0 ni multi-etats");
+    }
+    for (int r = 0; r < initial.rows(); ++r)
+        for (int c = 0; c < initial.cols(); ++c)
+            if (initial.isAlive(r, c)) setAlive(r, c, true);
+    m_cycles.record(m_hash, m_population, 0);
+}
+
+bool SparseLife::isAlive(long long row, long long col) const {
+    auto it = m_chunks.find(key(chunkOf(row), chunkOf(col)));
+    if (it == m_chunks.end()) return false;
+    return (it->second.rows[row & 63] >> (col & 63)) & 1u;
+}
+
+void SparseLife::setAlive(long long row, long long col, bool alive) {
+    const u64 k = key(chunkOf(row), chunkOf(col));
+    auto it = m_chunks.find(k);
+    if (it == m_chunks.end()) {
+        if (!alive) return;
+        it = m_chunks.emplace(k, Chunk{}).first;
+    }
+    u64& word = it->second.rows[row & 63];
+    const u64 before = word;
+    const u64 bit = u64(1) << (col & 63);
+    word = alive ? (word | bit) : (word & ~bit);
+    if (word == before) return;
+
+    m_population += alive ? 1 : -1;
+    m_hash += wordHash(chunkWordIndex(k, static_cast<int>(row & 63)), word)
+            - wordHash(chunkWordIndex(k, static_cast<int>(row & 63)), before);
+
+    bool empty = true;
+    for (u64 w : it->second.rows)
+        if (w) { empty = false; break; }
+    if (empty) m_chunks.erase(it);
+    m_viewValid = false;
+}
+
+// un bloc et ses 8 voisins -> bloc suivant ; retourne le OU de ses lignes
+template <class R>
+std::uint64_t SparseLife::stepChunk(const RuleSpec& rule, const Chunk* const around[3][3],
+                                    Chunk& next)
+{
+    u64 any = 0;
+    for (int i = 0; i < 64; ++i) {
+        // lignes i-1, i, i+1 avec leurs voisins ouest et est
+        u64 line[3][3];
+        for (int k3 = 0; k3 < 3; ++k3) {
+            const int ri = i + k3 - 1;
+            const int dr = ri < 0 ? 0 : (ri > 63 ? 2 : 1);
+            const int local = ri & 63;
+            const u64 west = around[dr][0]->rows[local];
+            const u64 mid = around[dr][1]->rows[local];
+            const u64 east = around[dr][2]->rows[local];
+            line[k3][0] = (mid << 1) | (west >> 63);
+            line[k3][1] = mid;
+            line[k3][2] = (mid >> 1) | (east << 63);
+        }
+        R::template word<u64>(rule,
+                              line[0][0], line[0][1], line[0][2],
+                              line[1][0], line[1][1], line[1][2],
+                              line[2][0], line[2][1], line[2][2], next.rows[i]);
+        any |= next.rows[i];
+    }
+    return any;
+}
+
+void SparseLife::step() {
+    // blocs a calculer : blocs vivants et ceux de leurs 8 voisins touches
+    // par une cellule vivante du bord (sans B0, rien ne nait ailleurs)
+    m_candidates.clear();
+    for (const auto& entry : m_chunks) {
+        const long long cr = chunkRowOf(entry.first);
+        const long long cc = chunkColOf(entry.first);
+        const u64* rows = entry.second.rows;
+        u64 columns = 0;
+        for (int i = 0; i < 64; ++i) columns |= rows[i];
+        // bit 0 : colonne 0, bit 1 : colonnes 0..63, bit 2 : colonne 63
+        const unsigned edge[3] = {
+            static_cast<unsigned>((rows[0] & 1u) | (rows[0] != 0) << 1 | (rows[0] >> 63) << 2),
+            static_cast<unsigned>((columns & 1u) | 2u | (columns >> 63) << 2),
+            static_cast<unsigned>((rows[63] & 1u) | (rows[63] != 0) << 1 | (rows[63] >> 63) << 2),
+        };
+        for (int dr = -1; dr <= 1; ++dr)
+            for (int dc = -1; dc <= 1; ++dc)
+                if ((edge[dr + 1] >> (dc + 1)) & 1u)
+                    m_candidates.push_back(key(cr + dr, cc + dc));
+    }
+    std::sort(m_candidates.begin(), m_candidates.end());
+    m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()),
+                       m_candidates.end());
+
+    static const Chunk empty = {};
+    StepStats stats;
+    BoundingBox region;
+    m_next.clear();
+    for (u64 k : m_candidates) {
+        const long long cr = chunkRowOf(k);
+        const long long cc = chunkColOf(k);
+        const Chunk* around[3][3];
+        for (int dr = 0; dr < 3; ++dr)
+            for (int dc = 0; dc < 3; ++dc) {
+                auto it = m_chunks.find(key(cr + dr - 1, cc + dc - 1));
+                around[dr][dc] = it == m_chunks.end() ? &empty : &it->second;
+            }
+
+        Chunk next;
+        // regle choisie par bloc : B3/S23 garde l'expression simplifiee
+        const u64 any = m_rule.isConway()
+            ? stepChunk<ConwayLifeRule>(m_rule, around, next)
+            : stepChunk<RuntimeLifeRule>(m_rule, around, next);
+
+        const Chunk& before = *around[1][1];
+        const long long changedBefore = stats.changed();
+        for (int i = 0; i < 64; ++i)
+            accumulateRow(stats, &before.rows[i], &next.rows[i], 1, chunkWordIndex(k, i));
+        if (stats.changed() != changedBefore) {
+            const long long top = cr * 64, left = cc * 64;
+            if (region.empty()) {
+                region.top = top;
+                region.left = left;
+                region.bottom = top + 63;
+                region.right = left + 63;
+            }
+            else {
+                region.top = std::min(region.top, top);
+                region.left = std::min(region.left, left);
+                region.bottom = std::max(region.bottom, top + 63);
+                region.right = std::max(region.right, left + 63);
+            }
+        }
+        // un bloc devenu vide n'est pas conserve
+        if (any) m_next.emplace(k, next);
+    }
+
+    m_chunks.swap(m_next);
+    m_activeChunks = static_cast<long long>(m_candidates.size());
+    m_activeRegion = region;
+    ++m_currentIteration;
+
+    m_lastStats = stats;
+    m_population += stats.births - stats.deaths;
+    m_hash += stats.hashDelta;
+    m_cycles.record(m_hash, m_population, m_currentIteration);
+    m_viewValid = false;
+}
+
+bool SparseLife::hasFinished() const {
+    if (m_currentIteration == 0) return false; // aucune etape effectuee
+    return isStable() || m_currentIteration >= m_maxIterations;
+}
+
+BoundingBox SparseLife::boundingBox() const {
+    BoundingBox box;
+    bool first = true;
+    for (const auto& entry : m_chunks) {
+        const long long top = chunkRowOf(entry.first) * 64;
+        const long long left = chunkColOf(entry.first) * 64;
+        u64 columns = 0;
+        int minRow = 64, maxRow = -1;
+        for (int i = 0; i < 64; ++i) {
+            if (!entry.second.rows[i]) continue;
+            columns |= entry.second.rows[i];
+            minRow = std::min(minRow, i);
+            maxRow = i;
+        }
+        if (!columns) continue;
+        const long long t = top + minRow;
+        const long long b = top + maxRow;
+        const long long l = left + __builtin_ctzll(columns);
+        const long long r = left + 63 - __builtin_clzll(columns);
+        if (first) {
+            box.top = t; box.bottom = b; box.left = l; box.right = r;
+            first = false;
+        } else {
+            box.top = std::min(box.top, t);
+            box.bottom = std::max(box.bottom, b);
+            box.left = std::min(box.left, l);
+            box.right = std::max(box.right, r);
+        }
+    }
+    return box;
+}
+
+void SparseLife::liveCells(std::vector<std::pair<long long, long long>>& out) const {
+    out.clear();
+    for (const auto& entry : m_chunks) {
+        const long long chunkTop = chunkRowOf(entry.first) * 64;
+        const long long chunkLeft = chunkColOf(entry.first) * 64;
+        for (int i = 0; i < 64; ++i)
+            for (u64 w = entry.second.rows[i]; w; w &= w - 1)
+                out.emplace_back(chunkTop + i, chunkLeft + __builtin_ctzll(w));
+    }
+}
+
+Grid SparseLife::window(long long top, long long left, int rows, int cols) const {
+    Grid grid(rows, cols, false);
+    for (const auto& entry : m_chunks) {
+        const long long chunkTop = chunkRowOf(entry.first) * 64;
+        const long long chunkLeft = chunkColOf(entry.first) * 64;
+        if (chunkTop + 63 < top || chunkTop >= top + rows) continue;
+        if (chunkLeft + 63 < left || chunkLeft >= left + cols) continue;
+        for (int i = 0; i < 64; ++i) {
+            const long long r = chunkTop + i - top;
+            if (r < 0 || r >= rows) continue;
+            // parcours des seuls bits vivants
+            for (u64 w = entry.second.rows[i]; w; w &= w - 1) {
+                const long long c = chunkLeft + __builtin_ctzll(w) - left;
+                if (c >= 0 && c < cols)
+                    grid.setAlive(static_cast<int>(r), static_cast<int>(c), true);
+            }
+        }
+    }
+    return grid;
+}
+
+void SparseLife::setView(long long top, long long left, int rows, int cols) {
+    m_viewBox = BoundingBox();
+    if (rows > 0 && cols > 0) {
+        m_viewBox.top = top;
+        m_viewBox.left = left;
+        m_viewBox.bottom = top + rows - 1;
+        m_viewBox.right = left + cols - 1;
+    }
+    m_viewValid = false;
+}
+
+const Grid& SparseLife::currentGrid() const {
+    if (!m_viewValid) {
+        BoundingBox box = m_viewBox.empty() ? boundingBox() : m_viewBox;
+        checkViewSize(box);
+        m_view = window(box.top, box.left,
+                        static_cast<int>(box.rows()), static_cast<int>(box.cols()));
+        m_viewValid = true;
+    }
+    return m_view;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "BoundingBox.h"
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "LifeEngine.h"
+#include "RuleSpec.h"
+#include "StepStats.h"
+
+// Univers non borné et creux (règle B/S sans B0) : seuls les blocs de 64x64 cellules
+// contenant au moins une cellule vivante sont stockés, dans une table de
+// hachage indexée par leurs coordonnées. L'univers grandit et rétrécit avec
+// le motif : mémoire et coût d'un pas suivent la population, pas la surface.
+class SparseLife : public LifeEngine {
+public:
+    // la cellule (r, c) de initial est placée en (r, c) dans l'univers ;
+    // le mode torique de initial est ignoré. Lève std::invalid_argument pour
+    // une règle B0 (le vide infini s'allumerait) ou multi-états.
+    SparseLife(const Grid& initial, int maxIterations, int cycleHistory = 64,
+               const RuleSpec& rule = RuleSpec::conway());
+
+    void step() override;
+    bool isStable() const override { return m_lastStats.changed() == 0; }
+    bool hasFinished() const override;
+    int currentIteration() const override { return m_currentIteration; }
+    int detectedPeriod() const override { return m_cycles.period(); }
+    long long population() const override { return m_population; }
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+
+    // vue dense de la fenêtre définie par setView(), ou à défaut du
+    // rectangle englobant (recalculée à la demande)
+    const Grid& currentGrid() const override;
+    void setView(long long top, long long left, int rows, int cols);
+
+    // blocs calculés au dernier pas / blocs vivants stockés
+    long long activeTiles() const override { return m_activeChunks; }
+    long long tileCount() const override { return static_cast<long long>(m_chunks.size()); }
+    // blocs modifiés au dernier pas
+    BoundingBox activeRegion() const override { return m_activeRegion; }
+
+    bool isAlive(long long row, long long col) const;
+    void setAlive(long long row, long long col, bool alive);
+
+    BoundingBox boundingBox() const;
+    // cellules vivantes (ligne, colonne), dans un ordre quelconque
+    void liveCells(std::vector<std::pair<long long, long long>>& out) const;
+    // extrait une fenêtre quelconque de l'univers en grille dense bornée
+    Grid window(long long top, long long left, int rows, int cols) const;
+
+private:
+    static const int kChunkBits = 6; // blocs de 64 x 64
+
+    struct Chunk {
+        std::uint64_t rows[64];
+    };
+
+    struct KeyHash {
+        std::size_t operator()(std::uint64_t key) const {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            return static_cast<std::size_t>(key ^ (key >> 33));
+        }
+    };
+    typedef std::unordered_map<std::uint64_t, Chunk, KeyHash> ChunkMap;
+
+    static std::uint64_t key(long long chunkRow, long long chunkCol);
+    static long long chunkRowOf(std::uint64_t key);
+    static long long chunkColOf(std::uint64_t key);
+    static long long chunkOf(long long coord);
+
+    template <class R>
+    static std::uint64_t stepChunk(const RuleSpec& rule, const Chunk* const around[3][3],
+                                   Chunk& next);
+
+    RuleSpec m_rule;
+    ChunkMap m_chunks;
+    ChunkMap m_next;                       // réutilisée à chaque pas
+    std::vector<std::uint64_t> m_candidates;
+
+    int m_maxIterations;
+    int m_currentIteration;
+    StepStats m_lastStats;
+    long long m_population;
+    std::uint64_t m_hash;
+    long long m_activeChunks;
+    BoundingBox m_activeRegion;
+    CycleDetector m_cycles;
+
+    BoundingBox m_viewBox;     // fenêtre fixe (vide = rectangle englobant)
+    mutable Grid m_view;       // cache de currentGrid()
+    mutable bool m_viewValid;
+};
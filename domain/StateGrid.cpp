@@ -0,0 +1,58 @@
+#include "StateGrid.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+StateGrid::StateGrid(int rows, int cols, bool toroidal)
+    : m_rows(rows),
+      m_cols(cols),
+      m_toroidal(toroidal)
+{
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("Dimensions de grille invalides");
+    }
+    m_cells.assign(static_cast<std::size_t>(rows) * cols, 0);
+}
+
+StateGrid::StateGrid(const Grid& grid)
+    : StateGrid(grid.rows(), grid.cols(), grid.toroidal())
+{
+    for (int r = 0; r < m_rows; ++r)
+        for (int c = 0; c < m_cols; ++c)
+            if (grid.isAlive(r, c)) setState(r, c, 1);
+}
+
+void StateGrid::swap(StateGrid& other) noexcept {
+    std::swap(m_rows, other.m_rows);
+    std::swap(m_cols, other.m_cols);
+    std::swap(m_toroidal, other.m_toroidal);
+    m_cells.swap(other.m_cells);
+}
+
+bool StateGrid::equals(const StateGrid& other) const {
+    return m_rows == other.m_rows && m_cols == other.m_cols && m_cells == other.m_cells;
+}
+
+long long StateGrid::count(std::uint8_t state) const {
+    return std::count(m_cells.begin(), m_cells.end(), state);
+}
+
+std::uint8_t StateGrid::maxState() const {
+    return m_cells.empty() ? 0 : *std::max_element(m_cells.begin(), m_cells.end());
+}
+
+void StateGrid::aliveInto(Grid& grid) const {
+    if (grid.rows() != m_rows || grid.cols() != m_cols) grid = Grid(m_rows, m_cols, m_toroidal);
+    for (int r = 0; r < m_rows; ++r) {
+        const std::uint8_t* cells = row(r);
+        std::uint64_t* words = grid.rowWords(r);
+        for (int w = 0; w < grid.wordsPerRow(); ++w) {
+            std::uint64_t word = 0;
+            const int first = w * 64;
+            const int last = std::min(first + 64, m_cols);
+            for (int c = first; c < last; ++c)
+                word |= static_cast<std::uint64_t>(cells[c] == 1) << (c - first);
+            words[w] = word;
+        }
+    }
+}
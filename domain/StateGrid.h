@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+
+// Grille multi-états (règles Generations) : un octet par cellule, lignes
+// contiguës. 0 = morte, 1 = vivante, 2..states-1 = mourante (réfractaire).
+class StateGrid {
+private:
+    int m_rows;
+    int m_cols;
+    bool m_toroidal;
+    std::vector<std::uint8_t> m_cells;
+
+public:
+    StateGrid(int rows = 0, int cols = 0, bool toroidal = false);
+    // vivantes de grid -> état 1
+    explicit StateGrid(const Grid& grid);
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    bool toroidal() const { return m_toroidal; }
+
+    std::uint8_t state(int r, int c) const { return row(r)[c]; }
+    void setState(int r, int c, std::uint8_t state) { row(r)[c] = state; }
+
+    std::uint8_t* row(int r) {
+        return m_cells.data() + static_cast<std::size_t>(r) * m_cols;
+    }
+    const std::uint8_t* row(int r) const {
+        return m_cells.data() + static_cast<std::size_t>(r) * m_cols;
+    }
+
+    void swap(StateGrid& other) noexcept;
+    bool equals(const StateGrid& other) const;
+    long long count(std::uint8_t state) const;
+    std::uint8_t maxState() const;
+
+    // cellules vivantes (état 1) en grille à deux états
+    void aliveInto(Grid& grid) const;
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// Moteur de calcul d'une génération :
+//  - PerCellRule : appelle Rule::nextRow() par portion de ligne (voisins
+//                  pré-comptés, aucune allocation)
+//  - Bitwise     : noyau LifeKernel (64 cellules par mot), utilisé
+//                  uniquement si la règle est exactement LifeRule ou
+//                  ConwayRule (noyau choisi une fois selon ses masques B/S)
+enum class StepKernel { PerCellRule, Bitwise };
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// Bilan d'une génération, calculé au passage par le pas de simulation.
+struct StepStats {
+    long long births = 0;
+    long long deaths = 0;
+    std::uint64_t hashDelta = 0; // variation de l'empreinte de la grille
+
+    long long changed() const { return births + deaths; }
+
+    StepStats& operator+=(const StepStats& other) {
+        births += other.births;
+        deaths += other.deaths;
+        hashDelta += other.hashDelta;
+        return *this;
+    }
+};
+
+// Empreinte d'un mot de grille à sa position ; l'empreinte d'une grille
+// est la somme (modulo 2^64) de celles de ses mots, ce qui permet de la
+// mettre à jour à partir des seuls mots modifiés. Un mot nul vaut 0.
+inline std::uint64_t wordHash(std::uint64_t index, std::uint64_t word) {
+    if (word == 0) return 0;
+    std::uint64_t z = word ^ (index * 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ajoute à stats l'écart entre deux versions d'une ligne de words mots
+inline void accumulateRow(StepStats& stats,
+                          const std::uint64_t* before,
+                          const std::uint64_t* after,
+                          int words,
+                          std::uint64_t firstIndex)
+{
+    for (int w = 0; w < words; ++w) {
+        std::uint64_t diff = before[w] ^ after[w];
+        if (!diff) continue;
+        stats.births += __builtin_popcountll(diff & after[w]);
+        stats.deaths += __builtin_popcountll(diff & before[w]);
+        stats.hashDelta += wordHash(firstIndex + w, after[w])
+                         - wordHash(firstIndex + w, before[w]);
+    }
+}
@@ -0,0 +1,28 @@
+#include "TileStore.h"
+
+Grid TileStore::window(long long top, long long left, int rows, int cols) const {
+    const int allRows = this->rows();
+    const int words = tileCols();
+    const bool whole = top == 0 && left == 0 && rows == allRows && cols == this->cols();
+    Grid out(rows, cols, whole && toroidal());
+    auto source = [&](long long row, long long word) -> std::uint64_t {
+        if (word < 0 || word >= words) return 0;
+        return tile(static_cast<int>(row / kTileSide), static_cast<int>(word))[row % kTileSide];
+    };
+    for (int r = 0; r < rows; ++r) {
+        const long long row = top + r;
+        if (row < 0 || row >= allRows) continue;
+        std::uint64_t* dst = out.rowWords(r);
+        for (int w = 0; w < out.wordsPerRow(); ++w) {
+            const long long col = left + 64LL * w;
+            // mot source contenant col (division entiere vers -infini)
+            const long long word = col >= 0 ? col / 64 : -((63 - col) / 64);
+            const int shift = static_cast<int>(col - word * 64);
+            std::uint64_t bits = source(row, word) >> shift;
+            if (shift) bits |= source(row, word + 1) << (64 - shift);
+            dst[w] = bits;
+        }
+        if (out.wordsPerRow() > 0) dst[out.wordsPerRow() - 1] &= out.lastWordMask();
+    }
+    return out;
+}
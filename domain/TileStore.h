@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include "Grid.h"
+#include "RuleSpec.h"
+
+// Port du domaine : grille de TiledLife gardée hors du moteur, découpée en
+// tuiles de 64 x 64 cellules. Une tuile occupe 64 mots de 64 bits (une
+// ligne par mot, bit i = colonne 64*tc + i). Le stockage porte aussi la
+// règle et le bilan du dernier pas terminé : génération, population et
+// empreinte (au sens de Grid::hash()). Voir TiledGridFile
+// (infrastructure) pour la version en fichier projeté en mémoire.
+class TileStore {
+public:
+    static const int kTileSide = 64;
+
+    virtual ~TileStore() = default;
+
+    virtual int rows() const = 0;
+    virtual int cols() const = 0;
+    virtual bool toroidal() const = 0;
+    int tileRows() const { return (rows() + kTileSide - 1) / kTileSide; }
+    int tileCols() const { return (cols() + kTileSide - 1) / kTileSide; } // = mots par ligne
+    virtual RuleSpec rule() const = 0;
+
+    virtual long long generation() const = 0;
+    virtual long long population() const = 0;
+    virtual std::uint64_t hash() const = 0;
+
+    // tuile (tileRow, tileCol) : 64 mots, lignes au-delà de rows() nulles
+    virtual std::uint64_t* tile(int tileRow, int tileCol) = 0;
+    virtual const std::uint64_t* tile(int tileRow, int tileCol) const = 0;
+
+    // copie des cellules vivantes de pattern à partir de (top, left),
+    // population et empreinte comprises ; std::invalid_argument si le
+    // motif déborde
+    virtual void place(const Grid& pattern, int top, int left) = 0;
+    // fenêtre quelconque en grille dense (hors grille = mort) ; la grille
+    // entière garde le mode torique du stockage
+    Grid window(long long top, long long left, int rows, int cols) const;
+
+    // génération en cours de réécriture : un stockage abandonné entre les
+    // deux appels n'est plus utilisable
+    virtual void beginStep() = 0;
+    virtual void endStep(long long generation, long long population, std::uint64_t hash) = 0;
+
+    // rangée de tuiles terminée pour ce pas (sa mémoire peut être rendue)
+    virtual void release(int tileRow) const = 0;
+    virtual void flush() = 0; // rend durables les tuiles modifiées
+};
@@ -0,0 +1,222 @@
+#include "TiledLife.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+const int kSide = TileStore::kTileSide;
+}
+
+TiledLife::TiledLife(std::unique_ptr<TileStore> store, int maxIterations, int cycleHistory)
+    : m_store(std::move(store)),
+      m_maxIterations(maxIterations),
+      m_cycles(cycleHistory)
+{
+    if (!m_store) {
+        throw std::invalid_argument("Le moteur en fichier demande un stockage de tuiles");
+    }
+    m_currentIteration = static_cast<int>(m_store->generation());
+    m_population = m_store->population();
+    m_hash = m_store->hash();
+    const RuleSpec rule = m_store->rule();
+    if (rule.isGenerations()) {
+        throw std::invalid_argument("Regle multi-etats : utiliser GenerationsLife");
+    }
+    m_rowKernel = LifeKernel::RowKernel(rule);
+
+    const std::size_t words = static_cast<std::size_t>(m_store->tileCols());
+    const std::size_t tiles = static_cast<std::size_t>(m_store->tileRows()) * words;
+    // l'etat du pas precedent n'est pas connu : tout est a calculer
+    m_dirty.assign(tiles, 1);
+    m_nextDirty.assign(tiles, 0);
+    m_current.resize(kSide * words);
+    m_above.resize(words);
+    m_below.resize(words);
+    m_needed.resize(words);
+    m_loaded.resize(words);
+    m_firstBand.words.resize(kSide * words);
+    for (Band& band : m_bands) band.words.resize(kSide * words);
+
+    m_cycles.record(m_hash, m_population, m_currentIteration);
+}
+
+// Meme critere que GameOfLife : une tuile dont ni elle ni ses voisines
+// n'ont change au pas precedent vaut deja sa generation suivante.
+bool TiledLife::tileNeedsStep(int tileRow, int tileCol) const {
+    const int tileRows = m_store->tileRows();
+    const int tileCols = m_store->tileCols();
+    const bool wrap = m_store->toroidal();
+    for (int dr = -1; dr <= 1; ++dr) {
+        int tr = tileRow + dr;
+        if (wrap) tr = (tr + tileRows) % tileRows;
+        if (tr < 0 || tr >= tileRows) continue;
+        for (int dc = -1; dc <= 1; ++dc) {
+            int tc = tileCol + dc;
+            if (wrap) tc = (tc + tileCols) % tileCols;
+            if (tc < 0 || tc >= tileCols) continue;
+            if (m_dirty[static_cast<std::size_t>(tr) * tileCols + tc]) return true;
+        }
+    }
+    return false;
+}
+
+// Calcule la rangee tileRow dans out sans toucher au stockage : les tuiles
+// a calculer et leurs voisines gauche/droite sont copiees en lignes, avec
+// la ligne de bord des rangees voisines (encore a la generation courante).
+void TiledLife::stepBand(int tileRow, Band& out, StepStats& stats) {
+    const int tileRows = m_store->tileRows();
+    const int words = m_store->tileCols();
+    const bool wrap = m_store->toroidal();
+    std::uint8_t* nextDirty = &m_nextDirty[static_cast<std::size_t>(tileRow) * words];
+    out.tileRow = tileRow;
+    out.changedTiles.clear();
+
+    bool any = false;
+    for (int c = 0; c < words; ++c) {
+        m_needed[c] = tileNeedsStep(tileRow, c) ? 1 : 0;
+        any = any || m_needed[c];
+        nextDirty[c] = 0;
+    }
+    if (!any) return;
+
+    std::fill(m_loaded.begin(), m_loaded.end(), 0);
+    for (int c = 0; c < words; ++c) {
+        if (!m_needed[c]) continue;
+        m_loaded[c] = 1;
+        if (c > 0 || wrap) m_loaded[(c + words - 1) % words] = 1;
+        if (c + 1 < words || wrap) m_loaded[(c + 1) % words] = 1;
+    }
+    const int bandRows = std::min(kSide, m_store->rows() - tileRow * kSide);
+    const int upTile = tileRow > 0 ? tileRow - 1 : (wrap ? tileRows - 1 : -1);
+    const int upRow = tileRow > 0 ? kSide - 1 : (m_store->rows() - 1) % kSide;
+    const int downTile = tileRow + 1 < tileRows ? tileRow + 1 : (wrap ? 0 : -1);
+    for (int c = 0; c < words; ++c) {
+        if (!m_loaded[c]) continue;
+        const std::uint64_t* tile = m_store->tile(tileRow, c);
+        for (int r = 0; r < bandRows; ++r) m_current[static_cast<std::size_t>(r) * words + c] = tile[r];
+        if (upTile >= 0) m_above[c] = m_store->tile(upTile, c)[upRow];
+        if (downTile >= 0) m_below[c] = m_store->tile(downTile, c)[0];
+    }
+    const std::uint64_t* above = upTile >= 0 ? m_above.data() : nullptr;
+    const std::uint64_t* below = downTile >= 0 ? m_below.data() : nullptr;
+
+    // suites de tuiles a calculer
+    auto row = [&](std::vector<std::uint64_t>& v, int r) {
+        return v.data() + static_cast<std::size_t>(r) * words;
+    };
+    for (int begin = 0; begin < words;) {
+        if (!m_needed[begin]) {
+            ++begin;
+            continue;
+        }
+        int end = begin;
+        while (end < words && m_needed[end]) ++end;
+        for (int r = 0; r < bandRows; ++r) {
+            const std::uint64_t* up = r > 0 ? row(m_current, r - 1) : above;
+            const std::uint64_t* down = r + 1 < bandRows ? row(m_current, r + 1) : below;
+            LifeKernel::stepRowWords(up, row(m_current, r), down, row(out.words, r),
+                                     m_store->cols(), wrap, begin, end, m_rowKernel);
+        }
+        begin = end;
+    }
+
+    for (int c = 0; c < words; ++c) {
+        if (!m_needed[c]) continue;
+        ++m_activeTiles;
+        StepStats tile;
+        for (int r = 0; r < bandRows; ++r) {
+            const std::size_t at = static_cast<std::size_t>(r) * words + c;
+            accumulateRow(tile, &m_current[at], &out.words[at], 1,
+                          static_cast<std::uint64_t>(tileRow * kSide + r) * words + c);
+        }
+        if (tile.changed() == 0) continue;
+        stats += tile;
+        nextDirty[c] = 1;
+        out.changedTiles.push_back(c);
+        m_activeRegion.top = std::min(m_activeRegion.top, static_cast<long long>(tileRow));
+        m_activeRegion.bottom = std::max(m_activeRegion.bottom, static_cast<long long>(tileRow));
+        m_activeRegion.left = std::min(m_activeRegion.left, static_cast<long long>(c));
+        m_activeRegion.right = std::max(m_activeRegion.right, static_cast<long long>(c));
+    }
+}
+
+void TiledLife::writeBand(Band& band) {
+    if (band.tileRow < 0) return;
+    const int words = m_store->tileCols();
+    const int bandRows = std::min(kSide, m_store->rows() - band.tileRow * kSide);
+    for (int c : band.changedTiles) {
+        std::uint64_t* tile = m_store->tile(band.tileRow, c);
+        for (int r = 0; r < bandRows; ++r) tile[r] = band.words[static_cast<std::size_t>(r) * words + c];
+    }
+    // rangee terminee : ses pages peuvent quitter la memoire
+    m_store->release(band.tileRow);
+    band.tileRow = -1;
+}
+
+void TiledLife::step() {
+    // la rangee n est ecrite apres le calcul de n + 1 (qui lit son
+    // ancienne derniere ligne) ; la premiere en dernier (repli torique)
+    const int tileRows = m_store->tileRows();
+    m_store->beginStep();
+    StepStats stats;
+    m_activeTiles = 0;
+    m_activeRegion.top = m_activeRegion.left = tileRows + m_store->tileCols();
+    m_activeRegion.bottom = m_activeRegion.right = -1;
+    for (int t = 0; t < tileRows; ++t) {
+        stepBand(t, t == 0 ? m_firstBand : m_bands[t & 1], stats);
+        if (t >= 2) writeBand(m_bands[(t - 1) & 1]);
+    }
+    if (tileRows >= 2) writeBand(m_bands[(tileRows - 1) & 1]);
+    writeBand(m_firstBand);
+    m_dirty.swap(m_nextDirty);
+
+    // zone active en cellules
+    if (m_activeRegion.bottom < 0) {
+        m_activeRegion = BoundingBox();
+    } else {
+        m_activeRegion.top *= kSide;
+        m_activeRegion.left *= kSide;
+        m_activeRegion.bottom = std::min<long long>((m_activeRegion.bottom + 1) * kSide, m_store->rows()) - 1;
+        m_activeRegion.right = std::min<long long>((m_activeRegion.right + 1) * kSide, m_store->cols()) - 1;
+    }
+
+    ++m_currentIteration;
+    m_stepped = true;
+    m_lastStats = stats;
+    m_population += stats.births - stats.deaths;
+    m_hash += stats.hashDelta;
+    m_store->endStep(m_currentIteration, m_population, m_hash);
+    m_cycles.record(m_hash, m_population, m_currentIteration);
+    m_viewValid = false;
+}
+
+bool TiledLife::hasFinished() const {
+    if (!m_stepped) return false; // aucune etape effectuee
+    return isStable() || m_currentIteration >= m_maxIterations;
+}
+
+void TiledLife::setView(long long top, long long left, int rows, int cols) {
+    m_viewBox = BoundingBox();
+    if (rows > 0 && cols > 0) {
+        m_viewBox.top = top;
+        m_viewBox.left = left;
+        m_viewBox.bottom = top + rows - 1;
+        m_viewBox.right = left + cols - 1;
+    }
+    m_viewValid = false;
+}
+
+const Grid& TiledLife::currentGrid() const {
+    if (!m_viewValid) {
+        BoundingBox box = m_viewBox;
+        if (box.empty()) {
+            box.top = box.left = 0;
+            box.bottom = m_store->rows() - 1;
+            box.right = m_store->cols() - 1;
+        }
+        checkViewSize(box);
+        m_view = m_store->window(box.top, box.left,
+                               static_cast<int>(box.rows()), static_cast<int>(box.cols()));
+        m_viewValid = true;
+    }
+    return m_view;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BoundingBox.h"
+#include "CycleDetector.h"
+#include "Grid.h"
+#include "LifeEngine.h"
+#include "LifeKernel.h"
+#include "StepStats.h"
+#include "TileStore.h"
+
+// Moteur hors mémoire : la grille vit dans un TileStore (en pratique un
+// fichier projeté en mémoire, TiledGridFile) et chaque pas la réécrit en
+// place, rangée de tuiles par rangée de tuiles (front d'onde). Seules une rangée en calcul, la ligne de bord de ses voisines et
+// les résultats de deux rangées en attente d'écriture sont en mémoire : la
+// rangée n n'est réécrite qu'après le calcul de n + 1, qui lit encore son
+// ancienne dernière ligne, et la première rangée qu'en fin de pas (repli
+// torique de la dernière).
+//
+// Comme GameOfLife, seules les tuiles dont le voisinage a changé au pas
+// précédent sont recalculées, et seules les tuiles modifiées sont écrites :
+// les régions stables du stockage ne sont ni relues ni réécrites.
+class TiledLife : public LifeEngine {
+public:
+    // stockage existant, repris à sa génération avec sa règle (l'historique
+    // des cycles repart de cette génération) ; maxIterations compte depuis
+    // sa génération 0. Lève std::invalid_argument sans stockage ou pour une
+    // règle multi-états.
+    TiledLife(std::unique_ptr<TileStore> store, int maxIterations, int cycleHistory = 64);
+
+    void step() override;
+    bool isStable() const override { return m_stepped && m_lastStats.changed() == 0; }
+    bool hasFinished() const override;
+    int currentIteration() const override { return m_currentIteration; }
+    int detectedPeriod() const override { return m_cycles.period(); }
+    long long population() const override { return m_population; }
+    const StepStats& lastStepStats() const override { return m_lastStats; }
+
+    // fenêtre définie par setView(), ou à défaut la grille entière (lue à
+    // la demande dans le stockage)
+    const Grid& currentGrid() const override;
+    void setView(long long top, long long left, int rows, int cols);
+
+    // tuiles recalculées au dernier pas / tuiles du stockage
+    long long activeTiles() const override { return m_activeTiles; }
+    long long tileCount() const override {
+        return static_cast<long long>(m_store->tileRows()) * m_store->tileCols();
+    }
+    BoundingBox activeRegion() const override { return m_activeRegion; }
+
+    const TileStore& store() const { return *m_store; }
+    void flush() { m_store->flush(); }
+
+private:
+    // résultat d'une rangée de tuiles, en lignes de tileCols() mots
+    struct Band {
+        int tileRow = -1;
+        std::vector<std::uint64_t> words;
+        std::vector<int> changedTiles; // colonnes de tuiles à écrire
+    };
+
+    bool tileNeedsStep(int tileRow, int tileCol) const;
+    void stepBand(int tileRow, Band& out, StepStats& stats);
+    void writeBand(Band& band);
+
+    std::unique_ptr<TileStore> m_store;
+    int m_maxIterations;
+    int m_currentIteration = 0;
+    bool m_stepped = false; // au moins un pas depuis l'ouverture
+    LifeKernel::RowKernel m_rowKernel;
+
+    // tuiles modifiées au dernier pas (toutes à l'ouverture)
+    std::vector<std::uint8_t> m_dirty;
+    std::vector<std::uint8_t> m_nextDirty;
+    // fenêtre de calcul : une rangée de tuiles et ses deux lignes de bord
+    std::vector<std::uint64_t> m_current;
+    std::vector<std::uint64_t> m_above;
+    std::vector<std::uint64_t> m_below;
+    std::vector<std::uint8_t> m_needed;
+    std::vector<std::uint8_t> m_loaded;
+    Band m_firstBand;
+    Band m_bands[2];
+
+    StepStats m_lastStats;
+    long long m_population = 0;
+    std::uint64_t m_hash = 0;
+    long long m_activeTiles = 0;
+    BoundingBox m_activeRegion;
+    CycleDetector m_cycles;
+
+    BoundingBox m_viewBox;
+    mutable Grid m_view;
+    mutable bool m_viewValid = false;
+};
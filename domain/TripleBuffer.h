@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+
+// Triple tampon sans verrou entre un producteur et un consommateur : le
+// producteur remplit back(), publish() l'échange avec l'emplacement du
+// milieu ; le consommateur récupère avec acquire() la dernière valeur
+// publiée. Aucun des deux n'attend l'autre : les valeurs publiées entre
+// deux acquire() sont écrasées (seule la plus récente est lue).
+//
+// Les trois emplacements sont réutilisés (pas d'allocation en régime
+// établi si T réutilise sa capacité à l'affectation).
+template <class T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // producteur
+    T& back() { return m_slots[m_back]; }
+    void publish() {
+        m_back = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel) & kIndex;
+    }
+
+    // consommateur : vrai si une nouvelle valeur a été publiée depuis le
+    // dernier appel (front() désigne alors cette valeur)
+    bool acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndex;
+        return true;
+    }
+    const T& front() const { return m_slots[m_front]; }
+
+    // une valeur publiée attend d'être lue (consultable des deux côtés)
+    bool pending() const { return m_middle.load(std::memory_order_acquire) & kFresh; }
+
+private:
+    static constexpr int kIndex = 3;
+    static constexpr int kFresh = 4; // emplacement du milieu non encore lu
+
+    T m_slots[3];
+    int m_back = 0;                    // propriété du producteur
+    std::atomic<int> m_middle{ 1 };
+    int m_front = 2;                   // propriété du consommateur
+};
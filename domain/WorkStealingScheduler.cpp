@@ -0,0 +1,86 @@
+#include "WorkStealingScheduler.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+WorkStealingScheduler::Stats WorkStealingScheduler::run(int count, int threads,
+                                                        Task task, void* context)
+{
+    Stats total;
+    if (count <= 0) return total;
+    if (threads <= 0) threads = WorkerPool::hardwareThreads();
+    threads = std::min(threads, count);
+
+    // tranches contigues : sans desequilibre, aucun vol
+    std::vector<Queue> queues(threads);
+    for (int w = 0; w < threads; ++w) {
+        const int begin = static_cast<int>(static_cast<long long>(count) * w / threads);
+        const int end = static_cast<int>(static_cast<long long>(count) * (w + 1) / threads);
+        for (int i = begin; i < end; ++i) queues[w].tasks.push_back(i);
+    }
+
+    std::vector<Stats> stats(threads);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&](int worker) {
+        int index = 0;
+        while (next(queues, worker, index, stats[worker])) {
+            try {
+                task(context, index, worker);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int w = 1; w < threads; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (std::thread& t : pool) t.join();
+
+    for (const Stats& s : stats) {
+        total.steals += s.steals;
+        total.stolenTasks += s.stolenTasks;
+    }
+    if (error) std::rethrow_exception(error);
+    return total;
+}
+
+bool WorkStealingScheduler::next(std::vector<Queue>& queues, int worker, int& index, Stats& stats) {
+    Queue& own = queues[worker];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            index = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // file vide : vole la moitie arriere d'une autre file (la premiere non
+    // vide a partir du voisin), en garde la premiere tache et range le reste
+    const int n = static_cast<int>(queues.size());
+    std::vector<int> stolen;
+    for (int k = 1; k < n && stolen.empty(); ++k) {
+        Queue& victim = queues[(worker + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        const std::size_t take = (victim.tasks.size() + 1) / 2;
+        stolen.assign(victim.tasks.end() - take, victim.tasks.end());
+        victim.tasks.erase(victim.tasks.end() - take, victim.tasks.end());
+    }
+    // rien a voler : les taches en cours de transfert appartiennent deja a
+    // leur voleur, qui les traitera
+    if (stolen.empty()) return false;
+
+    ++stats.steals;
+    stats.stolenTasks += static_cast<long long>(stolen.size());
+    index = stolen.front();
+    if (stolen.size() > 1) {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.insert(own.tasks.end(), stolen.begin() + 1, stolen.end());
+    }
+    return true;
+}
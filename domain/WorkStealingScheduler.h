@@ -0,0 +1,46 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Ordonnanceur par vol de travail pour des tâches indépendantes de durées
+// très inégales (simulations d'un lot) : chaque thread reçoit une tranche
+// contiguë des tâches dans sa propre file et la traite dans l'ordre ; une
+// fois sa file vide, il vole la moitié de la file restante d'un autre
+// thread. Aucune file centrale n'est partagée par tous les threads.
+//
+// Les threads sont créés pour la durée d'un appel (le thread appelant
+// participe) : un lot dure bien plus longtemps que leur création.
+class WorkStealingScheduler {
+public:
+    struct Stats {
+        long long steals = 0;      // vols réussis
+        long long stolenTasks = 0; // tâches déplacées par ces vols
+    };
+
+    // appelle task(index, worker) pour chaque index de [0, count), worker
+    // dans [0, threads) ; threads <= 0 : tous les cœurs. Une exception levée
+    // par une tâche n'interrompt pas les autres ; la première est relancée
+    // ici une fois toutes les tâches terminées.
+    template <class F>
+    static Stats run(int count, int threads, F& task) {
+        return run(count, threads, &invoke<F>, &task);
+    }
+
+private:
+    typedef void (*Task)(void* context, int index, int worker);
+
+    template <class F>
+    static void invoke(void* context, int index, int worker) {
+        (*static_cast<F*>(context))(index, worker);
+    }
+
+    // file d'un thread : le propriétaire prend à l'avant, les voleurs à l'arrière
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    static Stats run(int count, int threads, Task task, void* context);
+    static bool next(std::vector<Queue>& queues, int worker, int& index, Stats& stats);
+};
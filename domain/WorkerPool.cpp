@@ -0,0 +1,82 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(int threads) {
+    for (int i = 1; i < threads; ++i)
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& t : m_threads) t.join();
+}
+
+int WorkerPool::hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+void WorkerPool::run(int count, Task task, void* context) {
+    if (count <= 0) return;
+    if (m_threads.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) task(context, i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = task;
+        m_context = context;
+        m_count = count;
+        m_next.store(0, std::memory_order_relaxed);
+        m_active = static_cast<int>(m_threads.size());
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    drain();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_active == 0; });
+        error = m_error;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void WorkerPool::drain() {
+    // distribution dynamique des indices : chaque thread prend le suivant
+    for (;;) {
+        int index = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_count) return;
+        try {
+            m_task(m_context, index);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) m_error = std::current_exception();
+        }
+    }
+}
+
+void WorkerPool::workerLoop() {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_active == 0) m_done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads persistant : les workers sont créés une seule fois puis
+// réveillés à chaque appel de parallelFor (aucune création de thread ni
+// allocation par génération). Le thread appelant participe au travail.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads); // nombre total de threads, appelant compris
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    // appelle task(i) pour chaque i de [0, count) et attend la fin ;
+    // la première exception levée par une tâche est relancée ici
+    template <class F>
+    void parallelFor(int count, F& task) {
+        run(count, &invoke<F>, &task);
+    }
+
+    static int hardwareThreads();
+
+private:
+    typedef void (*Task)(void* context, int index);
+
+    template <class F>
+    static void invoke(void* context, int index) {
+        (*static_cast<F*>(context))(index);
+    }
+
+    void run(int count, Task task, void* context);
+    void drain();
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    Task m_task = nullptr;
+    void* m_context = nullptr;
+    int m_count = 0;
+    std::atomic<int> m_next{0};
+    int m_active = 0;
+    unsigned m_generation = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+};
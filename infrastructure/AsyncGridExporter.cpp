@@ -0,0 +1,128 @@
+#include "AsyncGridExporter.h"
+#include <stdexcept>
+#include <utility>
+
+AsyncGridExporter::AsyncGridExporter(const IGridExporter& inner, int capacity)
+    : m_inner(inner)
+{
+    if (capacity <= 0) {
+        throw std::invalid_argument("File d'export vide");
+    }
+    m_slots.resize(capacity);
+    m_thread = std::thread(&AsyncGridExporter::writerLoop, this);
+}
+
+AsyncGridExporter::~AsyncGridExporter() {
+    stop();
+}
+
+void AsyncGridExporter::exportGrid(const Grid& grid,
+                                   const std::string& baseName,
+                                   int iteration) const
+{
+    Snapshot& slot = reserve();
+    // copie hors verrou : le thread d'ecriture ne touche pas cet emplacement
+    slot.multiState = false;
+    slot.grid = grid;
+    slot.baseName = baseName;
+    slot.iteration = iteration;
+    publish();
+}
+
+void AsyncGridExporter::exportStates(const StateGrid& states,
+                                     const std::string& baseName,
+                                     int iteration) const
+{
+    Snapshot& slot = reserve();
+    slot.multiState = true;
+    slot.states = states;
+    slot.baseName = baseName;
+    slot.iteration = iteration;
+    publish();
+}
+
+void AsyncGridExporter::finish() const {
+    stop();
+    rethrowError();
+    // apres un echec (deja signale), rien d'autre n'est ecrit
+    if (!m_failed) m_inner.finish();
+}
+
+AsyncGridExporter::Snapshot& AsyncGridExporter::reserve() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stop) {
+        throw std::logic_error("Export deja termine");
+    }
+    m_notFull.wait(lock, [this] {
+        return m_pending < static_cast<int>(m_slots.size()) || m_error;
+    });
+    if (m_error) {
+        lock.unlock();
+        rethrowError();
+    }
+    return m_slots[(m_head + m_pending) % m_slots.size()];
+}
+
+void AsyncGridExporter::publish() const {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    m_notEmpty.notify_one();
+}
+
+void AsyncGridExporter::stop() const {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_notEmpty.notify_one();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void AsyncGridExporter::rethrowError() const {
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error = std::exchange(m_error, nullptr); // signalee une seule fois
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void AsyncGridExporter::writerLoop() {
+    for (;;) {
+        Snapshot* slot = nullptr;
+        bool skip = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [this] { return m_pending > 0 || m_stop; });
+            if (m_pending == 0) return; // arret demande et file videe
+            slot = &m_slots[m_head];
+            skip = m_failed;
+        }
+
+        std::exception_ptr error;
+        if (!skip) {
+            try {
+                if (slot->multiState)
+                    m_inner.exportStates(slot->states, slot->baseName, slot->iteration);
+                else
+                    m_inner.exportGrid(slot->grid, slot->baseName, slot->iteration);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_head = (m_head + 1) % static_cast<int>(m_slots.size());
+            --m_pending;
+            if (error) {
+                m_failed = true;
+                m_error = error;
+            }
+        }
+        m_notFull.notify_one();
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "IGridExporter.h"
+
+// Infrastructure : décorateur d'export asynchrone. Chaque génération est
+// copiée dans une file bornée d'instantanés puis écrite par un thread
+// dédié : le calcul de la génération suivante recouvre le formatage et les
+// entrées/sorties. Quand la file est pleine, exportGrid() attend qu'une
+// place se libère (contre-pression : la mémoire reste bornée).
+//
+// Les emplacements de la file sont réutilisés d'une génération à l'autre
+// (copie dans un tampon déjà dimensionné, sans allocation en régime
+// établi). finish() attend l'écriture de tout ce qui a été soumis, arrête
+// le thread puis appelle finish() sur l'exporter décoré ; une erreur
+// d'écriture est relancée une seule fois, par l'appel suivant (exportGrid
+// ou finish), et les instantanés restants sont abandonnés.
+class AsyncGridExporter : public IGridExporter {
+public:
+    AsyncGridExporter(const IGridExporter& inner, int capacity = 4);
+    ~AsyncGridExporter() override; // attend le thread sans relancer d'erreur
+
+    AsyncGridExporter(const AsyncGridExporter&) = delete;
+    AsyncGridExporter& operator=(const AsyncGridExporter&) = delete;
+
+    void exportGrid(const Grid& grid,
+                    const std::string& baseName,
+                    int iteration) const override;
+    void exportStates(const StateGrid& states,
+                      const std::string& baseName,
+                      int iteration) const override;
+    void finish() const override;
+
+    int capacity() const { return static_cast<int>(m_slots.size()); }
+
+private:
+    struct Snapshot {
+        bool multiState = false;
+        Grid grid;
+        StateGrid states;
+        std::string baseName;
+        int iteration = 0;
+    };
+
+    Snapshot& reserve() const; // attend une place libre dans la file
+    void publish() const;
+    void stop() const;
+    void writerLoop();
+    void rethrowError() const;
+
+    const IGridExporter& m_inner;
+    // les méthodes du port sont const : l'état de la file est mutable
+    mutable std::vector<Snapshot> m_slots;  // tampon circulaire
+    mutable int m_head = 0;                 // prochain instantané à écrire
+    mutable int m_pending = 0;              // instantanés soumis non écrits
+    mutable bool m_stop = false;
+    mutable bool m_failed = false;          // écritures suivantes ignorées
+    mutable std::exception_ptr m_error;     // erreur pas encore signalée
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_notFull;
+    mutable std::condition_variable m_notEmpty;
+    mutable std::thread m_thread;
+};
@@ -0,0 +1,130 @@
+#include "BatchManifest.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::invalid_argument lineError(int line, const std::string& message) {
+    return std::invalid_argument("Manifeste, ligne " + std::to_string(line) + " : " + message);
+}
+
+Engine parseEngine(const std::string& name, int line) {
+    if (name == "dense") return Engine::Dense;
+    if (name == "sparse") return Engine::Sparse;
+    if (name == "hashlife") return Engine::HashLife;
+    throw lineError(line, "moteur inconnu " + name);
+}
+
+// nombre entier ou reel entier, sans caractere residuel
+template <class T>
+T parseNumber(const std::string& text, const std::string& key, int line) {
+    std::istringstream in(text);
+    T value;
+    if (!(in >> value) || !in.eof()) throw lineError(line, "valeur invalide pour " + key + " : " + text);
+    return value;
+}
+
+// "256x128" -> lignes, colonnes
+void parseSize(const std::string& text, int line, int& rows, int& cols) {
+    std::istringstream in(text);
+    char x = 0;
+    if (!(in >> rows >> x >> cols) || x != 'x' || !in.eof() || rows <= 0 || cols <= 0) {
+        throw lineError(line, "taille de soupe invalide (attendu LxC) : " + text);
+    }
+}
+
+std::string directoryOf(const std::string& path) {
+    const std::size_t slash = path.rfind('/');
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+} // namespace
+
+std::vector<BatchJob> BatchManifest::load(const std::string& path, const SimulationConfig& defaults) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Impossible d'ouvrir le manifeste : " + path);
+    }
+    return parse(in, defaults, directoryOf(path));
+}
+
+std::vector<BatchJob> BatchManifest::parse(std::istream& in, const SimulationConfig& defaults,
+                                           const std::string& baseDir)
+{
+    std::vector<BatchJob> jobs;
+    std::string text;
+    int line = 0;
+    while (std::getline(in, text)) {
+        ++line;
+        const std::size_t hash = text.find('#');
+        if (hash != std::string::npos) text.erase(hash);
+        std::istringstream tokens(text);
+        std::string first;
+        if (!(tokens >> first)) continue; // ligne vide
+
+        BatchJob job;
+        job.config = defaults;
+        job.config.outputBaseName.clear();
+        int count = 1;
+        if (first == "soup") {
+            std::string size;
+            if (!(tokens >> size)) throw lineError(line, "taille de soupe manquante");
+            job.soup = true;
+            job.soupDensity = 0.35;
+            parseSize(size, line, job.soupRows, job.soupCols);
+        }
+        else {
+            job.config.inputFile = first[0] == '/' ? first : baseDir + first;
+            job.name = first;
+        }
+
+        std::string option;
+        while (tokens >> option) {
+            const std::size_t eq = option.find('=');
+            const std::string key = option.substr(0, eq);
+            const std::string value = eq == std::string::npos ? std::string() : option.substr(eq + 1);
+            if (key == "toroidal" && eq == std::string::npos)
+                job.config.toroidal = true;
+            else if (eq == std::string::npos)
+                throw lineError(line, "reglage sans valeur : " + option);
+            else if (key == "toroidal")
+                job.config.toroidal = parseNumber<int>(value, key, line) != 0;
+            else if (key == "max")
+                job.config.maxIterations = parseNumber<int>(value, key, line);
+            else if (key == "rule")
+                job.config.rule = RuleSpec::parse(value);
+            else if (key == "engine")
+                job.config.engine = parseEngine(value, line);
+            else if (key == "name")
+                job.name = value;
+            else if (key == "density" && job.soup)
+                job.soupDensity = parseNumber<double>(value, key, line);
+            else if (key == "count" && job.soup)
+                count = parseNumber<int>(value, key, line);
+            else if (key == "seed" && job.soup)
+                job.soupSeed = parseNumber<std::uint64_t>(value, key, line);
+            else
+                throw lineError(line, "reglage inconnu : " + key);
+        }
+        if (job.soup && (job.soupDensity < 0.0 || job.soupDensity > 1.0)) {
+            throw lineError(line, "densite hors de [0, 1]");
+        }
+        if (count < 0) throw lineError(line, "count negatif");
+
+        // une soupe par graine : seed, seed+1, ...
+        const std::uint64_t seed = job.soupSeed;
+        for (int i = 0; i < count; ++i) {
+            BatchJob copy = job;
+            if (job.soup) {
+                copy.soupSeed = seed + static_cast<std::uint64_t>(i);
+                std::ostringstream name;
+                name << (job.name.empty() ? "soup" : job.name) << "_" << job.soupRows << "x"
+                     << job.soupCols << "_d" << job.soupDensity << "_s" << copy.soupSeed;
+                copy.name = name.str();
+            }
+            jobs.push_back(copy);
+        }
+    }
+    return jobs;
+}
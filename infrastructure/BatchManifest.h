@@ -0,0 +1,24 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+#include "BatchJob.h"
+
+// Infrastructure : lecture d'un manifeste de lot (texte, une entrée par
+// ligne, # pour les commentaires) :
+//
+//   patterns/glider.rle max=500 toroidal
+//   soup 256x256 density=0.35 count=1000 seed=1 rule=B36/S23
+//
+// Une ligne « soup LxC » décrit count soupes (1 par défaut) de graines
+// seed, seed+1, ... ; toute autre ligne est un fichier d'entrée, relatif au
+// dossier du manifeste. Réglages par entrée : max=N, rule=B../S..,
+// engine=dense|sparse|hashlife, toroidal[=0|1], density=D, count=N, seed=S,
+// name=NOM. Les réglages absents viennent de defaults (ligne de commande).
+class BatchManifest {
+public:
+    static std::vector<BatchJob> load(const std::string& path, const SimulationConfig& defaults);
+    // baseDir : dossier des chemins relatifs (vide = dossier courant)
+    static std::vector<BatchJob> parse(std::istream& in, const SimulationConfig& defaults,
+                                       const std::string& baseDir = std::string());
+};
@@ -0,0 +1,49 @@
+#include "BatchSummaryFile.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+// champ CSV : entre guillemets s'il contient un separateur
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+void BatchSummaryFile::write(const std::string& path,
+                             const std::vector<BatchJob>& jobs,
+                             const std::vector<BatchResult>& results)
+{
+    if (jobs.size() != results.size()) {
+        throw std::invalid_argument("Synthese de lot : un resultat par simulation attendu");
+    }
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + path);
+    }
+    out << "name,input,rows,cols,density,seed,rule,toroidal,status,generation,"
+           "population,period,seconds,error\n";
+    out << std::setprecision(6);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        const BatchJob& job = jobs[i];
+        const BatchResult& r = results[i];
+        out << csvField(r.name) << ',' << csvField(job.soup ? "soup" : job.config.inputFile) << ',';
+        if (job.soup) out << job.soupRows << ',' << job.soupCols << ',' << job.soupDensity << ',' << job.soupSeed;
+        else out << ",,,";
+        out << ',' << job.config.rule.toString() << ',' << (job.config.toroidal ? 1 : 0)
+            << ',' << BatchResult::statusName(r.status) << ',' << r.generation
+            << ',' << r.population << ',' << r.period << ',' << r.seconds
+            << ',' << csvField(r.error) << '\n';
+    }
+    if (!out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + path);
+    }
+}
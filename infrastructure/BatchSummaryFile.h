@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "BatchJob.h"
+
+// Infrastructure : synthèse d'un lot en CSV, une ligne par simulation dans
+// l'ordre du manifeste (nom, réglages, issue, dernière génération,
+// population, période, durée, erreur éventuelle).
+class BatchSummaryFile {
+public:
+    static void write(const std::string& path,
+                      const std::vector<BatchJob>& jobs,
+                      const std::vector<BatchResult>& results);
+};
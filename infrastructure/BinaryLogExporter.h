@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "IGridExporter.h"
+#include "SimulationLog.h"
+
+// Infrastructure : export de toutes les générations dans un seul journal
+// binaire compressé (voir SimulationLog.h). baseName est ignoré : le
+// chemin du journal est fixé à la construction. Le journal ne porte que
+// les cellules vivantes : les états des règles Generations y seraient
+// perdus (refusé par ConsoleRunner).
+class BinaryLogExporter : public IGridExporter {
+public:
+    explicit BinaryLogExporter(const std::string& path, int keyframeInterval = 64)
+        : m_writer(std::make_unique<SimulationLogWriter>(path, keyframeInterval)) {}
+
+    void exportGrid(const Grid& grid,
+                    const std::string&,
+                    int iteration) const override {
+        m_writer->append(grid, iteration);
+    }
+
+    void finish() const override { m_writer->close(); }
+
+private:
+    // exportGrid() est const : l'état d'écriture est porté à part
+    std::unique_ptr<SimulationLogWriter> m_writer;
+};
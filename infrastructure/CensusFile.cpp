@@ -0,0 +1,25 @@
+#include "CensusFile.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+void CensusFile::write(const std::string& path, const CensusReport& report) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + path);
+    }
+    // les codes et les noms ne contiennent ni virgule ni guillemet
+    out << "code,name,kind,period,dx,dy,count,share,sample_seed\n";
+    out << std::setprecision(6);
+    for (const CensusEntry& entry : report.entries) {
+        const ObjectClass& object = entry.object;
+        out << object.code << ',' << object.name << ',' << ObjectClass::kindName(object.kind)
+            << ',' << object.period << ',' << object.dx << ',' << object.dy
+            << ',' << entry.count << ','
+            << (report.objects > 0 ? static_cast<double>(entry.count) / report.objects : 0.0)
+            << ',' << entry.sampleSeed << '\n';
+    }
+    if (!out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + path);
+    }
+}
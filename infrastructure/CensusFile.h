@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include "CensusReport.h"
+
+// Infrastructure : tableau d'un recensement en CSV, une ligne par classe
+// d'objets, du plus fréquent au plus rare (code canonique, nom usuel,
+// nature, période, déplacement, nombre, part des objets, graine d'une
+// soupe qui le contient).
+class CensusFile {
+public:
+    static void write(const std::string& path, const CensusReport& report);
+};
@@ -0,0 +1,189 @@
+#include "CheckpointFile.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+typedef std::uint64_t u64;
+
+const char kMagic[8] = { 'G', 'O', 'L', 'C', 'K', 'P', 1, 0 };
+
+// entiers petit-boutistes de taille fixe, independants de la plateforme
+void putU64(std::vector<std::uint8_t>& out, u64 v, int bytes = 8) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+void putString(std::vector<std::uint8_t>& out, const std::string& s) {
+    putU64(out, s.size(), 4);
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+// lecture bornee : toute lecture au-dela de la fin marque le fichier invalide
+struct Reader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+    bool ok = true;
+
+    u64 get(int bytes) {
+        if (end - p < bytes) { ok = false; p = end; return 0; }
+        u64 v = 0;
+        for (int i = 0; i < bytes; ++i) v |= static_cast<u64>(p[i]) << (8 * i);
+        p += bytes;
+        return v;
+    }
+    int getInt() { return static_cast<int>(static_cast<std::int32_t>(get(4))); }
+    std::string getString() {
+        u64 size = get(4);
+        if (static_cast<u64>(end - p) < size) { ok = false; p = end; return std::string(); }
+        std::string s(reinterpret_cast<const char*>(p), static_cast<std::size_t>(size));
+        p += size;
+        return s;
+    }
+};
+
+std::runtime_error corrupted(const std::string& path) {
+    return std::runtime_error("Point de reprise invalide : " + path);
+}
+
+void writeAll(int fd, const std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n <= 0) throw std::runtime_error("ecriture");
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+} // namespace
+
+void CheckpointFile::write(const std::string& path, const SimulationCheckpoint& checkpoint) {
+    const SimulationConfig& config = checkpoint.config;
+    const EngineCheckpoint& engine = checkpoint.engine;
+    const Grid& grid = engine.grid;
+    const std::size_t words = static_cast<std::size_t>(grid.rows()) * grid.wordsPerRow();
+
+    std::vector<std::uint8_t> out(kMagic, kMagic + 8);
+    out.reserve(256 + engine.history.size() * 20 + words * 8);
+    putString(out, config.inputFile);
+    putString(out, config.outputBaseName);
+    putU64(out, static_cast<std::uint32_t>(config.maxIterations), 4);
+    putU64(out, config.rule.birth, 2);
+    putU64(out, config.rule.survival, 2);
+    putU64(out, config.rule.states, 1);
+    putU64(out, config.kernel == StepKernel::Bitwise ? 1 : 0, 1);
+    putU64(out, static_cast<std::uint32_t>(config.cycleHistory), 4);
+    putU64(out, config.stopOnCycle ? 1 : 0, 1);
+    putU64(out, config.outputFormat == OutputFormat::Log ? 1 : 0, 1);
+    putU64(out, static_cast<std::uint32_t>(config.logKeyframeInterval), 4);
+    putU64(out, static_cast<std::uint32_t>(config.exportEvery), 4);
+    putU64(out, static_cast<std::uint32_t>(config.checkpointEvery), 4);
+    putU64(out, static_cast<std::uint32_t>(checkpoint.lastExported), 4);
+
+    putU64(out, static_cast<std::uint32_t>(engine.iteration), 4);
+    putU64(out, static_cast<u64>(engine.lastStats.births));
+    putU64(out, static_cast<u64>(engine.lastStats.deaths));
+    putU64(out, static_cast<std::uint32_t>(engine.period), 4);
+    putU64(out, engine.history.size(), 4);
+    for (const CycleDetector::Entry& e : engine.history) {
+        putU64(out, e.hash);
+        putU64(out, static_cast<u64>(e.population));
+        putU64(out, static_cast<std::uint32_t>(e.iteration), 4);
+    }
+
+    putU64(out, static_cast<std::uint32_t>(grid.rows()), 4);
+    putU64(out, static_cast<std::uint32_t>(grid.cols()), 4);
+    putU64(out, grid.toroidal() ? 1 : 0, 1);
+    putU64(out, grid.hash());
+    for (int r = 0; r < grid.rows(); ++r) {
+        const u64* row = grid.rowWords(r);
+        for (int w = 0; w < grid.wordsPerRow(); ++w) putU64(out, row[w]);
+    }
+
+    // fichier temporaire complet et synchronise, puis renommage atomique
+    const std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible d'ecrire le point de reprise : " + temp);
+    }
+    try {
+        writeAll(fd, out.data(), out.size());
+        if (::fsync(fd) != 0) throw std::runtime_error("fsync");
+    }
+    catch (const std::exception&) {
+        ::close(fd);
+        std::remove(temp.c_str());
+        throw std::runtime_error("Impossible d'ecrire le point de reprise : " + temp);
+    }
+    ::close(fd);
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Impossible d'ecrire le point de reprise : " + path);
+    }
+}
+
+SimulationCheckpoint CheckpointFile::read(const std::string& path) {
+    MappedFile file(path);
+    const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(file.data());
+    if (file.size() < 8 || std::memcmp(data, kMagic, 8) != 0) {
+        throw corrupted(path);
+    }
+    Reader in{ data + 8, data + file.size() };
+
+    SimulationCheckpoint checkpoint;
+    SimulationConfig& config = checkpoint.config;
+    config.inputFile = in.getString();
+    config.outputBaseName = in.getString();
+    config.maxIterations = in.getInt();
+    config.rule.birth = static_cast<std::uint16_t>(in.get(2));
+    config.rule.survival = static_cast<std::uint16_t>(in.get(2));
+    config.rule.states = static_cast<std::uint8_t>(in.get(1));
+    config.kernel = in.get(1) ? StepKernel::Bitwise : StepKernel::PerCellRule;
+    config.cycleHistory = in.getInt();
+    config.stopOnCycle = in.get(1) != 0;
+    config.outputFormat = in.get(1) ? OutputFormat::Log : OutputFormat::Text;
+    config.logKeyframeInterval = in.getInt();
+    config.exportEvery = in.getInt();
+    config.checkpointEvery = in.getInt();
+    config.checkpointFile = path;
+    checkpoint.lastExported = in.getInt();
+
+    EngineCheckpoint& engine = checkpoint.engine;
+    engine.iteration = in.getInt();
+    engine.lastStats.births = static_cast<long long>(in.get(8));
+    engine.lastStats.deaths = static_cast<long long>(in.get(8));
+    engine.period = in.getInt();
+    const u64 entries = in.get(4);
+    if (!in.ok || entries > static_cast<u64>(in.end - in.p) / 20) throw corrupted(path);
+    engine.history.resize(static_cast<std::size_t>(entries));
+    for (CycleDetector::Entry& e : engine.history) {
+        e.hash = in.get(8);
+        e.population = static_cast<long long>(in.get(8));
+        e.iteration = in.getInt();
+    }
+
+    const int rows = in.getInt();
+    const int cols = in.getInt();
+    const bool toroidal = in.get(1) != 0;
+    const u64 hash = in.get(8);
+    if (!in.ok || rows < 0 || cols < 0) throw corrupted(path);
+    const u64 words = static_cast<u64>(rows) * ((static_cast<u64>(cols) + 63) / 64);
+    if (static_cast<u64>(in.end - in.p) != words * 8) throw corrupted(path);
+    Grid grid(rows, cols, toroidal);
+    for (int r = 0; r < rows; ++r) {
+        u64* row = grid.rowWords(r);
+        for (int w = 0; w < grid.wordsPerRow(); ++w) row[w] = in.get(8);
+    }
+    // bits de bourrage toujours nuls, contenu verifie par l'empreinte
+    const u64 mask = grid.lastWordMask();
+    for (int r = 0; r < rows && grid.wordsPerRow() > 0; ++r) {
+        if (grid.rowWords(r)[grid.wordsPerRow() - 1] & ~mask) throw corrupted(path);
+    }
+    if (grid.hash() != hash) throw corrupted(path);
+    engine.grid.swap(grid);
+    return checkpoint;
+}
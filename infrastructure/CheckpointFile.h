@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include "SimulationCheckpoint.h"
+
+// Fichier binaire d'un point de reprise (entiers petit-boutistes) :
+//   magie | configuration | dernier export | compteur, bilan et historique
+//   des cycles | grille (dimensions, empreinte, mots de 64 cellules bruts)
+// L'écriture passe par un fichier temporaire synchronisé sur disque puis
+// renommé : un arrêt brutal laisse l'ancien point de reprise intact.
+class CheckpointFile {
+public:
+    static void write(const std::string& path, const SimulationCheckpoint& checkpoint);
+    static SimulationCheckpoint read(const std::string& path); // lève std::runtime_error
+};
@@ -0,0 +1,74 @@
+#include "FileCheckpointStore.h"
+#include "CheckpointFile.h"
+#include <stdexcept>
+#include <utility>
+
+FileCheckpointStore::FileCheckpointStore(const std::string& path)
+    : m_path(path)
+{
+    m_thread = std::thread(&FileCheckpointStore::writerLoop, this);
+}
+
+FileCheckpointStore::~FileCheckpointStore() {
+    stop();
+}
+
+void FileCheckpointStore::save(SimulationCheckpoint& checkpoint) const {
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) {
+            throw std::logic_error("Points de reprise deja termines");
+        }
+        error = std::exchange(m_error, nullptr);
+        if (!error) {
+            // echange de tampons : l'appelant recupere un ancien point de reprise
+            std::swap(m_pending, checkpoint);
+            m_hasPending = true;
+        }
+    }
+    if (error) std::rethrow_exception(error);
+    m_wake.notify_one();
+}
+
+SimulationCheckpoint FileCheckpointStore::load(const std::string& path) const {
+    return CheckpointFile::read(path);
+}
+
+void FileCheckpointStore::finish() const {
+    stop();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error = std::exchange(m_error, nullptr);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void FileCheckpointStore::stop() const {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void FileCheckpointStore::writerLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_hasPending || m_stop; });
+            if (!m_hasPending) return; // arret demande, rien en attente
+            std::swap(m_writing, m_pending);
+            m_hasPending = false;
+        }
+        try {
+            CheckpointFile::write(m_path, m_writing);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = std::current_exception();
+        }
+    }
+}
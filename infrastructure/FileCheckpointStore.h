@@ -0,0 +1,40 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "ICheckpointStore.h"
+
+// Infrastructure : points de reprise écrits par un thread dédié dans un
+// seul fichier (voir CheckpointFile.h). save() échange le point de reprise
+// avec le tampon en attente, sous verrou : le pas de simulation n'attend ni
+// le codage ni le disque. Si un point de reprise attend encore quand le
+// suivant arrive, seul le plus récent est écrit.
+class FileCheckpointStore : public ICheckpointStore {
+public:
+    explicit FileCheckpointStore(const std::string& path);
+    ~FileCheckpointStore() override; // attend l'écriture en cours sans relancer d'erreur
+
+    FileCheckpointStore(const FileCheckpointStore&) = delete;
+    FileCheckpointStore& operator=(const FileCheckpointStore&) = delete;
+
+    void save(SimulationCheckpoint& checkpoint) const override;
+    SimulationCheckpoint load(const std::string& path) const override;
+    void finish() const override;
+
+private:
+    void stop() const;
+    void writerLoop();
+
+    std::string m_path;
+    // save() est const (port) : l'état d'écriture est mutable
+    mutable SimulationCheckpoint m_pending;  // dernier point de reprise soumis
+    mutable SimulationCheckpoint m_writing;  // en cours d'écriture
+    mutable bool m_hasPending = false;
+    mutable bool m_stop = false;
+    mutable std::exception_ptr m_error;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_wake;
+    mutable std::thread m_thread;
+};
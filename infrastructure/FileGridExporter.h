@@ -10,4 +10,9 @@ public:
                     int iteration) const override {
         GridExporter::exportGrid(grid, baseName, iteration);
     }
+    void exportStates(const StateGrid& states,
+                      const std::string& baseName,
+                      int iteration) const override {
+        GridExporter::exportStates(states, baseName, iteration);
+    }
 };
@@ -8,4 +8,7 @@ public:
     Grid loadGrid(const std::string& path, bool toroidal) const override {
         return InitialStateLoader::loadFromFile(path, toroidal);
     }
+    StateGrid loadStates(const std::string& path, bool toroidal) const override {
+        return InitialStateLoader::loadStatesFromFile(path, toroidal);
+    }
 };
@@ -1,5 +1,14 @@
 #include "GridExporter.h"
 #include <fstream>
+#include <stdexcept>
+
+// disque plein, quota... : l'erreur est signalee plutot qu'ignoree
+static void checkWritten(std::ofstream& out, const std::string& fileName) {
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + fileName);
+    }
+}
 
 void GridExporter::exportGrid(const Grid& grid,
                               const std::string& baseName,
@@ -7,14 +16,41 @@ void GridExporter::exportGrid(const Grid& grid,
 {
     std::string fileName = baseName + "_" + std::to_string(iteration) + ".txt";
     std::ofstream out(fileName);
-    if (!out) return;
+    if (!out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + fileName);
+    }
 
     out << grid.rows() << " " << grid.cols() << "\n";
+    // une ligne composee en memoire puis ecrite d'un bloc (pas de
+    // formatage iostream par cellule)
+    std::string line(grid.cols() > 0 ? 2 * grid.cols() : 1, ' ');
+    line.back() = '\n';
     for (int r = 0; r < grid.rows(); ++r) {
-        for (int c = 0; c < grid.cols(); ++c) {
-            out << (grid.at(r,c).isAlive() ? 1 : 0);
-            if (c + 1 < grid.cols()) out << ' ';
+        for (int c = 0; c < grid.cols(); ++c)
+            line[2 * c] = grid.isAlive(r, c) ? '1' : '0';
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+    checkWritten(out, fileName);
+}
+
+void GridExporter::exportStates(const StateGrid& states,
+                                const std::string& baseName,
+                                int iteration)
+{
+    std::string fileName = baseName + "_" + std::to_string(iteration) + ".txt";
+    std::ofstream out(fileName);
+    if (!out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + fileName);
+    }
+
+    out << states.rows() << " " << states.cols() << "\n";
+    for (int r = 0; r < states.rows(); ++r) {
+        const std::uint8_t* cells = states.row(r);
+        for (int c = 0; c < states.cols(); ++c) {
+            out << static_cast<int>(cells[c]);
+            if (c + 1 < states.cols()) out << ' ';
         }
         out << "\n";
     }
+    checkWritten(out, fileName);
 }
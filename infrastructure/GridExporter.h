@@ -1,10 +1,15 @@
 #pragma once
 #include <string>
 #include "Grid.h"
+#include "StateGrid.h"
 
 class GridExporter {
 public:
     static void exportGrid(const Grid& grid,
                            const std::string& baseName,
                            int iteration);
+    // même format texte, une valeur d'état par cellule
+    static void exportStates(const StateGrid& states,
+                             const std::string& baseName,
+                             int iteration);
 };
@@ -1,37 +1,348 @@
 #include "InitialStateLoader.h"
-#include "AliveState.h"
-#include "DeadState.h"
-#include <fstream>
+#include "MappedFile.h"
+#include <algorithm>
+#include <climits>
+#include <cctype>
+#include <cstring>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 
-Grid InitialStateLoader::loadFromFile(const std::string& path, bool toroidal) {
-    std::ifstream in(path);
-    if (!in) {
-        throw std::runtime_error("Impossible d'ouvrir le fichier : " + path);
+namespace {
+
+typedef InitialStateLoader::Format Format;
+
+// pose n cellules a l'etat s a partir de (r, c) ; la grille part vide.
+// Grille a deux etats : seul l'etat 1 est vivant (comme StateGrid::aliveInto).
+void fill(Grid& grid, int r, int c, int n, unsigned s) {
+    if (s != 1) return;
+    std::uint64_t* words = grid.rowWords(r);
+    const int end = c + n;
+    while (c < end) {
+        const int bit = c & 63;
+        const int len = std::min(64 - bit, end - c);
+        const std::uint64_t run = len == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << len) - 1;
+        words[c >> 6] |= run << bit;
+        c += len;
     }
+}
 
-    int rows = 0, cols = 0;
-    in >> rows >> cols;
-    if (!in) {
-        throw std::runtime_error("Fichier invalide (dimensions)");
+void fill(StateGrid& grid, int r, int c, int n, unsigned s) {
+    if (s != 0) std::memset(grid.row(r) + c, static_cast<int>(s), static_cast<std::size_t>(n));
+}
+
+// cellule valant 0 ou 1 (format historique, cas courant)
+inline void setDigit(Grid& grid, int r, int c, unsigned bit) {
+    grid.rowWords(r)[c >> 6] |= std::uint64_t(bit) << (c & 63);
+}
+
+inline void setDigit(StateGrid& grid, int r, int c, unsigned bit) {
+    grid.row(r)[c] = static_cast<std::uint8_t>(bit);
+}
+
+template <class G>
+constexpr unsigned maxState() {
+    return std::is_same<G, StateGrid>::value ? 255u : UINT_MAX;
+}
+
+// curseur sur le contenu projete
+struct Scanner {
+    const char* p;
+    const char* end;
+
+    bool atEnd() const { return p >= end; }
+    char peek() const { return p < end ? *p : '\0'; }
+
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    void skipBlanks() { while (p < end && isBlank(*p)) ++p; }
+    void skipSpaces() { while (p < end && (isBlank(*p) || *p == '\n')) ++p; }
+    void skipLine() {
+        const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        p = nl ? static_cast<const char*>(nl) + 1 : end;
+    }
+    bool startsWith(const char* text) const {
+        std::size_t n = std::strlen(text);
+        return static_cast<std::size_t>(end - p) >= n && std::memcmp(p, text, n) == 0;
     }
 
-    Grid grid(rows, cols, toroidal);
+    // entier signe ; faux si aucun chiffre ou valeur hors de [-2^40, 2^40]
+    bool readInt(long long& value) {
+        const char* q = p;
+        bool negative = q < end && *q == '-';
+        if (negative) ++q;
+        if (q >= end || !isDigit(*q)) return false;
+        long long v = 0;
+        while (q < end && isDigit(*q)) {
+            v = v * 10 + (*q++ - '0');
+            if (v > (1LL << 40)) return false;
+        }
+        p = q;
+        value = negative ? -v : v;
+        return true;
+    }
+};
+
+bool validDimension(long long n) {
+    return n >= 0 && n <= INT_MAX;
+}
+
+// --- format historique ------------------------------------------------------
 
+template <class G>
+G parseMatrix(Scanner in, bool toroidal) {
+    long long rows = 0, cols = 0;
+    in.skipSpaces();
+    bool ok = in.readInt(rows);
+    in.skipSpaces();
+    if (!ok || !in.readInt(cols) || !validDimension(rows) || !validDimension(cols)) {
+        throw std::runtime_error("Fichier invalide (dimensions)");
+    }
+
+    G grid(static_cast<int>(rows), static_cast<int>(cols), toroidal);
     for (int r = 0; r < rows; ++r) {
         for (int c = 0; c < cols; ++c) {
-            int v = 0;
-            in >> v;
-            if (!in) {
+            in.skipSpaces();
+            // cas courant : un seul chiffre 0/1, sans branche sur sa valeur
+            const char ch = in.peek();
+            if ((ch == '0' || ch == '1') && (in.p + 1 == in.end || !Scanner::isDigit(in.p[1]))) {
+                ++in.p;
+                setDigit(grid, r, c, static_cast<unsigned>(ch - '0'));
+                continue;
+            }
+            long long v = 0;
+            if (!in.readInt(v) || (maxState<G>() == 255u && (v < 0 || v > 255))) {
                 throw std::runtime_error("Fichier invalide (etat cellules)");
             }
-            if (v == 1) {
-                grid.at(r, c).setState(new AliveState());
-            } else {
-                grid.at(r, c).setState(new DeadState());
+            // deux etats : vivante si et seulement si la valeur vaut 1
+            if (v == 1 || (v > 1 && maxState<G>() == 255u))
+                fill(grid, r, c, 1, static_cast<unsigned>(v));
+        }
+    }
+    return grid;
+}
+
+// --- RLE ----------------------------------------------------------------------
+
+template <class G>
+G parseRle(Scanner in, bool toroidal) {
+    // commentaires (#N, #C, #O, ...) puis en-tete x = .., y = .., rule = ..
+    for (;;) {
+        in.skipSpaces();
+        if (in.peek() != '#') break;
+        in.skipLine();
+    }
+    long long rows = -1, cols = -1;
+    while (!in.atEnd() && in.peek() != '\n') {
+        in.skipBlanks();
+        const char* key = in.p;
+        while (!in.atEnd() && std::isalpha(static_cast<unsigned char>(in.peek()))) ++in.p;
+        std::string name(key, in.p);
+        in.skipBlanks();
+        if (in.peek() != '=') throw std::runtime_error("Fichier RLE invalide (en-tete)");
+        ++in.p;
+        in.skipBlanks();
+        if (name == "x" || name == "y") {
+            long long v = 0;
+            if (!in.readInt(v) || !validDimension(v)) {
+                throw std::runtime_error("Fichier RLE invalide (dimensions)");
             }
+            (name == "x" ? cols : rows) = v;
         }
+        else {
+            // regle ou autre cle : ignoree
+            while (!in.atEnd() && in.peek() != ',' && in.peek() != '\n') ++in.p;
+        }
+        in.skipBlanks();
+        if (in.peek() == ',') ++in.p;
+    }
+    if (rows < 0 || cols < 0) {
+        throw std::runtime_error("Fichier RLE invalide (dimensions)");
     }
 
+    G grid(static_cast<int>(rows), static_cast<int>(cols), toroidal);
+    long long r = 0, c = 0;
+    while (!in.atEnd()) {
+        char ch = *in.p;
+        if (Scanner::isBlank(ch) || ch == '\n') { ++in.p; continue; }
+        if (ch == '!') break;
+        if (ch == '#') { in.skipLine(); continue; }
+
+        long long count = 1;
+        if (Scanner::isDigit(ch)) {
+            if (!in.readInt(count)) throw std::runtime_error("Fichier RLE invalide (repetition)");
+            in.skipSpaces();
+            if (in.atEnd()) break;
+            ch = *in.p;
+        }
+        ++in.p;
+
+        unsigned state = 0;
+        if (ch == '$') {
+            r += count;
+            c = 0;
+            continue;
+        }
+        else if (ch == 'b' || ch == '.') state = 0;
+        else if (ch == 'o') state = 1;
+        else if (ch >= 'A' && ch <= 'X') state = static_cast<unsigned>(ch - 'A' + 1);
+        else if (ch >= 'p' && ch <= 'y' && !in.atEnd() && *in.p >= 'A' && *in.p <= 'X') {
+            state = 24u * static_cast<unsigned>(ch - 'p' + 1) + static_cast<unsigned>(*in.p - 'A' + 1);
+            ++in.p;
+        }
+        else throw std::runtime_error(std::string("Fichier RLE invalide (caractere '") + ch + "')");
+
+        if (state > maxState<G>()) throw std::runtime_error("Fichier RLE invalide (etat cellules)");
+        if (state != 0) {
+            if (r >= rows || c + count > cols) {
+                throw std::runtime_error("Fichier RLE invalide (motif hors dimensions)");
+            }
+            fill(grid, static_cast<int>(r), static_cast<int>(c), static_cast<int>(count), state);
+        }
+        c += count;
+    }
+    return grid;
+}
+
+// --- texte brut .cells -------------------------------------------------------------
+
+// fin de la ligne [p, end) sans blancs finaux
+const char* trimmedLineEnd(const char* p, const char* lineEnd) {
+    while (lineEnd > p && Scanner::isBlank(lineEnd[-1])) --lineEnd;
+    return lineEnd;
+}
+
+template <class F>
+void forEachCellsLine(Scanner in, F f) {
+    while (!in.atEnd()) {
+        const char* line = in.p;
+        in.skipLine();
+        const char* lineEnd = in.p;
+        if (lineEnd > line && lineEnd[-1] == '\n') --lineEnd;
+        if (line < lineEnd && *line == '!') continue;
+        f(line, trimmedLineEnd(line, lineEnd));
+    }
+}
+
+template <class G>
+G parseCells(Scanner in, bool toroidal) {
+    // premier passage : dimensions (les lignes vides finales sont ignorees)
+    long long rows = 0, cols = 0, lines = 0;
+    forEachCellsLine(in, [&](const char* line, const char* lineEnd) {
+        ++lines;
+        if (lineEnd > line) {
+            rows = lines;
+            cols = std::max<long long>(cols, lineEnd - line);
+        }
+    });
+    if (!validDimension(rows) || !validDimension(cols)) {
+        throw std::runtime_error("Fichier cells invalide (dimensions)");
+    }
+
+    G grid(static_cast<int>(rows), static_cast<int>(cols), toroidal);
+    int r = 0;
+    forEachCellsLine(in, [&](const char* line, const char* lineEnd) {
+        if (r < rows) {
+            for (const char* q = line; q < lineEnd; ++q) {
+                if (*q == 'O' || *q == '*') fill(grid, r, static_cast<int>(q - line), 1, 1);
+                else if (*q != '.') throw std::runtime_error("Fichier cells invalide (etat cellules)");
+            }
+        }
+        ++r;
+    });
+    return grid;
+}
+
+// --- Life 1.06 -----------------------------------------------------------------
+
+template <class F>
+void forEachLife106Cell(Scanner in, F f) {
+    for (;;) {
+        in.skipSpaces();
+        if (in.atEnd()) return;
+        if (in.peek() == '#') { in.skipLine(); continue; }
+        long long x = 0, y = 0;
+        bool ok = in.readInt(x);
+        in.skipBlanks();
+        if (!ok || !in.readInt(y)) {
+            throw std::runtime_error("Fichier Life 1.06 invalide (coordonnees)");
+        }
+        f(x, y);
+    }
+}
+
+template <class G>
+G parseLife106(Scanner in, bool toroidal) {
+    long long top = LLONG_MAX, left = LLONG_MAX, bottom = LLONG_MIN, right = LLONG_MIN;
+    forEachLife106Cell(in, [&](long long x, long long y) {
+        left = std::min(left, x);
+        right = std::max(right, x);
+        top = std::min(top, y);
+        bottom = std::max(bottom, y);
+    });
+    if (left > right) return G(0, 0, toroidal);
+    if (!validDimension(bottom - top + 1) || !validDimension(right - left + 1)) {
+        throw std::runtime_error("Fichier Life 1.06 invalide (motif trop grand)");
+    }
+
+    G grid(static_cast<int>(bottom - top + 1), static_cast<int>(right - left + 1), toroidal);
+    forEachLife106Cell(in, [&](long long x, long long y) {
+        fill(grid, static_cast<int>(y - top), static_cast<int>(x - left), 1, 1);
+    });
     return grid;
 }
+
+template <class G>
+G parseAny(const char* data, std::size_t size, bool toroidal) {
+    Scanner in{ data, data + size };
+    if (in.startsWith("\xEF\xBB\xBF")) in.p += 3; // BOM UTF-8, ignore par tous les formats
+    switch (InitialStateLoader::detectFormat(in.p, static_cast<std::size_t>(in.end - in.p))) {
+    case Format::Rle:     return parseRle<G>(in, toroidal);
+    case Format::Cells:   return parseCells<G>(in, toroidal);
+    case Format::Life106: return parseLife106<G>(in, toroidal);
+    case Format::Matrix:
+    default:              return parseMatrix<G>(in, toroidal);
+    }
+}
+
+} // namespace
+
+InitialStateLoader::Format InitialStateLoader::detectFormat(const char* data, std::size_t size) {
+    Scanner in{ data, data + size };
+    if (in.startsWith("\xEF\xBB\xBF")) in.p += 3; // BOM UTF-8
+    in.skipSpaces();
+    if (in.startsWith("#Life 1.06")) return Format::Life106;
+    if (in.startsWith("#Life")) {
+        throw std::runtime_error("Format Life non supporte (seul Life 1.06 est reconnu)");
+    }
+    switch (in.peek()) {
+    case '#': case 'x':
+        return Format::Rle;
+    case '!': case '.': case 'O': case '*':
+        return Format::Cells;
+    case '\0': case '-':
+        return Format::Matrix;
+    default:
+        if (Scanner::isDigit(in.peek())) return Format::Matrix;
+        throw std::runtime_error("Format de fichier inconnu");
+    }
+}
+
+Grid InitialStateLoader::parse(const char* data, std::size_t size, bool toroidal) {
+    return parseAny<Grid>(data, size, toroidal);
+}
+
+StateGrid InitialStateLoader::parseStates(const char* data, std::size_t size, bool toroidal) {
+    return parseAny<StateGrid>(data, size, toroidal);
+}
+
+Grid InitialStateLoader::loadFromFile(const std::string& path, bool toroidal) {
+    MappedFile file(path);
+    return parse(file.data(), file.size(), toroidal);
+}
+
+StateGrid InitialStateLoader::loadStatesFromFile(const std::string& path, bool toroidal) {
+    MappedFile file(path);
+    return parseStates(file.data(), file.size(), toroidal);
+}
@@ -1,8 +1,29 @@
 #pragma once
+#include <cstddef>
 #include <string>
 #include "Grid.h"
+#include "StateGrid.h"
 
+// Chargement d'une grille initiale. Le fichier est projeté en mémoire puis
+// analysé à la main, les cellules étant écrites directement dans le
+// stockage de la grille. Formats reconnus d'après le contenu :
+//  - Matrix  : format historique « lignes colonnes » puis une valeur par cellule
+//  - Rle     : RLE standard (en-tête « x = .., y = .. », b/o, $, !),
+//              états A..X et préfixes p..y des motifs multi-états
+//  - Cells   : texte brut .cells (« ! » commentaire, « . » morte, « O » vivante)
+//  - Life106 : « #Life 1.06 » puis une paire « x y » par cellule vivante ;
+//              la grille couvre le rectangle englobant
 class InitialStateLoader {
 public:
+    enum class Format { Matrix, Rle, Cells, Life106 };
+
     static Grid loadFromFile(const std::string& path, bool toroidal = false);
+    // valeurs 0..255 = état de chaque cellule (règles Generations) ; pour
+    // les formats à deux états, vivante = état 1
+    static StateGrid loadStatesFromFile(const std::string& path, bool toroidal = false);
+
+    // mêmes analyses sur un contenu déjà en mémoire
+    static Grid parse(const char* data, std::size_t size, bool toroidal = false);
+    static StateGrid parseStates(const char* data, std::size_t size, bool toroidal = false);
+    static Format detectFormat(const char* data, std::size_t size);
 };
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Fichier projeté en mémoire en lecture seule (mmap) : le contenu est lu
+// directement depuis le cache de pages, sans copie dans un tampon de flux.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path); // lève std::runtime_error
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr; // nul pour un fichier vide
+    std::size_t m_size = 0;
+};
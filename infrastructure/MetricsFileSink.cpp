@@ -0,0 +1,73 @@
+#include "MetricsFileSink.h"
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size()
+        && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+MetricsFileSink::MetricsFileSink(const std::string& path)
+    : m_path(path),
+      m_json(endsWith(path, ".jsonl") || endsWith(path, ".json")),
+      m_out(std::make_unique<std::ofstream>(path, std::ios::trunc))
+{
+    if (!*m_out) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + path);
+    }
+    if (!m_json) {
+        *m_out << "iteration,step_ns,export_ns,population,births,deaths,changed,"
+                  "active_tiles,region_top,region_left,region_bottom,region_right\n";
+    }
+}
+
+void MetricsFileSink::write(const GenerationMetrics* metrics, std::size_t count) const {
+    std::string buffer;
+    buffer.reserve(count * 160);
+    char line[320];
+    for (std::size_t i = 0; i < count; ++i) {
+        const GenerationMetrics& m = metrics[i];
+        const BoundingBox& box = m.activeRegion;
+        int n;
+        if (m_json) {
+            n = std::snprintf(line, sizeof line,
+                "{\"iteration\":%d,\"step_ns\":%lld,\"export_ns\":%lld,\"population\":%lld,"
+                "\"births\":%lld,\"deaths\":%lld,\"changed\":%lld,\"active_tiles\":%lld,"
+                "\"region\":%s",
+                m.iteration, static_cast<long long>(m.stepNanos),
+                static_cast<long long>(m.exportNanos), m.population, m.births, m.deaths,
+                m.changed(), m.activeTiles, box.empty() ? "null}\n" : "");
+            if (!box.empty()) {
+                n += std::snprintf(line + n, sizeof line - n, "[%lld,%lld,%lld,%lld]}\n",
+                                   box.top, box.left, box.bottom, box.right);
+            }
+        }
+        else {
+            n = std::snprintf(line, sizeof line, "%d,%lld,%lld,%lld,%lld,%lld,%lld,%lld,",
+                m.iteration, static_cast<long long>(m.stepNanos),
+                static_cast<long long>(m.exportNanos), m.population, m.births, m.deaths,
+                m.changed(), m.activeTiles);
+            // zone vide : colonnes vides
+            n += box.empty()
+                ? std::snprintf(line + n, sizeof line - n, ",,,\n")
+                : std::snprintf(line + n, sizeof line - n, "%lld,%lld,%lld,%lld\n",
+                                box.top, box.left, box.bottom, box.right);
+        }
+        buffer.append(line, static_cast<std::size_t>(n));
+    }
+    m_out->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!*m_out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + m_path);
+    }
+}
+
+void MetricsFileSink::finish() const {
+    m_out->flush();
+    if (!*m_out) {
+        throw std::runtime_error("Erreur d'ecriture du fichier : " + m_path);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <fstream>
+#include <memory>
+#include <string>
+#include "IMetricsSink.h"
+
+// Infrastructure : mesures par génération dans un fichier, une ligne par
+// génération. Format choisi par l'extension : .jsonl (ou .json) pour un
+// objet JSON par ligne, CSV avec en-tête sinon. Les lots reçus sont
+// formatés dans un tampon puis écrits d'un bloc.
+class MetricsFileSink : public IMetricsSink {
+public:
+    explicit MetricsFileSink(const std::string& path);
+
+    void write(const GenerationMetrics* metrics, std::size_t count) const override;
+    void finish() const override;
+
+private:
+    std::string m_path;
+    bool m_json;
+    // write() est const (port) : le flux est porté à part
+    std::unique_ptr<std::ofstream> m_out;
+};
@@ -0,0 +1,229 @@
+#include "SharedMemoryTransport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <sched.h>
+#include <signal.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// les atomiques sans verrou fonctionnent d'un processus a l'autre
+struct SharedMemoryTransport::Control {
+    alignas(64) std::atomic<unsigned> arrived;
+    alignas(64) std::atomic<unsigned> phase;
+    alignas(64) std::atomic<int> command;
+};
+
+namespace {
+
+const int kSpins = 256;       // attente active avant de ceder le processeur
+const int kYields = 64;       // puis sched_yield, puis sommeils courts
+const int kCheckEvery = 256;  // verification des processus pendant les sommeils
+
+std::size_t alignUp(std::size_t n) {
+    return (n + 63) & ~std::size_t(63);
+}
+
+} // namespace
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+    if (m_isWorker) return; // un fils se termine par _exit
+    try {
+        stop();
+    } catch (...) {
+        killWorkers();
+    }
+    if (m_memory) ::munmap(m_memory, m_size);
+}
+
+void SharedMemoryTransport::start(const Layout& layout, const Grid& initial, const WorkerMain& main) {
+    if (m_memory) {
+        throw std::logic_error("Transport deja demarre");
+    }
+    const int workers = layout.workers();
+    if (workers < 1 || layout.firstRows.back() != initial.rows()
+        || layout.wordsPerRow != initial.wordsPerRow()) {
+        throw std::invalid_argument("Decoupage incompatible avec la grille");
+    }
+    m_layout = layout;
+    const std::size_t words = static_cast<std::size_t>(layout.wordsPerRow);
+    const std::size_t controlBytes = alignUp(sizeof(Control));
+    const std::size_t reportBytes = alignUp(sizeof(StepStats) * workers);
+    const std::size_t haloBytes = alignUp(sizeof(std::uint64_t) * words * 4 * workers);
+    const std::size_t gridBytes = sizeof(std::uint64_t) * words * initial.rows();
+    m_size = controlBytes + reportBytes + haloBytes + gridBytes;
+    void* p = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        m_size = 0;
+        throw std::runtime_error("Impossible d'allouer la memoire partagee");
+    }
+    m_memory = p;
+    char* base = static_cast<char*>(p);
+    m_control = new (base) Control();
+    m_control->arrived.store(0);
+    m_control->phase.store(0);
+    m_control->command.store(static_cast<int>(Command::Stop));
+    m_reports = reinterpret_cast<StepStats*>(base + controlBytes);
+    m_halos = reinterpret_cast<std::uint64_t*>(base + controlBytes + reportBytes);
+    m_grid = reinterpret_cast<std::uint64_t*>(base + controlBytes + reportBytes + haloBytes);
+    if (gridBytes) std::memcpy(m_grid, initial.rowWords(0), gridBytes);
+
+    m_parent = ::getpid();
+    m_running = true;
+    for (int w = 0; w < workers; ++w) {
+        const pid_t pid = ::fork();
+        if (pid < 0) {
+            killWorkers();
+            m_running = false;
+            throw std::runtime_error("Impossible de lancer un processus de calcul");
+        }
+        if (pid == 0) {
+            m_isWorker = true;
+            m_children.clear();
+            int status = 0;
+            try {
+                main(w);
+            } catch (...) {
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        m_children.push_back(pid);
+    }
+}
+
+void SharedMemoryTransport::checkWorkers() {
+    for (pid_t pid : m_children) {
+        int status = 0;
+        if (::waitpid(pid, &status, WNOHANG) == pid) {
+            m_children.erase(std::find(m_children.begin(), m_children.end(), pid));
+            m_failed = true;
+            throw std::runtime_error("Processus de calcul arrete");
+        }
+    }
+}
+
+void SharedMemoryTransport::killWorkers() {
+    for (pid_t pid : m_children) ::kill(pid, SIGKILL);
+    for (pid_t pid : m_children) ::waitpid(pid, nullptr, 0);
+    m_children.clear();
+}
+
+// Barriere a inversion de phase : le dernier arrive remet le compteur a
+// zero puis avance la phase, que les autres attendent.
+void SharedMemoryTransport::sync() {
+    if (m_failed) {
+        throw std::runtime_error("Processus de calcul arrete");
+    }
+    Control& control = *m_control;
+    const unsigned parties = static_cast<unsigned>(m_layout.workers()) + 1;
+    const unsigned phase = control.phase.load(std::memory_order_acquire);
+    if (control.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+        control.arrived.store(0, std::memory_order_relaxed);
+        control.phase.store(phase + 1, std::memory_order_release);
+        return;
+    }
+    for (long spin = 0; control.phase.load(std::memory_order_acquire) == phase; ++spin) {
+        if (spin < kSpins) continue;
+        if (spin < kSpins + kYields) {
+            ::sched_yield();
+            continue;
+        }
+        const struct timespec pause = { 0, 20000 };
+        ::nanosleep(&pause, nullptr);
+        if ((spin - kSpins - kYields) % kCheckEvery != 0) continue;
+        if (m_isWorker) {
+            if (::getppid() != m_parent) ::_exit(1);
+        } else {
+            checkWorkers();
+        }
+    }
+}
+
+std::uint64_t* SharedMemoryTransport::halo(int worker, int parity, int edge) const {
+    const std::size_t slot = (static_cast<std::size_t>(worker) * 2 + parity) * 2 + edge;
+    return m_halos + slot * m_layout.wordsPerRow;
+}
+
+std::uint64_t* SharedMemoryTransport::rows(int firstRow) const {
+    return m_grid + static_cast<std::size_t>(firstRow) * m_layout.wordsPerRow;
+}
+
+void SharedMemoryTransport::sendCommand(Command command) {
+    m_control->command.store(static_cast<int>(command), std::memory_order_relaxed);
+    sync();
+}
+
+void SharedMemoryTransport::receiveReports(std::vector<StepStats>& reports) {
+    sync();
+    reports.assign(m_reports, m_reports + m_layout.workers());
+}
+
+void SharedMemoryTransport::receiveGrid(Grid& grid) {
+    sync();
+    const int total = m_layout.firstRows.back();
+    if (grid.rows() != total || grid.wordsPerRow() != m_layout.wordsPerRow) {
+        throw std::invalid_argument("Grille incompatible avec le decoupage");
+    }
+    if (total > 0) {
+        std::memcpy(grid.rowWords(0), m_grid,
+                    sizeof(std::uint64_t) * static_cast<std::size_t>(total) * m_layout.wordsPerRow);
+    }
+}
+
+void SharedMemoryTransport::stop() {
+    if (!m_running) return;
+    m_running = false;
+    try {
+        sendCommand(Command::Stop);
+    } catch (...) {
+        killWorkers();
+        throw;
+    }
+    for (pid_t pid : m_children) ::waitpid(pid, nullptr, 0);
+    m_children.clear();
+}
+
+void SharedMemoryTransport::receiveStrip(int worker, std::uint64_t* words) {
+    std::memcpy(words, rows(m_layout.firstRows[worker]),
+                sizeof(std::uint64_t) * static_cast<std::size_t>(m_layout.rows(worker))
+                    * m_layout.wordsPerRow);
+}
+
+HaloTransport::Command SharedMemoryTransport::receiveCommand(int) {
+    sync();
+    return static_cast<Command>(m_control->command.load(std::memory_order_relaxed));
+}
+
+void SharedMemoryTransport::sendHalo(int worker, int generation,
+                                     const std::uint64_t* first, const std::uint64_t* last)
+{
+    const std::size_t bytes = sizeof(std::uint64_t) * m_layout.wordsPerRow;
+    std::memcpy(halo(worker, generation & 1, 0), first, bytes);
+    std::memcpy(halo(worker, generation & 1, 1), last, bytes);
+}
+
+void SharedMemoryTransport::receiveHalo(int worker, int generation,
+                                        std::uint64_t* above, std::uint64_t* below)
+{
+    const int workers = m_layout.workers();
+    const std::size_t bytes = sizeof(std::uint64_t) * m_layout.wordsPerRow;
+    std::memcpy(above, halo((worker + workers - 1) % workers, generation & 1, 1), bytes);
+    std::memcpy(below, halo((worker + 1) % workers, generation & 1, 0), bytes);
+}
+
+void SharedMemoryTransport::sendReport(int worker, const StepStats& stats) {
+    m_reports[worker] = stats;
+    sync();
+}
+
+void SharedMemoryTransport::sendStrip(int worker, const std::uint64_t* words) {
+    std::memcpy(rows(m_layout.firstRows[worker]), words,
+                sizeof(std::uint64_t) * static_cast<std::size_t>(m_layout.rows(worker))
+                    * m_layout.wordsPerRow);
+    sync();
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include <vector>
+#include "HaloTransport.h"
+
+// Infrastructure : transport local de DistributedLife (port HaloTransport
+// du domaine). Un processus fils (fork) par travailleur, échanges dans une
+// zone de mémoire partagée anonyme créée avant les fork. Chaque tour est borné par deux barrières partagées
+// (coordinateur compris) ; les lignes de bord sont doublées selon la parité
+// de la génération, si bien qu'un travailleur peut publier celles de la
+// génération suivante pendant que ses voisins lisent encore les siennes.
+//
+// Les attentes tournent brièvement puis dorment par courtes périodes. Le
+// coordinateur vérifie que ses fils sont vivants (std::runtime_error si l'un
+// s'est arrêté) ; un fils dont le coordinateur a disparu se termine.
+//
+// Contrainte : start() doit être appelé tant que le processus n'a qu'un
+// seul thread. Un fils issu d'un fork ne reçoit que le thread appelant ;
+// un verrou (celui de l'allocateur par exemple) tenu par un autre thread à
+// cet instant le resterait pour toujours, alors que le fils alloue (sa
+// bande, ses tampons). Les threads d'export, de points de reprise, de
+// calcul ou d'affichage se créent donc après le moteur.
+class SharedMemoryTransport : public HaloTransport {
+public:
+    SharedMemoryTransport() = default;
+    ~SharedMemoryTransport() override;
+
+    SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+    SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+    void start(const Layout& layout, const Grid& initial, const WorkerMain& main) override;
+    void sendCommand(Command command) override;
+    void receiveReports(std::vector<StepStats>& reports) override;
+    void receiveGrid(Grid& grid) override;
+    void stop() override;
+
+    void receiveStrip(int worker, std::uint64_t* words) override;
+    Command receiveCommand(int worker) override;
+    void sendHalo(int worker, int generation,
+                  const std::uint64_t* first, const std::uint64_t* last) override;
+    void receiveHalo(int worker, int generation,
+                     std::uint64_t* above, std::uint64_t* below) override;
+    void sendReport(int worker, const StepStats& stats) override;
+    void sendStrip(int worker, const std::uint64_t* words) override;
+
+private:
+    struct Control;
+
+    void sync();                 // barrière de tous les processus
+    void checkWorkers();         // coordinateur : un fils s'est-il arrêté ?
+    void killWorkers();
+    std::uint64_t* halo(int worker, int parity, int edge) const;
+    std::uint64_t* rows(int firstRow) const;
+
+    Layout m_layout;
+    void* m_memory = nullptr;
+    std::size_t m_size = 0;
+    Control* m_control = nullptr;
+    StepStats* m_reports = nullptr;
+    std::uint64_t* m_halos = nullptr; // travailleur x parité x (première, dernière) ligne
+    std::uint64_t* m_grid = nullptr;  // grille complète (distribution et collecte)
+    std::vector<pid_t> m_children;    // coordinateur : processus encore à attendre
+    pid_t m_parent = 0;
+    bool m_isWorker = false;
+    bool m_running = false;
+    bool m_failed = false;
+};
@@ -0,0 +1,301 @@
+#include "SimulationLog.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+typedef std::uint64_t u64;
+
+const char kMagic[8] = { 'G', 'O', 'L', 'L', 'O', 'G', 1, 0 };
+const char kIndexMagic[8] = { 'G', 'O', 'L', 'I', 'D', 'X', 1, 0 };
+const std::size_t kHeaderSize = 12;  // magie + intervalle des images
+const std::size_t kTrailerSize = 16; // position de l'index + magie
+const std::size_t kRecordHeaderSize = 9; // type, iteration, taille
+
+const std::uint8_t kKeyframe = 1;
+const std::uint8_t kDelta = 2;
+
+// entiers petit-boutistes de taille fixe, independants de la plateforme
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+void putU64(std::vector<std::uint8_t>& out, u64 v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+void putVarint(std::vector<std::uint8_t>& out, u64 v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+std::uint32_t getU32(const std::uint8_t* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+    return v;
+}
+
+u64 getU64(const std::uint8_t* p) {
+    u64 v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<u64>(p[i]) << (8 * i);
+    return v;
+}
+
+bool getVarint(const std::uint8_t*& p, const std::uint8_t* end, u64& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const std::uint8_t byte = *p++;
+        v |= static_cast<u64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// plages alternees (mots nuls, mots non nuls) : longueurs puis mots bruts
+void encodeWords(const u64* words, std::size_t count, std::vector<std::uint8_t>& out) {
+    std::size_t i = 0;
+    while (i < count) {
+        std::size_t zeros = i;
+        while (zeros < count && words[zeros] == 0) ++zeros;
+        std::size_t literals = zeros;
+        while (literals < count && words[literals] != 0) ++literals;
+        putVarint(out, zeros - i);
+        putVarint(out, literals - zeros);
+        for (std::size_t k = zeros; k < literals; ++k) putU64(out, words[k]);
+        i = literals;
+    }
+}
+
+// decode count mots (remplaces, ou combines par XOR pour un delta)
+bool decodeWords(const std::uint8_t* p, const std::uint8_t* end,
+                 u64* words, std::size_t count, bool xorInto)
+{
+    std::size_t i = 0;
+    while (i < count) {
+        u64 zeros = 0, literals = 0;
+        if (!getVarint(p, end, zeros) || !getVarint(p, end, literals)) return false;
+        if (zeros > count - i || literals > count - i - zeros) return false;
+        if (static_cast<u64>(end - p) < literals * 8) return false;
+        if (!xorInto) std::fill(words + i, words + i + zeros, 0);
+        i += zeros;
+        for (u64 k = 0; k < literals; ++k, ++i, p += 8) {
+            words[i] = xorInto ? words[i] ^ getU64(p) : getU64(p);
+        }
+    }
+    return true;
+}
+
+std::runtime_error corrupted(const std::string& path) {
+    return std::runtime_error("Journal corrompu : " + path);
+}
+
+} // namespace
+
+SimulationLogWriter::SimulationLogWriter(const std::string& path, int keyframeInterval)
+    : m_path(path),
+      m_out(path, std::ios::binary | std::ios::trunc),
+      m_keyframeInterval(std::max(keyframeInterval, 1)),
+      m_sinceKeyframe(0),
+      m_hasPrevious(false),
+      m_closed(false),
+      m_offset(0)
+{
+    if (!m_out) {
+        throw std::runtime_error("Impossible d'ecrire le journal : " + path);
+    }
+    std::vector<std::uint8_t> header(kMagic, kMagic + 8);
+    putU32(header, static_cast<std::uint32_t>(m_keyframeInterval));
+    write(header.data(), header.size());
+}
+
+SimulationLogWriter::~SimulationLogWriter() {
+    try {
+        close();
+    }
+    catch (...) {
+        // destructeur : l'erreur a deja ete signalee par append() ou sera
+        // visible a la lecture (journal sans index)
+    }
+}
+
+void SimulationLogWriter::write(const std::uint8_t* data, std::size_t size) {
+    m_out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!m_out) {
+        throw std::runtime_error("Impossible d'ecrire le journal : " + m_path);
+    }
+    m_offset += size;
+}
+
+void SimulationLogWriter::append(const Grid& grid, int iteration) {
+    if (m_closed) {
+        throw std::runtime_error("Journal deja ferme : " + m_path);
+    }
+    const std::size_t words = static_cast<std::size_t>(grid.rows()) * grid.wordsPerRow();
+    const bool sameShape = m_hasPrevious && grid.rows() == m_previous.rows()
+                        && grid.cols() == m_previous.cols()
+                        && grid.toroidal() == m_previous.toroidal();
+    const bool keyframe = !sameShape || m_sinceKeyframe >= m_keyframeInterval;
+
+    m_payload.clear();
+    m_payload.push_back(keyframe ? kKeyframe : kDelta);
+    putU32(m_payload, static_cast<std::uint32_t>(iteration));
+    putU32(m_payload, 0); // taille, completee ci-dessous
+    if (keyframe) {
+        putU32(m_payload, static_cast<std::uint32_t>(grid.rows()));
+        putU32(m_payload, static_cast<std::uint32_t>(grid.cols()));
+        m_payload.push_back(grid.toroidal() ? 1 : 0);
+        encodeWords(words ? grid.rowWords(0) : nullptr, words, m_payload);
+        m_sinceKeyframe = 1;
+    } else {
+        m_delta.resize(words);
+        const u64* now = grid.rowWords(0);
+        const u64* before = m_previous.rowWords(0);
+        for (std::size_t i = 0; i < words; ++i) m_delta[i] = now[i] ^ before[i];
+        encodeWords(m_delta.data(), words, m_payload);
+        ++m_sinceKeyframe;
+    }
+    const std::uint32_t size = static_cast<std::uint32_t>(m_payload.size() - kRecordHeaderSize);
+    for (int i = 0; i < 4; ++i) m_payload[5 + i] = static_cast<std::uint8_t>(size >> (8 * i));
+
+    m_index.push_back(IndexEntry{ iteration, keyframe ? kKeyframe : kDelta, m_offset });
+    write(m_payload.data(), m_payload.size());
+
+    if (sameShape) {
+        // meme forme : copie mot a mot, sans reallocation
+        std::copy(grid.rowWords(0), grid.rowWords(0) + words, m_previous.rowWords(0));
+    } else {
+        m_previous = grid;
+    }
+    m_hasPrevious = true;
+}
+
+void SimulationLogWriter::close() {
+    if (m_closed) return;
+    m_closed = true;
+    std::vector<std::uint8_t> index;
+    putU32(index, static_cast<std::uint32_t>(m_index.size()));
+    for (const IndexEntry& e : m_index) {
+        putU32(index, static_cast<std::uint32_t>(e.iteration));
+        index.push_back(e.type);
+        putU64(index, e.offset);
+    }
+    putU64(index, m_offset);
+    index.insert(index.end(), kIndexMagic, kIndexMagic + 8);
+    write(index.data(), index.size());
+    m_out.close();
+}
+
+SimulationLogReader::SimulationLogReader(const std::string& path)
+    : m_path(path),
+      m_hasIndex(false)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Impossible d'ouvrir le journal : " + path);
+    }
+    in.seekg(0, std::ios::end);
+    const u64 fileSize = static_cast<u64>(in.tellg());
+    in.seekg(0);
+
+    std::uint8_t header[kHeaderSize];
+    if (fileSize < kHeaderSize || !in.read(reinterpret_cast<char*>(header), kHeaderSize)
+        || !std::equal(kMagic, kMagic + 8, reinterpret_cast<const char*>(header))) {
+        throw std::runtime_error("Fichier de journal invalide : " + path);
+    }
+
+    // index en fin de fichier
+    if (fileSize >= kHeaderSize + kTrailerSize) {
+        std::uint8_t trailer[kTrailerSize];
+        in.seekg(static_cast<std::streamoff>(fileSize - kTrailerSize));
+        if (in.read(reinterpret_cast<char*>(trailer), kTrailerSize)
+            && std::equal(kIndexMagic, kIndexMagic + 8, reinterpret_cast<const char*>(trailer + 8))) {
+            const u64 indexOffset = getU64(trailer);
+            if (indexOffset < kHeaderSize || indexOffset + 4 + kTrailerSize > fileSize) {
+                throw corrupted(path);
+            }
+            std::vector<std::uint8_t> index(fileSize - kTrailerSize - indexOffset);
+            in.seekg(static_cast<std::streamoff>(indexOffset));
+            if (!in.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(index.size()))) {
+                throw corrupted(path);
+            }
+            const std::uint32_t count = getU32(index.data());
+            if (index.size() != 4 + static_cast<u64>(count) * 13) throw corrupted(path);
+            for (std::uint32_t i = 0; i < count; ++i) {
+                const std::uint8_t* e = index.data() + 4 + i * 13;
+                m_records.push_back(Record{ static_cast<std::int32_t>(getU32(e)), e[4], getU64(e + 5) });
+            }
+            m_hasIndex = true;
+        }
+    }
+
+    // journal interrompu : parcours des enregistrements complets
+    if (!m_hasIndex) {
+        in.clear();
+        u64 offset = kHeaderSize;
+        std::uint8_t head[kRecordHeaderSize];
+        while (offset + kRecordHeaderSize <= fileSize) {
+            in.seekg(static_cast<std::streamoff>(offset));
+            if (!in.read(reinterpret_cast<char*>(head), kRecordHeaderSize)) break;
+            const u64 size = getU32(head + 5);
+            if ((head[0] != kKeyframe && head[0] != kDelta)
+                || offset + kRecordHeaderSize + size > fileSize) break;
+            m_records.push_back(Record{ static_cast<std::int32_t>(getU32(head + 1)), head[0], offset });
+            offset += kRecordHeaderSize + size;
+        }
+    }
+
+    if (!m_records.empty() && m_records.front().type != kKeyframe) throw corrupted(path);
+    for (const Record& r : m_records) m_iterations.push_back(r.iteration);
+}
+
+Grid SimulationLogReader::read(int iteration) const {
+    std::size_t target = m_records.size();
+    for (std::size_t i = m_records.size(); i-- > 0;) {
+        if (m_records[i].iteration == iteration) { target = i; break; }
+    }
+    if (target == m_records.size()) {
+        throw std::out_of_range("Generation absente du journal : " + std::to_string(iteration));
+    }
+    std::size_t first = target;
+    while (m_records[first].type != kKeyframe) --first;
+
+    std::ifstream in(m_path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Impossible d'ouvrir le journal : " + m_path);
+    }
+    Grid grid;
+    std::vector<std::uint8_t> payload;
+    for (std::size_t i = first; i <= target; ++i) {
+        std::uint8_t head[kRecordHeaderSize];
+        in.seekg(static_cast<std::streamoff>(m_records[i].offset));
+        if (!in.read(reinterpret_cast<char*>(head), kRecordHeaderSize) || head[0] != m_records[i].type) {
+            throw corrupted(m_path);
+        }
+        payload.resize(getU32(head + 5));
+        if (!in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+            throw corrupted(m_path);
+        }
+        const std::uint8_t* p = payload.data();
+        const std::uint8_t* end = p + payload.size();
+        if (head[0] == kKeyframe) {
+            if (payload.size() < 9) throw corrupted(m_path);
+            const std::uint32_t rows = getU32(p);
+            const std::uint32_t cols = getU32(p + 4);
+            if (rows > 0x7FFFFFFFu || cols > 0x7FFFFFFFu) throw corrupted(m_path);
+            grid = Grid(static_cast<int>(rows), static_cast<int>(cols), p[8] != 0);
+            p += 9;
+        }
+        const std::size_t words = static_cast<std::size_t>(grid.rows()) * grid.wordsPerRow();
+        if (!decodeWords(p, end, words ? grid.rowWords(0) : nullptr, words, head[0] == kDelta)) {
+            throw corrupted(m_path);
+        }
+    }
+    // bits de bourrage nuls meme si le fichier a ete altere
+    if (grid.cols() & 63)
+        for (int r = 0; r < grid.rows(); ++r)
+            grid.rowWords(r)[grid.wordsPerRow() - 1] &= grid.lastWordMask();
+    return grid;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Grid.h"
+
+// Journal binaire d'une simulation, en un seul fichier en ajout seul :
+//   en-tête | enregistrements | index | fin (position de l'index)
+// Un enregistrement est une image complète (périodique, ou dès que les
+// dimensions changent) ou un delta XOR avec la génération précédente. Les
+// mots de 64 cellules sont codés par plages de mots nuls / non nuls
+// (longueurs en varint), si bien qu'un delta ne coûte que les mots modifiés.
+// L'index final permet un accès direct à toute génération ; sans lui
+// (écriture interrompue), le lecteur parcourt les enregistrements.
+class SimulationLogWriter {
+public:
+    // keyframeInterval : une image complète toutes les N générations
+    SimulationLogWriter(const std::string& path, int keyframeInterval = 64);
+    ~SimulationLogWriter(); // écrit l'index si close() n'a pas été appelé
+
+    SimulationLogWriter(const SimulationLogWriter&) = delete;
+    SimulationLogWriter& operator=(const SimulationLogWriter&) = delete;
+
+    void append(const Grid& grid, int iteration);
+    void close(); // écrit l'index et ferme le fichier
+
+    std::uint64_t bytesWritten() const { return m_offset; }
+
+private:
+    struct IndexEntry {
+        std::int32_t iteration;
+        std::uint8_t type;
+        std::uint64_t offset;
+    };
+
+    std::string m_path;
+    std::ofstream m_out;
+    int m_keyframeInterval;
+    int m_sinceKeyframe;
+    bool m_hasPrevious;
+    bool m_closed;
+    Grid m_previous;
+    std::vector<IndexEntry> m_index;
+    std::vector<std::uint64_t> m_delta;   // réutilisés d'un appel à l'autre
+    std::vector<std::uint8_t> m_payload;
+    std::uint64_t m_offset;
+
+    void write(const std::uint8_t* data, std::size_t size);
+};
+
+class SimulationLogReader {
+public:
+    // lève std::runtime_error si le fichier est illisible ou corrompu
+    explicit SimulationLogReader(const std::string& path);
+
+    const std::vector<int>& iterations() const { return m_iterations; }
+    bool hasIndex() const { return m_hasIndex; } // faux : journal interrompu
+
+    // génération iteration (image précédente + deltas) ; lève
+    // std::out_of_range si elle n'est pas dans le journal
+    Grid read(int iteration) const;
+
+private:
+    struct Record {
+        std::int32_t iteration;
+        std::uint8_t type;
+        std::uint64_t offset;
+    };
+
+    std::string m_path;
+    std::vector<Record> m_records;
+    std::vector<int> m_iterations;
+    bool m_hasIndex;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "IEngineResources.h"
+#include "SharedMemoryTransport.h"
+#include "TiledGridFile.h"
+
+// Infrastructure : ressources des moteurs sur la machine locale (processus
+// fils et mémoire partagée, fichiers de tuiles projetés en mémoire).
+class SystemEngineResources : public IEngineResources {
+public:
+    std::unique_ptr<HaloTransport> createTransport() const override {
+        return std::make_unique<SharedMemoryTransport>();
+    }
+    std::unique_ptr<TileStore> openTiles(const std::string& path) const override {
+        return std::make_unique<TiledGridFile>(path);
+    }
+    std::unique_ptr<TileStore> createTiles(const std::string& path, int rows, int cols,
+                                           bool toroidal, const RuleSpec& rule) const override {
+        TiledGridFile::create(path, rows, cols, toroidal, rule);
+        return std::make_unique<TiledGridFile>(path);
+    }
+};
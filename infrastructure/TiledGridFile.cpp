@@ -0,0 +1,189 @@
+#include "TiledGridFile.h"
+#include "StepStats.h"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct TiledGridFile::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::int64_t rows;
+    std::int64_t cols;
+    std::int64_t generation;
+    std::int64_t population;
+    std::uint64_t hash;
+    char rule[64];
+};
+
+namespace {
+
+const char kMagic[8] = { 'G', 'O', 'L', 'T', 'I', 'L', 'E', 'S' };
+const std::uint32_t kVersion = 1;
+const std::uint32_t kToroidal = 1;
+const std::uint32_t kStepping = 2;
+const std::size_t kHeaderBytes = 4096; // les tuiles commencent sur une page
+const std::size_t kTileBytes = TiledGridFile::kTileSide * sizeof(std::uint64_t);
+
+std::size_t fileSize(long long rows, long long cols) {
+    const std::size_t tileRows = static_cast<std::size_t>((rows + 63) / 64);
+    const std::size_t tileCols = static_cast<std::size_t>((cols + 63) / 64);
+    return kHeaderBytes + tileRows * tileCols * kTileBytes;
+}
+
+} // namespace
+
+void TiledGridFile::create(const std::string& path, int rows, int cols, bool toroidal,
+                           const RuleSpec& rule)
+{
+    static_assert(sizeof(Header) <= kHeaderBytes, "en-tete trop grand");
+    if (rows <= 0 || cols <= 0) {
+        throw std::invalid_argument("Dimensions de grille invalides");
+    }
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.flags = toroidal ? kToroidal : 0;
+    header.rows = rows;
+    header.cols = cols;
+    const std::string ruleText = rule.toString();
+    if (ruleText.size() >= sizeof(header.rule)) {
+        throw std::invalid_argument("Regle trop longue pour le fichier de tuiles");
+    }
+    std::memcpy(header.rule, ruleText.c_str(), ruleText.size());
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible de creer le fichier : " + path);
+    }
+    // fichier creux : les tuiles vides n'occupent pas le disque
+    const bool ok = ::ftruncate(fd, static_cast<off_t>(fileSize(rows, cols))) == 0
+                 && ::pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + path);
+    }
+}
+
+TiledGridFile::TiledGridFile(const std::string& path)
+    : m_path(path)
+{
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier : " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)
+        || static_cast<std::size_t>(info.st_size) < kHeaderBytes) {
+        ::close(fd);
+        throw std::runtime_error("Fichier de tuiles invalide : " + path);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    void* p = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("Impossible de projeter le fichier : " + path);
+    }
+    m_memory = p;
+
+    const Header& h = *header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion
+        || h.rows <= 0 || h.cols <= 0 || h.rows > 0x7FFFFFFF || h.cols > 0x7FFFFFFF
+        || fileSize(h.rows, h.cols) != m_size || h.rule[sizeof(h.rule) - 1] != 0) {
+        ::munmap(m_memory, m_size);
+        throw std::runtime_error("Fichier de tuiles invalide : " + path);
+    }
+    if (h.flags & kStepping) {
+        ::munmap(m_memory, m_size);
+        throw std::runtime_error("Generation interrompue dans le fichier : " + path);
+    }
+    m_rows = static_cast<int>(h.rows);
+    m_cols = static_cast<int>(h.cols);
+    m_toroidal = (h.flags & kToroidal) != 0;
+    m_tileCols = (m_cols + kTileSide - 1) / kTileSide;
+    m_tiles = reinterpret_cast<std::uint64_t*>(static_cast<char*>(m_memory) + kHeaderBytes);
+    // parcours par rangees de tuiles successives
+    ::madvise(m_memory, m_size, MADV_SEQUENTIAL);
+}
+
+TiledGridFile::~TiledGridFile() {
+    if (!m_memory) return;
+    ::msync(m_memory, m_size, MS_SYNC);
+    ::munmap(m_memory, m_size);
+}
+
+RuleSpec TiledGridFile::rule() const {
+    return RuleSpec::parse(header()->rule);
+}
+
+long long TiledGridFile::generation() const { return header()->generation; }
+long long TiledGridFile::population() const { return header()->population; }
+std::uint64_t TiledGridFile::hash() const { return header()->hash; }
+
+bool TiledGridFile::isAlive(int r, int c) const {
+    return (tile(r / kTileSide, c / kTileSide)[r % kTileSide] >> (c % kTileSide)) & 1u;
+}
+
+void TiledGridFile::setAlive(int r, int c, bool alive) {
+    std::uint64_t& word = tile(r / kTileSide, c / kTileSide)[r % kTileSide];
+    const std::uint64_t bit = std::uint64_t(1) << (c % kTileSide);
+    const std::uint64_t after = alive ? (word | bit) : (word & ~bit);
+    if (after == word) return;
+    // meme indice de mot que Grid : empreintes comparables
+    const std::uint64_t index = static_cast<std::uint64_t>(r) * m_tileCols + c / kTileSide;
+    Header& h = *header();
+    h.population += alive ? 1 : -1;
+    h.hash += wordHash(index, after) - wordHash(index, word);
+    word = after;
+}
+
+void TiledGridFile::place(const Grid& pattern, int top, int left) {
+    for (int r = 0; r < pattern.rows(); ++r) {
+        const std::uint64_t* words = pattern.rowWords(r);
+        for (int w = 0; w < pattern.wordsPerRow(); ++w)
+            for (std::uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                const int c = w * 64 + __builtin_ctzll(bits);
+                const long long gr = static_cast<long long>(top) + r;
+                const long long gc = static_cast<long long>(left) + c;
+                if (gr < 0 || gr >= m_rows || gc < 0 || gc >= m_cols) {
+                    throw std::invalid_argument("Motif hors de la grille");
+                }
+                setAlive(static_cast<int>(gr), static_cast<int>(gc), true);
+            }
+    }
+}
+
+void TiledGridFile::beginStep() {
+    header()->flags |= kStepping;
+}
+
+void TiledGridFile::endStep(long long generation, long long population, std::uint64_t hash) {
+    Header& h = *header();
+    h.generation = generation;
+    h.population = population;
+    h.hash = hash;
+    h.flags &= ~kStepping;
+}
+
+void TiledGridFile::release(int tileRow) const {
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t bandBytes = static_cast<std::size_t>(m_tileCols) * kTileBytes;
+    const std::size_t begin = kHeaderBytes + static_cast<std::size_t>(tileRow) * bandBytes;
+    // pages entierement comprises dans la rangee
+    const std::size_t first = (begin + page - 1) / page * page;
+    const std::size_t last = (begin + bandBytes) / page * page;
+    if (last > first) {
+        // projection partagee : les pages modifiees restent dans le cache du fichier
+        ::madvise(static_cast<char*>(m_memory) + first, last - first, MADV_DONTNEED);
+    }
+}
+
+void TiledGridFile::flush() {
+    if (::msync(m_memory, m_size, MS_SYNC) != 0) {
+        throw std::runtime_error("Impossible d'ecrire le fichier : " + m_path);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Grid.h"
+#include "RuleSpec.h"
+#include "TileStore.h"
+
+// Infrastructure : stockage en tuiles de TiledLife (port TileStore du
+// domaine) dans un fichier projeté en mémoire (mmap). Les tuiles d'une même
+// rangée sont contiguës ; un en-tête de 4096 octets porte les dimensions,
+// le mode torique, la règle, la génération, la population et l'empreinte.
+//
+// Seules les pages touchées sont chargées : la taille de la grille n'est
+// bornée que par le disque. Le fichier est créé creux (tuiles vides non
+// écrites) et constitue à lui seul l'export de la simulation.
+class TiledGridFile : public TileStore {
+public:
+    // crée (ou remplace) un fichier de grille vide, génération 0
+    static void create(const std::string& path, int rows, int cols, bool toroidal,
+                       const RuleSpec& rule);
+    // ouvre en lecture/écriture ; lève std::runtime_error si le fichier
+    // n'est pas une grille en tuiles ou si une génération y a été
+    // interrompue
+    explicit TiledGridFile(const std::string& path);
+    ~TiledGridFile() override;
+
+    TiledGridFile(const TiledGridFile&) = delete;
+    TiledGridFile& operator=(const TiledGridFile&) = delete;
+
+    const std::string& path() const { return m_path; }
+    int rows() const override { return m_rows; }
+    int cols() const override { return m_cols; }
+    bool toroidal() const override { return m_toroidal; }
+    RuleSpec rule() const override;
+
+    long long generation() const override;
+    long long population() const override;
+    std::uint64_t hash() const override;
+
+    std::uint64_t* tile(int tileRow, int tileCol) override {
+        return m_tiles + (static_cast<std::size_t>(tileRow) * m_tileCols + tileCol) * kTileSide;
+    }
+    const std::uint64_t* tile(int tileRow, int tileCol) const override {
+        return m_tiles + (static_cast<std::size_t>(tileRow) * m_tileCols + tileCol) * kTileSide;
+    }
+
+    bool isAlive(int r, int c) const;
+    void setAlive(int r, int c, bool alive); // met à jour population et empreinte
+    void place(const Grid& pattern, int top, int left) override;
+
+    // un fichier fermé entre les deux appels est refusé à l'ouverture
+    void beginStep() override;
+    void endStep(long long generation, long long population, std::uint64_t hash) override;
+
+    // libère les pages de la rangée (elles restent dans le fichier et
+    // seront relues au besoin)
+    void release(int tileRow) const override;
+    void flush() override; // écriture synchrone des pages modifiées
+
+private:
+    struct Header;
+
+    Header* header() const { return static_cast<Header*>(m_memory); }
+
+    std::string m_path;
+    void* m_memory = nullptr;
+    std::size_t m_size = 0;
+    std::uint64_t* m_tiles = nullptr;
+    int m_rows = 0;
+    int m_cols = 0;
+    bool m_toroidal = false;
+    int m_tileCols = 0;
+};
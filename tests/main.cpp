@@ -1,14 +1,67 @@
 #include "Grid.h"
 #include "GameOfLife.h"
 #include "ConwayRule.h"
+#include "LifeRule.h"
+#include "RuleSpec.h"
 #include "AliveState.h"
 #include "DeadState.h"
+#include "LifeKernel.h"
+#include "GenerationsLife.h"
+#include "HashLife.h"
+#include "SparseLife.h"
+#include "RandomSoup.h"
+#include "DensityMap.h"
+#include "EnsembleLife.h"
+#include "WorkStealingScheduler.h"
+#include "BatchService.h"
+#include "BatchManifest.h"
+#include "CensusService.h"
+#include "DistributedLife.h"
+#include "SharedMemoryTransport.h"
+#include "TiledLife.h"
+#include "TiledGridFile.h"
+#include "ObjectClassifier.h"
+#include "ObjectShape.h"
+#include "GridExporter.h"
+#include "InitialStateLoader.h"
+#include "SimulationLog.h"
+#include "SimulationMetrics.h"
+#include "IMetricsSink.h"
+#include "MetricsFileSink.h"
+#include "AsyncGridExporter.h"
+#include "CheckpointFile.h"
+#include "FileCheckpointStore.h"
+#include "TripleBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cassert>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+// Count heap allocations so tests can check that hot paths do not allocate
+static std::atomic<long long> g_allocations(0);
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
 // Minimal assertion helper for tests
 static void expect(bool condition, const std::string& message) {
     if (!condition) {
@@ -125,11 +178,1432 @@ static void test_lonely_cell_dies() {
     logOk();
 }
 
+static void test_packed_storage_across_words() {
+    logCase("Packed storage handles word boundaries and toroidal wrap");
+    // 130 columns span three 64-bit words per row
+    Grid g(3, 130, true);
+    g.setAlive(1, 63, true);
+    g.setAlive(1, 64, true);
+    g.setAlive(0, 129, true);
+    g.at(2, 0).setState(new AliveState());
+    expect(g.population() == 4, "population counts every live bit");
+    expect(g.at(1, 64).isAlive() && !g.at(1, 65).isAlive(), "bit addressing");
+    expect(g.countAliveNeighbors(1, 63) == 1, "neighbour across word boundary");
+    expect(g.countAliveNeighbors(1, 0) == 2, "toroidal wrap to last column");
+    Grid copy = g;
+    expect(copy.equals(g), "copy equals original");
+    copy.setAlive(1, 64, false);
+    expect(!copy.equals(g), "copy is independent from original");
+    logOk();
+}
+
+// Deterministic pseudo-random grid (about one third alive)
+static Grid randomGrid(int rows, int cols, bool toroidal, unsigned seed) {
+    Grid g(rows, cols, toroidal);
+    unsigned state = seed;
+    for (int y = 0; y < rows; ++y)
+        for (int x = 0; x < cols; ++x) {
+            state = state * 1103515245u + 12345u;
+            g.setAlive(y, x, ((state >> 16) % 3) == 0);
+        }
+    return g;
+}
+
+static void test_bitwise_kernel_matches_rule() {
+    logCase("Bitwise kernel is bit-exact with ConwayRule (all ISAs, both edge modes)");
+    const LifeKernel::Isa isas[] = { LifeKernel::Isa::Scalar, LifeKernel::Isa::Sse2, LifeKernel::Isa::Avx2 };
+    const int widths[] = { 1, 2, 5, 63, 64, 65, 130, 300, 333 };
+    for (LifeKernel::Isa isa : isas) {
+        LifeKernel::forceIsa(isa);
+        for (int toroidal = 0; toroidal < 2; ++toroidal)
+            for (int cols : widths)
+            for (int rows = 1; rows <= 7; rows += 3) {
+                Grid g = randomGrid(rows, cols, toroidal != 0, 17u + cols + rows);
+                GameOfLife reference(g, std::make_unique<ConwayRule>(), 100, StepKernel::PerCellRule);
+                GameOfLife fast(g, std::make_unique<ConwayRule>(), 100, StepKernel::Bitwise);
+                expect(fast.usesBitwiseKernel(), "ConwayRule should select the bitwise kernel");
+                for (int i = 0; i < 6; ++i) {
+                    reference.step();
+                    fast.step();
+                    if (!fast.currentGrid().equals(reference.currentGrid())) {
+                        std::cerr << "Kernel mismatch isa=" << LifeKernel::isaName(isa)
+                                  << " rows=" << rows << " cols=" << cols
+                                  << " toroidal=" << toroidal << "\n";
+                        std::exit(1);
+                    }
+                }
+            }
+    }
+    LifeKernel::forceIsa(LifeKernel::bestIsa());
+    logOk();
+}
+
+static void test_threaded_step_matches_serial() {
+    logCase("Multi-threaded stepping is identical to the serial path");
+    // large enough to be split into several row bands
+    for (int toroidal = 0; toroidal < 2; ++toroidal) {
+        Grid g = randomGrid(200, 300, toroidal != 0, 99u);
+        const StepKernel kernels[] = { StepKernel::Bitwise, StepKernel::PerCellRule };
+        for (StepKernel kernel : kernels) {
+            GameOfLife serial(g, std::make_unique<ConwayRule>(), 100, kernel, 1);
+            GameOfLife parallel(g, std::make_unique<ConwayRule>(), 100, kernel, 4);
+            expect(parallel.threads() == 4, "pool should own the requested threads");
+            for (int i = 0; i < 5; ++i) {
+                serial.step();
+                parallel.step();
+                expect(parallel.currentGrid().equals(serial.currentGrid()),
+                       "parallel generation differs from serial");
+            }
+        }
+    }
+    logOk();
+}
+
+static void test_step_swaps_buffers_without_copy() {
+    logCase("Step writes into the back buffer and swaps (no grid copy)");
+    Grid g = makeGrid({
+        "00000",
+        "00000",
+        "01110",
+        "00000",
+        "00000"
+    });
+    GameOfLife life(g, std::make_unique<ConwayRule>(), 10);
+    const Grid& current = life.currentGrid();
+    const std::uint64_t* front = current.rowWords(0);
+    life.step();
+    const std::uint64_t* back = current.rowWords(0);
+    expect(front != back, "first step should publish the back buffer");
+    life.step();
+    expect(current.rowWords(0) == front, "buffers should alternate between two allocations");
+    expectGrid(current, {
+        "00000",
+        "00000",
+        "01110",
+        "00000",
+        "00000"
+    }, "blinker after two swaps");
+    expect(!life.isStable(), "blinker is not a still life");
+    logOk();
+}
+
+static void test_cycle_detection() {
+    logCase("Incremental stats detect still lifes and oscillator periods");
+    Grid blinker = makeGrid({
+        "00000",
+        "00000",
+        "01110",
+        "00000",
+        "00000"
+    });
+    GameOfLife life(blinker, std::make_unique<ConwayRule>(), 100);
+    life.step();
+    expect(life.lastStepStats().births == 2 && life.lastStepStats().deaths == 2,
+           "blinker flips two cells each way");
+    expect(life.population() == 3, "population tracked incrementally");
+    expect(life.detectedPeriod() == 0, "no cycle after one step");
+    life.step();
+    expect(life.detectedPeriod() == 2, "blinker has period 2");
+    expect(!life.hasFinished(), "GameOfLife::hasFinished only stops on still lifes");
+
+    Grid block = makeGrid({
+        "0000",
+        "0110",
+        "0110",
+        "0000"
+    });
+    GameOfLife still(block, std::make_unique<ConwayRule>(), 100, StepKernel::PerCellRule);
+    still.step();
+    expect(still.detectedPeriod() == 1, "still life has period 1");
+    expect(still.lastStepStats().changed() == 0, "no changed cells in a still life");
+    logOk();
+}
+
+static void test_active_tiles_skip_quiescent_regions() {
+    logCase("Active tiles: only changing regions are recomputed, results unchanged");
+    for (int toroidal = 0; toroidal < 2; ++toroidal) {
+        // glider crossing the top-left corner (wraps when toroidal) and a
+        // small random patch; the rest of the universe is empty
+        Grid g(640, 2048, toroidal != 0);
+        const int glider[5][2] = { {0, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2} };
+        for (const auto& cell : glider) g.setAlive(635 + cell[0], 2042 + cell[1], true);
+        Grid patch = randomGrid(20, 40, false, 7u);
+        for (int y = 0; y < 20; ++y)
+            for (int x = 0; x < 40; ++x)
+                g.setAlive(300 + y, 1000 + x, patch.isAlive(y, x));
+
+        GameOfLife life(g, std::make_unique<ConwayRule>(), 1000, StepKernel::Bitwise, 2);
+        GameOfLife perCell(g, std::make_unique<ConwayRule>(), 1000, StepKernel::PerCellRule);
+        Grid reference = g;
+        Grid scratch = g;
+        for (int i = 0; i < 40; ++i) {
+            LifeKernel::step(reference, scratch);
+            reference.swap(scratch);
+            life.step();
+            if (i < 8) {
+                perCell.step();
+                expect(perCell.currentGrid().equals(reference), "per-cell path with tiles diverged");
+            }
+            expect(life.currentGrid().equals(reference), "tiled step diverged from full step");
+        }
+        expect(life.activeTiles() > 0, "some tiles stay active");
+        expect(life.activeTiles() * 3 < life.tileCount(), "most tiles should be skipped");
+    }
+    logOk();
+}
+
+static void test_sparse_universe_matches_dense_and_grows() {
+    logCase("Sparse universe matches the dense engine and follows escaping gliders");
+    // random patch far from the dense grid edges: both engines must agree
+    Grid patch = randomGrid(40, 70, false, 3u);
+    Grid dense(300, 300, false);
+    for (int y = 0; y < 40; ++y)
+        for (int x = 0; x < 70; ++x)
+            dense.setAlive(130 + y, 115 + x, patch.isAlive(y, x));
+    GameOfLife reference(dense, std::make_unique<ConwayRule>(), 100);
+    SparseLife sparse(dense, 100);
+    for (int i = 0; i < 30; ++i) {
+        reference.step();
+        sparse.step();
+        expect(sparse.window(0, 0, 300, 300).equals(reference.currentGrid()),
+               "sparse generation differs from dense");
+        expect(sparse.population() == reference.population(), "population mismatch");
+    }
+
+    // glider heading up-left leaves the initial area into negative coordinates
+    Grid glider = makeGrid({
+        "111",
+        "100",
+        "010"
+    });
+    SparseLife universe(glider, 1000);
+    for (int i = 0; i < 400; ++i) universe.step();
+    BoundingBox box = universe.boundingBox();
+    expect(box.top == -100 && box.left == -100, "glider moved 100 cells diagonally");
+    expect(box.rows() == 3 && box.cols() == 3, "glider keeps its 3x3 box");
+    expectGrid(universe.currentGrid(), {
+        "111",
+        "100",
+        "010"
+    }, "glider shape after 400 generations");
+    expect(universe.tileCount() <= 4, "only the chunks around the glider are stored");
+    logOk();
+}
+
+static void test_sparse_gliders_cross_chunk_corners() {
+    logCase("Sparse universe: gliders crossing chunk corners wake the right neighbours");
+    // one glider per direction, each passing diagonally through the corner
+    // shared by four 64x64 chunks; the dense engine is the reference
+    struct Crossing {
+        int dr, dc;
+        std::vector<std::string> shape;
+    };
+    const Crossing crossings[] = {
+        { 1, 1, { ".O.", "..O", "OOO" } },
+        { 1, -1, { ".O.", "O..", "OOO" } },
+        { -1, 1, { "OOO", "..O", ".O." } },
+        { -1, -1, { "OOO", "O..", ".O." } },
+    };
+    const int corners[4][2] = { { 64, 64 }, { 64, 192 }, { 192, 64 }, { 192, 192 } };
+    Grid dense(256, 256, false);
+    for (int i = 0; i < 4; ++i) {
+        // glider centre six cells before the corner: it reaches it after 24 generations
+        const int top = corners[i][0] - 6 * crossings[i].dr - 1;
+        const int left = corners[i][1] - 6 * crossings[i].dc - 1;
+        for (int y = 0; y < 3; ++y)
+            for (int x = 0; x < 3; ++x)
+                dense.setAlive(top + y, left + x, crossings[i].shape[y][x] == 'O');
+    }
+    GameOfLife reference(dense, std::make_unique<ConwayRule>(), 100);
+    SparseLife sparse(dense, 100);
+    for (int i = 0; i < 60; ++i) {
+        reference.step();
+        sparse.step();
+        if (i == 0) expect(sparse.activeTiles() == 4, "gliders away from edges wake no neighbour");
+        expect(sparse.window(0, 0, 256, 256).equals(reference.currentGrid()),
+               "sparse generation differs from dense at a chunk corner");
+        expect(sparse.population() == reference.population(), "population mismatch");
+    }
+    expect(sparse.population() == 20, "four gliders survive the crossing");
+
+    // with B1 a lone corner cell gives birth in the diagonal chunk
+    const RuleSpec b1 = RuleSpec::parse("B1/S");
+    Grid corner(256, 256, false);
+    corner.setAlive(127, 127, true);
+    GameOfLife b1Reference(corner, std::make_unique<LifeRule>(b1), 100);
+    SparseLife b1Sparse(corner, 100, 64, b1);
+    for (int i = 0; i < 8; ++i) {
+        b1Reference.step();
+        b1Sparse.step();
+        expect(b1Sparse.window(0, 0, 256, 256).equals(b1Reference.currentGrid()),
+               "B1 birth across a chunk corner");
+    }
+    logOk();
+}
+
+static void test_hashlife_matches_sparse_and_jumps() {
+    logCase("HashLife matches the sparse engine and jumps 2^k generations");
+    Grid patch = randomGrid(40, 70, false, 5u);
+    SparseLife sparse(patch, 1000);
+    HashLife single(patch, 1000);
+    for (int i = 0; i < 40; ++i) {
+        sparse.step();
+        single.step();
+        expect(single.window(-40, -40, 120, 150).equals(sparse.window(-40, -40, 120, 150)),
+               "hashlife generation differs from sparse");
+        expect(single.population() == sparse.population(), "population mismatch");
+    }
+
+    // 2^5 generations per step must land on the same state
+    HashLife jumping(patch, 1000, 5);
+    SparseLife reference(patch, 1000);
+    for (int i = 0; i < 4; ++i) {
+        jumping.step();
+        for (int g = 0; g < 32; ++g) reference.step();
+        expect(jumping.generation() == static_cast<unsigned long long>(32 * (i + 1)),
+               "generation counter");
+        BoundingBox expected = reference.boundingBox();
+        BoundingBox actual = jumping.boundingBox();
+        expect(actual.top == expected.top && actual.left == expected.left
+               && actual.bottom == expected.bottom && actual.right == expected.right,
+               "bounding boxes differ after a jump");
+        expect(jumping.window(expected.top, expected.left, static_cast<int>(expected.rows()),
+                              static_cast<int>(expected.cols()))
+                   .equals(reference.currentGrid()),
+               "hashlife jump differs from sparse");
+    }
+
+    // glider: 2^20 generations move it 2^18 cells up-left
+    Grid glider = makeGrid({
+        "111",
+        "100",
+        "010"
+    });
+    HashLife far(glider, 1 << 30, 20);
+    far.step();
+    BoundingBox box = far.boundingBox();
+    expect(box.top == -(1LL << 18) && box.left == -(1LL << 18), "glider moved 2^18 cells");
+    expectGrid(far.currentGrid(), {
+        "111",
+        "100",
+        "010"
+    }, "glider shape after 2^20 generations");
+
+    // a tiny node budget forces collections without changing the result
+    HashLife bounded(patch, 1000, 3, 2000);
+    SparseLife check(patch, 1000);
+    for (int i = 0; i < 6; ++i) {
+        bounded.step();
+        for (int g = 0; g < 8; ++g) check.step();
+    }
+    expect(bounded.collections() > 0, "garbage collection ran");
+    expect(bounded.window(-60, -60, 160, 190).equals(check.window(-60, -60, 160, 190)),
+           "state survives garbage collection");
+    logOk();
+}
+
+static void test_life_like_rules() {
+    logCase("Life-like rulestrings: parsing and bit-exact specialised/generic kernels");
+    RuleSpec highLife = RuleSpec::parse("B36/S23");
+    expect(highLife.birth == ((1u << 3) | (1u << 6)) && highLife.survival == ((1u << 2) | (1u << 3)),
+           "B36/S23 masks");
+    expect(RuleSpec::parse("s23/b3").isConway(), "S/B order and lower case");
+    expect(RuleSpec::parse("23/3").isConway(), "classic survival/birth notation");
+    expect(RuleSpec::parse("B3678/S34678").toString() == "B3678/S34678", "round trip");
+    expect(RuleSpec::parse("B2/S").toString() == "B2/S", "empty survival set");
+    const char* invalid[] = { "", "B3", "B39/S23", "B3/S23/X", "B3/B3", "B3/23", "Q3/S23" };
+    for (const char* text : invalid) {
+        bool threw = false;
+        try { RuleSpec::parse(text); } catch (const std::invalid_argument&) { threw = true; }
+        expect(threw, std::string("invalid rulestring accepted: ") + text);
+    }
+
+    // specialised rules and one generic (B2/S34, not in the table), each
+    // against the per-cell LifeRule on every ISA and both edge modes
+    const char* rules[] = { "B3/S23", "B36/S23", "B3678/S34678", "B2/S", "B1357/S1357", "B2/S34", "B0/S8" };
+    const LifeKernel::Isa isas[] = { LifeKernel::Isa::Scalar, LifeKernel::Isa::Sse2, LifeKernel::Isa::Avx2 };
+    for (const char* text : rules) {
+        const RuleSpec rule = RuleSpec::parse(text);
+        expect(LifeKernel::RowKernel(rule).specialised() == (std::string(text) != "B2/S34"
+                                                             && std::string(text) != "B0/S8"),
+               std::string("kernel specialisation for ") + text);
+        for (LifeKernel::Isa isa : isas) {
+            LifeKernel::forceIsa(isa);
+            for (int toroidal = 0; toroidal < 2; ++toroidal) {
+                Grid g = randomGrid(9, 333, toroidal != 0, 41u);
+                GameOfLife reference(g, std::make_unique<LifeRule>(rule), 100, StepKernel::PerCellRule);
+                GameOfLife fast(g, std::make_unique<LifeRule>(rule), 100, StepKernel::Bitwise);
+                expect(fast.usesBitwiseKernel(), "LifeRule should select the bitwise kernel");
+                for (int i = 0; i < 5; ++i) {
+                    reference.step();
+                    fast.step();
+                    if (!fast.currentGrid().equals(reference.currentGrid())) {
+                        std::cerr << "Rule mismatch " << text << " isa=" << LifeKernel::isaName(isa)
+                                  << " toroidal=" << toroidal << "\n";
+                        std::exit(1);
+                    }
+                }
+            }
+        }
+    }
+    LifeKernel::forceIsa(LifeKernel::bestIsa());
+
+    // unbounded engines follow the same rule; B0 is rejected there
+    Grid patch = randomGrid(30, 50, false, 9u);
+    Grid dense(200, 200, false);
+    for (int y = 0; y < 30; ++y)
+        for (int x = 0; x < 50; ++x)
+            dense.setAlive(85 + y, 75 + x, patch.isAlive(y, x));
+    GameOfLife reference(dense, std::make_unique<LifeRule>(highLife), 100);
+    SparseLife sparse(dense, 100, 64, highLife);
+    HashLife hashlife(dense, 100, 0, std::size_t(1) << 22, 64, highLife);
+    for (int i = 0; i < 20; ++i) {
+        reference.step();
+        sparse.step();
+        hashlife.step();
+    }
+    expect(sparse.window(0, 0, 200, 200).equals(reference.currentGrid()), "sparse HighLife");
+    expect(hashlife.window(0, 0, 200, 200).equals(reference.currentGrid()), "hashlife HighLife");
+    bool threw = false;
+    try { SparseLife b0(dense, 10, 64, RuleSpec::parse("B0/S8")); } catch (const std::invalid_argument&) { threw = true; }
+    expect(threw, "sparse engine rejects B0");
+    logOk();
+}
+
+// Legacy rule written against the historical interface (allocates states)
+class LegacyHighLife : public Rule {
+public:
+    CellState* nextState(const Cell& cell, const Grid& grid) const override {
+        int alive = grid.countAliveNeighbors(cell.row(), cell.col());
+        if (cell.isAlive() ? (alive == 2 || alive == 3) : (alive == 3 || alive == 6))
+            return new AliveState();
+        return new DeadState();
+    }
+};
+
+// Custom rule using only the shared flyweight states
+class FlyweightHighLife : public Rule {
+public:
+    const CellState& next(const Cell& cell, const Grid&, int neighbours) const override {
+        if (cell.isAlive() ? (neighbours == 2 || neighbours == 3) : (neighbours == 3 || neighbours == 6))
+            return AliveState::instance();
+        return DeadState::instance();
+    }
+};
+
+// Derived rules: only their own overrides change the computation
+class AllDie : public ConwayRule {
+public:
+    CellState* nextState(const Cell&, const Grid&) const override { return new DeadState(); }
+};
+
+class PlainConway : public ConwayRule {};
+
+class EmptyRule : public Rule {};
+
+static void test_per_cell_rules_do_not_allocate() {
+    logCase("Per-cell rules: flyweight states, batch interface, no allocation per step");
+    expect(&AliveState::instance() == &AliveState::instance(), "flyweight is shared");
+    Grid g = randomGrid(70, 150, true, 23u);
+    GameOfLife legacy(g, std::make_unique<LegacyHighLife>(), 100, StepKernel::PerCellRule);
+    GameOfLife flyweight(g, std::make_unique<FlyweightHighLife>(), 100, StepKernel::PerCellRule);
+    GameOfLife batch(g, std::make_unique<LifeRule>(RuleSpec::parse("B36/S23")), 100,
+                     StepKernel::PerCellRule);
+    GameOfLife fast(g, std::make_unique<LifeRule>(RuleSpec::parse("B36/S23")), 100);
+    expect(!batch.usesBitwiseKernel(), "PerCellRule keeps the rule path");
+    for (int i = 0; i < 8; ++i) {
+        legacy.step();
+        const long long before = g_allocations.load();
+        flyweight.step();
+        batch.step();
+        // read the counter before building the message string
+        const bool allocated = g_allocations.load() != before;
+        expect(!allocated, "per-cell step allocated");
+        fast.step();
+        expect(legacy.currentGrid().equals(fast.currentGrid()), "legacy rule differs");
+        expect(flyweight.currentGrid().equals(fast.currentGrid()), "flyweight rule differs");
+        expect(batch.currentGrid().equals(fast.currentGrid()), "batch rule differs");
+    }
+
+    // legacy and flyweight interfaces interoperate through the defaults
+    Grid probe = makeGrid({ "010", "010", "010" });
+    std::unique_ptr<CellState> born(FlyweightHighLife().nextState(probe.at(1, 0), probe));
+    expect(born->isAlive(), "nextState() default clones next()");
+    expect(LegacyHighLife().next(probe.at(0, 1), probe, 1).isAlive() == false,
+           "next() default wraps nextState()");
+    probe.at(0, 0).setState(AliveState::instance());
+    expect(probe.isAlive(0, 0), "setState() accepts shared states");
+
+    // a subclass of ConwayRule keeps the generic path and its nextState()
+    Grid blinker = makeGrid({ "00000", "01110", "00000" });
+    GameOfLife allDie(blinker, std::make_unique<AllDie>(), 10);
+    expect(!allDie.usesBitwiseKernel(), "derived rule is not bitwise");
+    allDie.step();
+    expect(allDie.population() == 0, "derived nextState() is called");
+    GameOfLife plain(blinker, std::make_unique<PlainConway>(), 10);
+    GameOfLife conway(blinker, std::make_unique<ConwayRule>(), 10);
+    plain.step();
+    conway.step();
+    expect(plain.currentGrid().equals(conway.currentGrid()), "derived rule without overrides stays B3/S23");
+
+    // a rule overriding none of the three methods is reported, not recursed
+    bool rejected = false;
+    try {
+        EmptyRule().next(probe.at(1, 1), probe, 2);
+    } catch (const std::logic_error&) {
+        rejected = true;
+    }
+    expect(rejected, "rule without any override throws logic_error");
+    rejected = false;
+    try {
+        std::unique_ptr<CellState> state(EmptyRule().nextState(probe.at(1, 1), probe));
+    } catch (const std::logic_error&) {
+        rejected = true;
+    }
+    expect(rejected, "nextState() of an empty rule throws logic_error");
+    logOk();
+}
+
+// Straightforward Generations reference: count state-1 neighbours per cell
+static StateGrid naiveGenerations(const StateGrid& g, const RuleSpec& rule) {
+    StateGrid next(g.rows(), g.cols(), g.toroidal());
+    for (int r = 0; r < g.rows(); ++r)
+        for (int c = 0; c < g.cols(); ++c) {
+            int n = 0;
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc) {
+                    if (!dr && !dc) continue;
+                    int rr = r + dr, cc = c + dc;
+                    if (g.toroidal()) { rr = (rr + g.rows()) % g.rows(); cc = (cc + g.cols()) % g.cols(); }
+                    if (rr >= 0 && rr < g.rows() && cc >= 0 && cc < g.cols() && g.state(rr, cc) == 1) ++n;
+                }
+            const int s = g.state(r, c);
+            int out;
+            if (s == 0) out = (rule.birth >> n) & 1;
+            else if (s == 1) out = ((rule.survival >> n) & 1) ? 1 : (rule.states > 2 ? 2 : 0);
+            else out = s + 1 < rule.states ? s + 1 : 0;
+            next.setState(r, c, static_cast<std::uint8_t>(out));
+        }
+    return next;
+}
+
+static void test_generations_rules() {
+    logCase("Generations rules: multi-state byte grid matches reference, file round trip");
+    RuleSpec brain = RuleSpec::parse("/2/3");
+    expect(brain.birth == (1u << 2) && brain.survival == 0 && brain.states == 3, "Brian's Brain masks");
+    expect(RuleSpec::parse("B2/S/C3") == brain, "B/S/C notation");
+    expect(brain.toString() == "B2/S/C3", "canonical Generations form");
+    expect(RuleSpec::parse("345/2/4").toString() == "B2/S345/C4", "Star Wars");
+    bool threw = false;
+    try { RuleSpec::parse("B2/S/C1"); } catch (const std::invalid_argument&) { threw = true; }
+    expect(threw, "at least two states");
+
+    const char* rules[] = { "/2/3", "345/2/4", "B3/S23/C5" };
+    for (const char* text : rules) {
+        const RuleSpec rule = RuleSpec::parse(text);
+        for (int toroidal = 0; toroidal < 2; ++toroidal) {
+            StateGrid reference(randomGrid(37, 71, toroidal != 0, 31u));
+            GenerationsLife engine(reference, rule, 100);
+            for (int i = 0; i < 12; ++i) {
+                reference = naiveGenerations(reference, rule);
+                engine.step();
+                expect(engine.currentStates()->equals(reference),
+                       std::string("Generations step differs for ") + text);
+                expect(engine.population() == reference.count(1), "population = state-1 cells");
+            }
+            expect(engine.currentGrid().population() == reference.count(1), "alive view");
+        }
+    }
+
+    // a single Brian's Brain cell fires then fades: 1 -> 2 -> 0
+    StateGrid lone(3, 3, false);
+    lone.setState(1, 1, 1);
+    GenerationsLife fade(lone, brain, 10);
+    fade.step();
+    expect(fade.currentStates()->state(1, 1) == 2 && fade.population() == 0, "refractory state");
+    fade.step();
+    expect(fade.currentStates()->count(0) == 9, "back to dead");
+    fade.step();
+    expect(fade.isStable(), "empty grid is stable");
+
+    StateGrid tooHigh(2, 2, false);
+    tooHigh.setState(0, 0, 3);
+    threw = false;
+    try { GenerationsLife bad(tooHigh, brain, 10); } catch (const std::invalid_argument&) { threw = true; }
+    expect(threw, "state outside the rule rejected");
+
+    // exporter/loader round trip keeps every state
+    StateGrid sample(4, 5, false);
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 5; ++c) sample.setState(r, c, static_cast<std::uint8_t>((r * 5 + c) % 4));
+    GridExporter::exportStates(sample, "test_states", 7);
+    StateGrid loaded = InitialStateLoader::loadStatesFromFile("test_states_7.txt");
+    std::remove("test_states_7.txt");
+    expect(loaded.equals(sample), "states survive export and reload");
+    logOk();
+}
+
+static void test_binary_log_round_trip() {
+    logCase("Binary simulation log: keyframes + deltas, random access, interrupted file");
+    const std::string path = "test_log.golog";
+    std::vector<Grid> history;
+    {
+        GameOfLife game(randomGrid(120, 200, true, 77u), std::make_unique<ConwayRule>(), 1000);
+        SimulationLogWriter writer(path, 16);
+        for (int i = 1; i <= 60; ++i) {
+            game.step();
+            writer.append(game.currentGrid(), i);
+            history.push_back(game.currentGrid());
+        }
+        // a shape change forces a keyframe
+        Grid other = randomGrid(7, 65, false, 3u);
+        writer.append(other, 61);
+        history.push_back(other);
+        writer.close();
+        // text export: two characters per cell
+        expect(writer.bytesWritten() * 8 < 61ull * 120 * 200 * 2, "log much smaller than text files");
+    }
+
+    SimulationLogReader reader(path);
+    expect(reader.hasIndex(), "index written on close");
+    expect(reader.iterations().size() == 61, "every generation indexed");
+    const int probes[] = { 1, 2, 16, 17, 33, 47, 60, 61 };
+    for (int it : probes)
+        expect(reader.read(it).equals(history[it - 1]), "generation " + std::to_string(it));
+    bool threw = false;
+    try { reader.read(99); } catch (const std::out_of_range&) { threw = true; }
+    expect(threw, "missing generation reported");
+
+    // drop the index and half of the last record: complete records remain readable
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream cut("test_log_cut.golog", std::ios::binary);
+    cut.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 61 * 13 - 4 - 16 - 20));
+    cut.close();
+    SimulationLogReader partial("test_log_cut.golog");
+    expect(!partial.hasIndex(), "no index in an interrupted log");
+    expect(partial.iterations().size() == 60, "complete records recovered");
+    expect(partial.read(60).equals(history[59]), "last complete generation");
+    std::remove(path.c_str());
+    std::remove("test_log_cut.golog");
+    logOk();
+}
+
+// Records exported generations; can hold the writer thread and fail on demand
+class RecordingExporter : public IGridExporter {
+public:
+    void exportGrid(const Grid& grid, const std::string&, int iteration) const override {
+        while (hold.load()) std::this_thread::yield();
+        if (iteration == failAt) throw std::runtime_error("disk full");
+        grids.push_back(grid);
+        iterations.push_back(iteration);
+    }
+    void finish() const override { finished = true; }
+
+    std::atomic<bool> hold{false};
+    int failAt = -1;
+    mutable std::vector<Grid> grids;
+    mutable std::vector<int> iterations;
+    mutable bool finished = false;
+};
+
+static void test_async_export_pipeline() {
+    logCase("Async export: ordered delivery, back-pressure, errors reported");
+    {
+        GameOfLife game(randomGrid(40, 70, true, 5u), std::make_unique<ConwayRule>(), 1000);
+        RecordingExporter sink;
+        std::vector<Grid> expected;
+        {
+            AsyncGridExporter async(sink, 3);
+            for (int i = 1; i <= 25; ++i) {
+                game.step();
+                async.exportGrid(game.currentGrid(), "out", i);
+                expected.push_back(game.currentGrid());
+            }
+            async.finish();
+        }
+        expect(sink.finished, "inner exporter finished");
+        expect(sink.iterations.size() == 25, "every generation written");
+        for (int i = 0; i < 25; ++i) {
+            expect(sink.iterations[i] == i + 1, "generations in order");
+            expect(sink.grids[i].equals(expected[i]), "snapshot matches generation " + std::to_string(i + 1));
+        }
+    }
+    {
+        // a stalled writer blocks the producer once the queue is full
+        RecordingExporter sink;
+        sink.hold = true;
+        AsyncGridExporter async(sink, 2);
+        Grid grid = randomGrid(8, 8, false, 1u);
+        std::atomic<int> submitted(0);
+        std::thread producer([&] {
+            for (int i = 1; i <= 6; ++i) {
+                async.exportGrid(grid, "out", i);
+                ++submitted;
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // two queued snapshots plus the one held by the writer
+        expect(submitted.load() <= 3, "producer throttled by a full queue");
+        sink.hold = false;
+        producer.join();
+        async.finish();
+        expect(sink.iterations.size() == 6, "throttled generations all written");
+    }
+    {
+        RecordingExporter sink;
+        sink.failAt = 3;
+        AsyncGridExporter async(sink, 4);
+        Grid grid = randomGrid(8, 8, false, 1u);
+        int reported = 0;
+        for (int i = 1; i <= 5; ++i) {
+            try { async.exportGrid(grid, "out", i); } catch (const std::runtime_error&) { ++reported; }
+        }
+        try { async.finish(); } catch (const std::runtime_error&) { ++reported; }
+        expect(reported == 1, "write error reported exactly once");
+        expect(sink.iterations.size() == 2 && !sink.finished, "writes stop after a failure");
+    }
+    bool threw = false;
+    try {
+        GridExporter::exportGrid(randomGrid(4, 4, false, 1u), "no_such_dir/out", 1);
+    } catch (const std::runtime_error&) { threw = true; }
+    expect(threw, "text export reports unwritable files");
+    logOk();
+}
+
+static void test_pattern_formats() {
+    logCase("Pattern loader: matrix, RLE, .cells and Life 1.06 give the same grid");
+    const std::vector<std::string> glider = { "010", "001", "111" };
+    const std::string sources[] = {
+        "3 3\n0 1 0\n0 0 1\n1 1 1\n",
+        "#N Glider\n#C comment\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n",
+        "!Name: Glider\n!\n.O.\n..O\nOOO\n",
+        "#Life 1.06\n#D glider\n1 -1\n2 0\n0 1\n1 1\n2 1\n",
+    };
+    const InitialStateLoader::Format formats[] = {
+        InitialStateLoader::Format::Matrix, InitialStateLoader::Format::Rle,
+        InitialStateLoader::Format::Cells, InitialStateLoader::Format::Life106,
+    };
+    for (int i = 0; i < 4; ++i) {
+        const std::string& text = sources[i];
+        expect(InitialStateLoader::detectFormat(text.data(), text.size()) == formats[i],
+               "format detected " + std::to_string(i));
+        expectGrid(InitialStateLoader::parse(text.data(), text.size()), glider,
+                   "glider " + std::to_string(i));
+        // a UTF-8 byte order mark is skipped by detection and parsing alike
+        const std::string bom = "\xEF\xBB\xBF" + text;
+        expect(InitialStateLoader::detectFormat(bom.data(), bom.size()) == formats[i],
+               "format detected after BOM " + std::to_string(i));
+        expectGrid(InitialStateLoader::parse(bom.data(), bom.size()), glider,
+                   "glider after BOM " + std::to_string(i));
+    }
+
+    // runs crossing word boundaries, trailing dead cells omitted, multi-line body
+    const std::string wide = "x = 150, y = 3\n2o60b70o$\n$149bo!\n";
+    Grid g = InitialStateLoader::parse(wide.data(), wide.size(), true);
+    expect(g.rows() == 3 && g.cols() == 150 && g.toroidal(), "RLE dimensions");
+    expect(g.population() == 73, "RLE run lengths");
+    expect(g.isAlive(0, 1) && !g.isAlive(0, 2) && g.isAlive(0, 62) && g.isAlive(0, 131)
+           && !g.isAlive(0, 132) && g.isAlive(2, 149), "RLE cell positions");
+
+    // multi-state RLE: '.' dead, A.. states, pA = 25
+    const std::string states = "x = 4, y = 1, rule = B2/S/C30\n.ABpA!\n";
+    StateGrid sg = InitialStateLoader::parseStates(states.data(), states.size());
+    expect(sg.state(0, 0) == 0 && sg.state(0, 1) == 1 && sg.state(0, 2) == 2 && sg.state(0, 3) == 25,
+           "multi-state RLE");
+
+    const char* broken[] = { "x = 2, y = 1\n3o!\n", "x = 2\nbo!\n", "!x\n.Q.\n", "#Life 1.05\n.*\n", "3 3\n0 1\n" };
+    for (const char* text : broken) {
+        bool threw = false;
+        try { InitialStateLoader::parse(text, std::strlen(text)); } catch (const std::runtime_error&) { threw = true; }
+        expect(threw, std::string("invalid input rejected: ") + text);
+    }
+
+    // file round trip through the memory-mapped loader
+    Grid big = randomGrid(300, 1000, false, 11u);
+    GridExporter::exportGrid(big, "test_loader", 1);
+    expect(InitialStateLoader::loadFromFile("test_loader_1.txt").equals(big), "matrix file round trip");
+    std::remove("test_loader_1.txt");
+    logOk();
+}
+
+static void test_checkpoint_resume() {
+    logCase("Checkpoint: atomic file, async store, resume matches an uninterrupted run");
+    const Grid soup = randomGrid(70, 90, true, 21u);
+    const RuleSpec highLife = RuleSpec::parse("B36/S23");
+    GameOfLife reference(soup, std::make_unique<LifeRule>(highLife), 400, StepKernel::Bitwise, 1, 16);
+    GameOfLife interrupted(soup, std::make_unique<LifeRule>(highLife), 400, StepKernel::Bitwise, 1, 16);
+    for (int i = 0; i < 37; ++i) {
+        reference.step();
+        interrupted.step();
+    }
+
+    SimulationCheckpoint saved;
+    saved.config.outputBaseName = "out";
+    saved.config.rule = highLife;
+    saved.config.exportEvery = 5;
+    saved.lastExported = 35;
+    interrupted.saveCheckpoint(saved.engine);
+    {
+        FileCheckpointStore store("test_checkpoint.bin");
+        SimulationCheckpoint stale = saved;
+        stale.engine.iteration = 1;
+        store.save(stale);
+        SimulationCheckpoint latest = saved;
+        store.save(latest); // replaces or follows the stale one
+        store.finish();
+    }
+    std::ifstream tmp("test_checkpoint.bin.tmp");
+    expect(!tmp, "temporary file renamed");
+
+    SimulationCheckpoint loaded = CheckpointFile::read("test_checkpoint.bin");
+    expect(loaded.config.rule == highLife && loaded.config.outputBaseName == "out"
+           && loaded.config.exportEvery == 5 && loaded.lastExported == 35, "configuration restored");
+    expect(loaded.engine.iteration == 37 && loaded.engine.grid.equals(interrupted.currentGrid()),
+           "latest checkpoint written");
+
+    GameOfLife resumed(loaded.engine.grid, std::make_unique<LifeRule>(loaded.config.rule), 400,
+                       StepKernel::Bitwise, 2, 16);
+    resumed.restoreCheckpoint(loaded.engine);
+    expect(resumed.currentIteration() == 37 && resumed.isStable() == reference.isStable(),
+           "counters restored");
+    while (!reference.hasFinished() && reference.detectedPeriod() == 0) {
+        reference.step();
+        resumed.step();
+        expect(resumed.currentGrid().equals(reference.currentGrid()), "resumed generations match");
+        expect(resumed.detectedPeriod() == reference.detectedPeriod(), "cycle history carried over");
+    }
+    expect(resumed.currentIteration() == reference.currentIteration(), "same iteration count");
+
+    // a flipped bit in the grid is detected
+    std::fstream file("test_checkpoint.bin", std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-3, std::ios::end);
+    file.put('\x5a');
+    file.close();
+    bool threw = false;
+    try { CheckpointFile::read("test_checkpoint.bin"); } catch (const std::runtime_error&) { threw = true; }
+    expect(threw, "corrupted checkpoint rejected");
+    std::remove("test_checkpoint.bin");
+    logOk();
+}
+
+static void test_random_soup_is_reproducible() {
+    logCase("Random soup: seeded, density respected, padding bits clear");
+    Grid a = RandomSoup::make(300, 130, 0.25, 42u, true);
+    Grid b = RandomSoup::make(300, 130, 0.25, 42u, true);
+    Grid c = RandomSoup::make(300, 130, 0.25, 43u, true);
+    expect(a.equals(b) && !a.equals(c), "same seed, same soup");
+    double density = static_cast<double>(a.population()) / (300.0 * 130.0);
+    expect(density > 0.23 && density < 0.27, "density close to request");
+    for (int r = 0; r < a.rows(); ++r)
+        expect((a.rowWords(r)[a.wordsPerRow() - 1] & ~a.lastWordMask()) == 0, "padding bits clear");
+    expect(RandomSoup::make(20, 20, 0.0, 1u).population() == 0, "empty soup");
+    expect(RandomSoup::make(20, 20, 1.0, 1u).population() == 400, "full soup");
+    logOk();
+}
+
+// Block densities for zoomed-out views, checked against a naive count
+static void test_density_map_matches_naive_count() {
+    logCase("Density map: block levels match naive counts, any block and offset");
+    Grid grid = RandomSoup::make(150, 333, 0.4, 9u);
+    StateGrid states(grid);
+    states.setState(3, 5, 2); // dying cells do not count as alive
+    grid.setAlive(3, 5, false);
+    const int blocks[] = { 1, 2, 3, 4, 8, 16, 32, 64, 128 };
+    const int origins[][2] = { { 0, 0 }, { 7, 64 }, { 16, 128 }, { 5, 3 } };
+    for (int block : blocks) {
+        for (const auto& origin : origins) {
+            const int row0 = origin[0], col0 = origin[1];
+            const int rows = grid.rows() - row0 - 1, cols = grid.cols() - col0 - 2;
+            std::vector<std::uint8_t> fromGrid, fromStates;
+            DensityMap::sample(grid, row0, col0, rows, cols, block, fromGrid);
+            DensityMap::sample(states, row0, col0, rows, cols, block, fromStates);
+            const int outRows = DensityMap::blockCount(rows, block);
+            const int outCols = DensityMap::blockCount(cols, block);
+            expect(static_cast<int>(fromGrid.size()) == outRows * outCols, "one level per block");
+            expect(fromGrid == fromStates, "two-state and multi-state agree");
+            for (int i = 0; i < outRows; ++i)
+                for (int j = 0; j < outCols; ++j) {
+                    long long alive = 0, area = 0;
+                    for (int r = row0 + i * block; r < std::min(row0 + (i + 1) * block, row0 + rows); ++r)
+                        for (int c = col0 + j * block; c < std::min(col0 + (j + 1) * block, col0 + cols); ++c) {
+                            alive += grid.isAlive(r, c);
+                            ++area;
+                        }
+                    expect(fromGrid[i * outCols + j] == (alive * 255 + area / 2) / area, "level matches count");
+                }
+        }
+    }
+    bool threw = false;
+    try {
+        std::vector<std::uint8_t> out;
+        DensityMap::sample(grid, 100, 0, 60, 10, 4, out);
+    }
+    catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "region outside the grid is rejected");
+    logOk();
+}
+
+// Uneven tasks: every index runs once, idle workers steal, errors surface at the end
+static void test_work_stealing_scheduler() {
+    logCase("Work stealing: each task once, imbalance stolen, first error rethrown");
+    const int count = 400;
+    std::vector<std::atomic<int>> runs(count);
+    std::atomic<int> badWorker(0);
+    // the first slice is slow: the other workers must take part of it
+    auto task = [&](int index, int worker) {
+        if (worker < 0 || worker >= 4) ++badWorker;
+        ++runs[index];
+        if (index < count / 4) std::this_thread::sleep_for(std::chrono::microseconds(200));
+    };
+    WorkStealingScheduler::Stats stats = WorkStealingScheduler::run(count, 4, task);
+    bool once = true;
+    for (const std::atomic<int>& n : runs) once = once && n == 1;
+    expect(once && badWorker == 0, "every task ran exactly once on a valid worker");
+    expect(stats.steals > 0 && stats.stolenTasks > 0, "idle workers stole work");
+
+    std::atomic<int> completed(0);
+    auto failing = [&](int index, int) {
+        ++completed;
+        if (index % 10 == 3) throw std::runtime_error("task " + std::to_string(index));
+    };
+    bool threw = false;
+    try {
+        WorkStealingScheduler::run(50, 3, failing);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    expect(threw && completed == 50, "errors do not stop the other tasks");
+    logOk();
+}
+
+// Serves grids from memory by path, for batch tests
+class MemoryLoader : public IGridLoader {
+public:
+    Grid loadGrid(const std::string& path, bool) const override {
+        for (const auto& entry : grids)
+            if (entry.first == path) return entry.second;
+        throw std::runtime_error("Fichier introuvable : " + path);
+    }
+    std::vector<std::pair<std::string, Grid>> grids;
+};
+
+// Manifest parsing and a small batch: soups and files, results in manifest order
+static void test_batch_manifest_and_service() {
+    logCase("Batch: manifest entries, parallel runs, ordered summary rows");
+    SimulationConfig defaults;
+    defaults.maxIterations = 200;
+    std::istringstream manifest(
+        "# block, blinker and a missing file\n"
+        "block.txt\n"
+        "blinker.txt max=50 toroidal\n"
+        "missing.txt\n"
+        "\n"
+        "soup 24x32 density=0.3 count=6 seed=10 rule=B36/S23 max=40\n");
+    std::vector<BatchJob> jobs = BatchManifest::parse(manifest, defaults, "in/");
+    expect(jobs.size() == 9, "three files and six soups");
+    expect(jobs[0].config.inputFile == "in/block.txt" && jobs[0].config.maxIterations == 200,
+           "file relative to manifest, default settings");
+    expect(jobs[1].config.toroidal && jobs[1].config.maxIterations == 50, "per-entry settings");
+    expect(jobs[3].soup && jobs[3].soupSeed == 10 && jobs[8].soupSeed == 15
+           && jobs[3].config.rule == RuleSpec::parse("B36/S23") && jobs[3].soupRows == 24,
+           "soups get consecutive seeds");
+
+    bool threw = false;
+    try {
+        std::istringstream bad("soup 10x10 colour=red\n");
+        BatchManifest::parse(bad, defaults);
+    }
+    catch (const std::invalid_argument& ex) {
+        threw = std::string(ex.what()).find("ligne 1") != std::string::npos;
+    }
+    expect(threw, "unknown setting reported with its line");
+
+    MemoryLoader files;
+    files.grids.emplace_back("in/block.txt", makeGrid({ "0000", "0110", "0110", "0000" }));
+    files.grids.emplace_back("in/blinker.txt", makeGrid({ "00000", "00000", "01110", "00000", "00000" }));
+    int progressCalls = 0;
+    auto progress = [&](const BatchResult&, int done, int total) {
+        ++progressCalls;
+        expect(done == progressCalls && total == 9, "progress counts runs");
+    };
+    std::vector<BatchResult> results = BatchService::run(jobs, files, 3, progress);
+    expect(results.size() == jobs.size() && progressCalls == 9, "one result per job");
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+        expect(results[i].name == jobs[i].name, "results in manifest order");
+    expect(results[0].status == BatchResult::Status::Stable && results[0].population == 4,
+           "block is stable");
+    expect(results[1].status == BatchResult::Status::Cycle && results[1].period == 2,
+           "blinker oscillates");
+    expect(results[2].status == BatchResult::Status::Error
+           && results[2].error.find("missing.txt") != std::string::npos, "missing file is an error row");
+
+    // soups are reproducible: same result as a sequential run
+    for (std::size_t i = 3; i < jobs.size(); ++i) {
+        BatchResult alone = BatchService::runOne(jobs[i], files);
+        expect(alone.generation == results[i].generation && alone.population == results[i].population,
+               "parallel run matches sequential run");
+    }
+    logOk();
+}
+
+// Every lane of the ensemble must follow its grid run alone through GameOfLife
+static void test_ensemble_lanes_match_game_of_life() {
+    logCase("Ensemble: each lane matches GameOfLife (generation, grid, stability, period)");
+    struct Setup { int rows; int cols; bool toroidal; const char* rule; int lanes; };
+    const Setup setups[] = {
+        { 32, 32, false, "B3/S23", 64 },
+        { 32, 32, true, "B3/S23", 40 },
+        { 20, 70, true, "B36/S23", 17 },
+        { 9, 13, false, "B2/S", 5 },
+    };
+    // the AVX2 and SSE2 paths (wide loads, vector transpose) must match scalar
+    const LifeKernel::Isa isas[] = { LifeKernel::Isa::Scalar, LifeKernel::Isa::Sse2, LifeKernel::Isa::Avx2 };
+    for (LifeKernel::Isa isa : isas) {
+        LifeKernel::forceIsa(isa);
+        for (const Setup& setup : setups) {
+            const RuleSpec rule = RuleSpec::parse(setup.rule);
+            const int maxIterations = 150;
+            std::vector<Grid> soups;
+            for (int l = 0; l < setup.lanes; ++l)
+                soups.push_back(RandomSoup::make(setup.rows, setup.cols, 0.1 + 0.01 * l, 100 + l,
+                                                 setup.toroidal));
+            // a blinker finishes only on the iteration limit but has a period
+            soups[0] = Grid(setup.rows, setup.cols, setup.toroidal);
+            for (int c = 2; c <= 4; ++c) soups[0].setAlive(3, c, true);
+
+            EnsembleLife ensemble(soups, rule, maxIterations);
+            expect(ensemble.lanes() == setup.lanes && ensemble.finishedMask() == 0, "nothing finished");
+            while ((ensemble.finishedMask() & ensemble.laneMask()) != ensemble.laneMask())
+                ensemble.step();
+
+            for (int l = 0; l < setup.lanes; ++l) {
+                GameOfLife alone(soups[l], std::make_unique<LifeRule>(rule), maxIterations);
+                while (!alone.hasFinished()) alone.step();
+                expect(ensemble.currentIteration(l) == alone.currentIteration(), "same generation");
+                expect(ensemble.laneGrid(l).equals(alone.currentGrid()), "same grid");
+                expect(ensemble.population(l) == alone.population(), "same population");
+                expect(ensemble.isStable(l) == alone.isStable(), "same stability");
+                expect(ensemble.detectedPeriod(l) == alone.detectedPeriod(), "same period");
+            }
+            if (rule.isConway()) expect(ensemble.detectedPeriod(0) == 2, "blinker period");
+        }
+    }
+    LifeKernel::forceIsa(LifeKernel::bestIsa());
+
+    // a partial step mask freezes the other lanes
+    std::vector<Grid> pair(2, RandomSoup::make(16, 16, 0.4, 7));
+    EnsembleLife ensemble(pair, RuleSpec::conway(), 10);
+    ensemble.step(1);
+    expect(ensemble.currentIteration(0) == 1 && ensemble.currentIteration(1) == 0, "lane 1 frozen");
+    expect(ensemble.laneGrid(1).equals(pair[1]), "frozen lane unchanged");
+
+    bool threw = false;
+    try {
+        std::vector<Grid> mixed = { Grid(8, 8), Grid(8, 9) };
+        EnsembleLife bad(mixed, RuleSpec::conway(), 10);
+    }
+    catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "grids of different sizes rejected");
+    logOk();
+}
+
+// Objects are separated, canonicalised and classified; the census is thread-independent
+static void test_object_census() {
+    logCase("Census: canonical shapes, object separation, classification, cached census");
+    auto cellsOf = [](const std::vector<std::string>& rows, long long top, long long left) {
+        std::vector<ObjectShape::Cell> cells;
+        for (std::size_t r = 0; r < rows.size(); ++r)
+            for (std::size_t c = 0; c < rows[r].size(); ++c)
+                if (rows[r][c] == '1') cells.emplace_back(top + r, left + c);
+        return cells;
+    };
+    const std::vector<std::string> glider = { ".1.", "..1", "111" };
+    long long top = 0, left = 0;
+    ObjectShape shape = ObjectShape::fromCells(cellsOf(glider, -7, 40), &top, &left);
+    expect(top == -7 && left == 40 && shape.rows == 3 && shape.population() == 5, "normalised shape");
+    for (int t = 0; t < 8; ++t)
+        expect(shape.transformed(t).canonical() == shape.canonical(), "canonical form is isometry-invariant");
+    expect(ObjectShape::fromCells(cellsOf({ "11", "11" }, 3, 3)).code() == "2x2:3.3", "block code");
+
+    // two cells at distance 2 share an object, at distance 3 they do not
+    std::vector<ObjectShape::Cell> cells = cellsOf({ "11..11", "11..11" }, 0, 0);
+    std::vector<ObjectShape::Cell> blinker = cellsOf({ "111" }, 0, 7);
+    cells.insert(cells.end(), blinker.begin(), blinker.end());
+    std::vector<std::vector<ObjectShape::Cell>> objects;
+    ObjectShape::separate(cells, objects);
+    expect(objects.size() == 2, "blocks 3 apart are separate, blinker 2 apart joins");
+
+    ObjectClassifier classifier;
+    const ObjectClass block = classifier.classify(ObjectShape::fromCells(cellsOf({ "11", "11" }, 0, 0)));
+    expect(block.kind == ObjectClass::Kind::StillLife && block.period == 1 && block.name == "bloc", "block");
+    const ObjectClass toad = classifier.classify(ObjectShape::fromCells(cellsOf({ ".111", "111." }, 0, 0)));
+    expect(toad.kind == ObjectClass::Kind::Oscillator && toad.period == 2 && toad.name == "crapaud", "toad");
+    const ObjectClass ship = classifier.classify(shape);
+    expect(ship.kind == ObjectClass::Kind::Spaceship && ship.period == 4 && ship.dx == 1 && ship.dy == 1
+           && ship.name == "planeur", "glider");
+    const ObjectClass lwss = classifier.classify(
+        ObjectShape::fromCells(cellsOf({ ".1..1", "1....", "1...1", "1111." }, 0, 0)));
+    expect(lwss.kind == ObjectClass::Kind::Spaceship && lwss.dx == 2 && lwss.dy == 0, "lightweight spaceship");
+    const ObjectClass rPentomino = classifier.classify(
+        ObjectShape::fromCells(cellsOf({ ".11", "11.", ".1." }, 0, 0)));
+    expect(rPentomino.kind == ObjectClass::Kind::Other, "methuselah is not periodic");
+
+    // another phase of the glider, mirrored: same class, found in the cache
+    const long long misses = classifier.cacheMisses();
+    const ObjectClass other = classifier.classify(
+        ObjectShape::fromCells(cellsOf({ "1.1", ".11", ".1." }, 0, 0)).transformed(6));
+    expect(other.code == ship.code && classifier.cacheMisses() == misses, "glider phase from cache");
+
+    CensusSettings settings;
+    settings.soups = 70;
+    settings.threads = 1;
+    long long lastDone = 0;
+    const CensusReport one = CensusService::run(settings, [&](long long done, long long total) {
+        expect(done > lastDone && total == 70, "progress");
+        lastDone = done;
+    });
+    settings.threads = 3;
+    const CensusReport three = CensusService::run(settings);
+    expect(lastDone == 70 && one.soups == 70 && one.unsettled == 0, "all soups settle");
+    long long counted = 0;
+    for (const CensusEntry& entry : one.entries) counted += entry.count;
+    expect(counted == one.objects && one.objects > 0, "every object counted once");
+    expect(one.entries.size() == three.entries.size() && one.objects == three.objects
+           && one.generations == three.generations, "same census on 1 and 3 threads");
+    for (std::size_t i = 0; i < one.entries.size() && i < three.entries.size(); ++i)
+        expect(one.entries[i].object.code == three.entries[i].object.code
+               && one.entries[i].count == three.entries[i].count
+               && one.entries[i].sampleSeed == three.entries[i].sampleSeed, "same rows");
+    expect(one.entries[0].object.name == "bloc", "blocks are the most common object");
+    expect(one.cacheHits > one.cacheMisses, "classification mostly served by the cache");
+    logOk();
+}
+
+// Strips computed in worker processes reproduce GameOfLife across strip seams
+static void test_distributed_matches_game_of_life() {
+    logCase("Distributed: worker strips match GameOfLife (grid, stats, period, checkpoint)");
+    struct Setup { int rows; int cols; bool toroidal; const char* rule; int workers; };
+    const Setup setups[] = {
+        { 90, 130, false, "B3/S23", 3 },
+        { 90, 130, true, "B3/S23", 7 },
+        { 40, 64, true, "B36/S23", 1 },
+        { 5, 20, false, "B3/S23", 9 }, // more workers than rows: one row per strip
+    };
+    for (const Setup& setup : setups) {
+        const RuleSpec rule = RuleSpec::parse(setup.rule);
+        const Grid initial = RandomSoup::make(setup.rows, setup.cols, 0.3, 11, setup.toroidal);
+        const int maxIterations = 60;
+        GameOfLife reference(initial, std::make_unique<LifeRule>(rule), maxIterations);
+        DistributedLife distributed(initial, std::make_unique<SharedMemoryTransport>(), maxIterations,
+                                    setup.workers, 64, rule);
+        expect(distributed.workers() == std::min(setup.workers, setup.rows), "worker count");
+        expect(distributed.currentGrid().equals(initial), "initial grid");
+        while (!reference.hasFinished()) {
+            expect(!distributed.hasFinished(), "not finished before the reference");
+            reference.step();
+            distributed.step();
+            expect(distributed.population() == reference.population(), "same population");
+            expect(distributed.lastStepStats().births == reference.lastStepStats().births
+                   && distributed.lastStepStats().deaths == reference.lastStepStats().deaths
+                   && distributed.lastStepStats().hashDelta == reference.lastStepStats().hashDelta,
+                   "same step stats");
+            if (reference.currentIteration() % 7 == 0)
+                expect(distributed.currentGrid().equals(reference.currentGrid()), "same grid");
+        }
+        expect(distributed.hasFinished() && distributed.isStable() == reference.isStable(), "same end");
+        expect(distributed.currentIteration() == reference.currentIteration(), "same generation");
+        expect(distributed.currentGrid().equals(reference.currentGrid()), "same final grid");
+        expect(distributed.detectedPeriod() == reference.detectedPeriod(), "same period");
+    }
+
+    // a glider crosses every seam of a 4-strip torus and comes back after 48 generations
+    Grid torus(12, 12, true);
+    torus.setAlive(0, 1, true);
+    torus.setAlive(1, 2, true);
+    torus.setAlive(2, 0, true);
+    torus.setAlive(2, 1, true);
+    torus.setAlive(2, 2, true);
+    DistributedLife glider(torus, std::make_unique<SharedMemoryTransport>(), 100, 4);
+    EngineCheckpoint checkpoint;
+    for (int i = 0; i < 48; ++i) {
+        glider.step();
+        if (i == 9) glider.saveCheckpoint(checkpoint);
+    }
+    expect(glider.detectedPeriod() == 48 && glider.currentGrid().equals(torus), "glider period on torus");
+
+    // a checkpoint resumes in a fresh set of workers
+    DistributedLife resumed(checkpoint.grid, std::make_unique<SharedMemoryTransport>(), 100, 4);
+    resumed.restoreCheckpoint(checkpoint);
+    expect(resumed.currentIteration() == 10 && resumed.currentGrid().equals(checkpoint.grid), "restored");
+    while (resumed.currentIteration() < 48) resumed.step();
+    expect(resumed.currentGrid().equals(torus) && resumed.detectedPeriod() == 48, "resumed period");
+
+    bool threw = false;
+    try {
+        DistributedLife wrongGrid(torus, std::make_unique<SharedMemoryTransport>(), 100, 2);
+        wrongGrid.restoreCheckpoint(checkpoint);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "checkpoint of another grid rejected");
+    threw = false;
+    try {
+        DistributedLife noTransport(torus, nullptr, 100, 2);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "transport is required");
+    logOk();
+}
+
+// The memory-mapped tiled engine rewrites its file in place and matches GameOfLife
+static void test_tiled_file_matches_game_of_life() {
+    logCase("Tiled: file-backed wavefront matches GameOfLife, skips still tiles, reopens in place");
+    const std::string path = "test_tiled.tiles";
+    struct Setup { int rows; int cols; bool toroidal; const char* rule; };
+    const Setup setups[] = {
+        { 150, 200, false, "B3/S23" }, // partial last tile row and tile column
+        { 150, 200, true, "B3/S23" },
+        { 64, 64, true, "B3/S23" },    // a single tile wraps onto itself
+        { 70, 130, true, "B36/S23" },
+    };
+    for (const Setup& setup : setups) {
+        const RuleSpec rule = RuleSpec::parse(setup.rule);
+        const Grid initial = RandomSoup::make(setup.rows, setup.cols, 0.3, 5, setup.toroidal);
+        const int maxIterations = 80;
+        TiledGridFile::create(path, setup.rows, setup.cols, setup.toroidal, rule);
+        TiledGridFile(path).place(initial, 0, 0);
+        GameOfLife reference(initial, std::make_unique<LifeRule>(rule), maxIterations);
+        std::optional<TiledLife> tiled;
+        tiled.emplace(std::make_unique<TiledGridFile>(path), maxIterations);
+        expect(tiled->population() == initial.population() && tiled->currentGrid().equals(initial),
+               "initial file");
+        while (!reference.hasFinished()) {
+            expect(!tiled->hasFinished(), "not finished before the reference");
+            reference.step();
+            tiled->step();
+            expect(tiled->population() == reference.population(), "same population");
+            expect(tiled->lastStepStats().births == reference.lastStepStats().births
+                   && tiled->lastStepStats().hashDelta == reference.lastStepStats().hashDelta,
+                   "same step stats");
+            if (reference.currentIteration() % 9 == 0)
+                expect(tiled->currentGrid().equals(reference.currentGrid()), "same grid");
+            // close and reopen mid-run: the file alone carries the state
+            if (reference.currentIteration() == 20) {
+                tiled.reset();
+                tiled.emplace(std::make_unique<TiledGridFile>(path), maxIterations);
+                expect(tiled->currentIteration() == 20, "generation from the file");
+            }
+        }
+        expect(tiled->hasFinished() && tiled->isStable() == reference.isStable(), "same end");
+        expect(tiled->currentIteration() == reference.currentIteration(), "same generation");
+        expect(tiled->currentGrid().equals(reference.currentGrid()), "same final grid");
+        tiled.reset();
+        TiledGridFile file(path);
+        expect(file.generation() == reference.currentIteration()
+               && file.population() == reference.population()
+               && file.hash() == reference.currentGrid().hash()
+               && file.window(0, 0, setup.rows, setup.cols).equals(reference.currentGrid()),
+               "file is the export");
+    }
+
+    // a blinker in a large empty file: only the tiles around it are stepped
+    TiledGridFile::create(path, 640, 640, false, RuleSpec::conway());
+    {
+        TiledGridFile file(path);
+        for (int c = 300; c < 303; ++c) file.setAlive(352, c, true);
+    }
+    TiledLife blinker(std::make_unique<TiledGridFile>(path), 100);
+    blinker.setView(350, 298, 5, 7);
+    for (int i = 0; i < 4; ++i) blinker.step();
+    expect(blinker.detectedPeriod() == 2 && blinker.activeTiles() <= 9
+           && blinker.tileCount() == 100, "still tiles skipped");
+    expect(blinker.currentGrid().rows() == 5 && blinker.currentGrid().population() == 3
+           && blinker.currentGrid().isAlive(2, 2), "view window");
+    expect(blinker.activeRegion().top == 320 && blinker.activeRegion().left == 256
+           && blinker.activeRegion().bottom == 383, "active region on tile bounds");
+
+    bool threw = false;
+    {
+        TiledGridFile file(path);
+        file.beginStep(); // as if the program stopped mid-generation
+    }
+    try {
+        TiledGridFile interrupted(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    expect(threw, "interrupted generation rejected");
+    threw = false;
+    try {
+        TiledLife noStore(nullptr, 100);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "tile store is required");
+    std::remove(path.c_str());
+    logOk();
+}
+
+// Latest-wins handoff between one producer and one consumer thread
+static void test_triple_buffer_handoff() {
+    logCase("Triple buffer: latest value wins, no torn reads, no allocation");
+    TripleBuffer<std::vector<int>> buffer;
+    expect(!buffer.acquire() && !buffer.pending(), "nothing published yet");
+    buffer.back().assign(16, 1);
+    buffer.publish();
+    expect(buffer.pending() && buffer.acquire(), "published value available");
+    expect(buffer.front() == std::vector<int>(16, 1), "first value");
+    for (int value = 2; value <= 3; ++value) {
+        buffer.back().assign(16, value);
+        buffer.publish();
+    }
+    expect(buffer.acquire() && buffer.front() == std::vector<int>(16, 3),
+           "intermediate values skipped");
+    expect(!buffer.acquire(), "same value is not handed out twice");
+
+    // concurrent producer: every slot read is one whole, increasing generation
+    const int last = 20000;
+    long long producerAllocations = -1;
+    std::thread producer([&] {
+        const long long before = g_allocations;
+        for (int value = 4; value <= last; ++value) {
+            std::vector<int>& slot = buffer.back();
+            std::fill(slot.begin(), slot.end(), value);
+            buffer.publish();
+        }
+        producerAllocations = g_allocations - before; // the reader never allocates
+    });
+    int seen = 3;
+    bool consistent = true;
+    while (seen < last) {
+        if (!buffer.acquire()) continue;
+        const std::vector<int>& value = buffer.front();
+        consistent = consistent && value[0] > seen
+                     && std::count(value.begin(), value.end(), value[0]) == 16;
+        seen = value[0];
+    }
+    producer.join();
+    expect(consistent, "reads are whole and increasing");
+    expect(producerAllocations == 0, "slots are reused");
+    logOk();
+}
+
+// Collects the batches handed to a metrics sink
+class CollectingSink : public IMetricsSink {
+public:
+    void write(const GenerationMetrics* metrics, std::size_t count) const override {
+        ++batches;
+        for (std::size_t i = 0; i < count; ++i) iterations.push_back(metrics[i].iteration);
+    }
+    void finish() const override { finished = true; }
+
+    mutable int batches = 0;
+    mutable std::vector<int> iterations;
+    mutable bool finished = false;
+};
+
+static void test_metrics_recorder() {
+    logCase("Metrics: latency percentiles, ring buffer, batched sink, active region");
+    LatencyHistogram h;
+    for (int i = 1; i <= 1000; ++i) h.record(i * 1000);
+    expect(h.count() == 1000 && h.max() == 1000000, "histogram count and max");
+    const double p50 = static_cast<double>(h.percentile(0.5));
+    const double p99 = static_cast<double>(h.percentile(0.99));
+    expect(p50 >= 500000 && p50 < 500000 * 1.125, "p50 within bucket precision");
+    expect(p99 >= 990000 && p99 <= 1000000, "p99 within bucket precision");
+
+    CollectingSink sink;
+    MetricsRecorder recorder(8, &sink);
+    for (int i = 1; i <= 21; ++i) {
+        GenerationMetrics m;
+        m.iteration = i;
+        m.stepNanos = 100;
+        m.births = 2;
+        m.deaths = 1;
+        recorder.record(m);
+    }
+    expect(recorder.size() == 8 && recorder.recent(0).iteration == 21 && recorder.recent(7).iteration == 14,
+           "ring keeps the latest generations");
+    expect(sink.batches == 2 && sink.iterations.size() == 16, "sink fed once per full ring");
+    recorder.finish();
+    expect(sink.finished && sink.iterations.size() == 21, "finish flushes the remainder");
+    for (int i = 0; i < 21; ++i) expect(sink.iterations[i] == i + 1, "sink order");
+    expect(recorder.totalBirths() == 42 && recorder.totalDeaths() == 21, "totals");
+
+    // dense engine: the changed tiles bound a lone blinker in a large grid
+    Grid g(300, 700, false);
+    g.setAlive(200, 600, true);
+    g.setAlive(200, 601, true);
+    g.setAlive(200, 602, true);
+    GameOfLife game(g, std::make_unique<ConwayRule>(), 10);
+    game.step();
+    BoundingBox box = game.activeRegion();
+    expect(!box.empty() && box.top <= 199 && box.bottom >= 201 && box.left <= 600 && box.right >= 602
+           && box.rows() <= 128 && box.cols() <= 256, "dense active region");
+
+    // sparse engine: a glider far from the origin
+    SparseLife sparse(makeGrid({ "010", "001", "111" }), 10);
+    sparse.step();
+    box = sparse.activeRegion();
+    expect(box.rows() == 64 && box.cols() == 64 && box.top == 0 && box.left == 0, "sparse active region");
+
+    {
+        MetricsFileSink csv("test_metrics.csv");
+        GenerationMetrics m;
+        m.iteration = 3;
+        m.activeRegion = box;
+        csv.write(&m, 1);
+        csv.finish();
+    }
+    std::ifstream in("test_metrics.csv");
+    std::string header, line;
+    std::getline(in, header);
+    std::getline(in, line);
+    expect(header.rfind("iteration,step_ns", 0) == 0 && line == "3,0,0,0,0,0,0,0,0,0,63,63", "CSV line");
+    in.close();
+    std::remove("test_metrics.csv");
+    logOk();
+}
+
 int main() {
     std::cout << "Running Game of Life unit tests...\n";
     test_block_is_stable();
     test_blinker_oscillates();
     test_lonely_cell_dies();
+    test_packed_storage_across_words();
+    test_bitwise_kernel_matches_rule();
+    test_threaded_step_matches_serial();
+    test_step_swaps_buffers_without_copy();
+    test_cycle_detection();
+    test_active_tiles_skip_quiescent_regions();
+    test_sparse_universe_matches_dense_and_grows();
+    test_sparse_gliders_cross_chunk_corners();
+    test_hashlife_matches_sparse_and_jumps();
+    test_life_like_rules();
+    test_per_cell_rules_do_not_allocate();
+    test_generations_rules();
+    test_binary_log_round_trip();
+    test_async_export_pipeline();
+    test_pattern_formats();
+    test_checkpoint_resume();
+    test_random_soup_is_reproducible();
+    test_metrics_recorder();
+    test_triple_buffer_handoff();
+    test_density_map_matches_naive_count();
+    test_work_stealing_scheduler();
+    test_batch_manifest_and_service();
+    test_ensemble_lanes_match_game_of_life();
+    test_object_census();
+    test_distributed_matches_game_of_life();
+    test_tiled_file_matches_game_of_life();
     std::cout << "All tests passed.\n";
     return 0;
 }
@@ -0,0 +1,64 @@
+#include "BatchRunner.h"
+#include "BatchManifest.h"
+#include "BatchService.h"
+#include "BatchSummaryFile.h"
+#include "FileGridLoader.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+void BatchRunner::run(const std::string& manifestPath,
+                      const std::string& summaryPath,
+                      const SimulationConfig& defaults)
+{
+    try {
+        typedef std::chrono::steady_clock Clock;
+        // les simulations tournent sur des threads : pas de fork possible
+        if (defaults.engine == Engine::Distributed) {
+            throw std::invalid_argument("Le moteur reparti n'est pas disponible en mode batch");
+        }
+        // un seul fichier de tuiles (<prefixe>.tiles) pour toutes les simulations
+        if (defaults.engine == Engine::Tiled) {
+            throw std::invalid_argument("Le moteur en fichier n'est pas disponible en mode batch");
+        }
+        const std::vector<BatchJob> jobs = BatchManifest::load(manifestPath, defaults);
+        const int threads = defaults.threads > 0 ? defaults.threads : WorkerPool::hardwareThreads();
+        std::cout << "Lot de " << jobs.size() << " simulations sur " << threads << " threads.\n";
+
+        // avancement : environ toutes les secondes, et a la fin
+        const Clock::time_point start = Clock::now();
+        Clock::time_point lastReport = start;
+        int errors = 0;
+        auto progress = [&](const BatchResult& result, int done, int total) {
+            if (result.status == BatchResult::Status::Error && ++errors <= 5)
+                std::cerr << "Erreur: " << result.name << " : " << result.error << "\n";
+            const Clock::time_point now = Clock::now();
+            if (done == total || now - lastReport >= std::chrono::seconds(1)) {
+                lastReport = now;
+                std::cout << "  " << done << " / " << total << "\n";
+            }
+        };
+        FileGridLoader files;
+        const std::vector<BatchResult> results = BatchService::run(jobs, files, threads, progress);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        BatchSummaryFile::write(summaryPath, jobs, results);
+
+        int counts[4] = {};
+        double busy = 0.0;
+        for (const BatchResult& r : results) {
+            ++counts[static_cast<int>(r.status)];
+            busy += r.seconds;
+        }
+        std::cout << "Lot termine en " << seconds << " s";
+        if (seconds > 0) std::cout << " (" << results.size() / seconds << " simulations/s)";
+        std::cout << " : " << counts[0] << " stables, " << counts[1] << " cycles, "
+                  << counts[2] << " au maximum d'iterations, " << counts[3] << " en erreur.\n";
+        if (seconds > 0)
+            std::cout << "Occupation moyenne : " << busy / seconds << " threads sur " << threads << ".\n";
+        std::cout << "Synthese : " << summaryPath << "\n";
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+    }
+}
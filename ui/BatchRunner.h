@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+#include "SimulationConfig.h"
+
+// Mode lot : exécute toutes les simulations d'un manifeste (fichiers
+// d'entrée, soupes aléatoires) sur tous les cœurs et écrit une ligne de
+// synthèse CSV par simulation. defaults : réglages de la ligne de commande
+// (règle, moteur, torique, maxIterations, threads = simulations en
+// parallèle).
+class BatchRunner {
+public:
+    static void run(const std::string& manifestPath,
+                    const std::string& summaryPath,
+                    const SimulationConfig& defaults);
+};
@@ -0,0 +1,58 @@
+#include "CensusRunner.h"
+#include "CensusFile.h"
+#include "CensusService.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <iostream>
+
+void CensusRunner::run(long long soups,
+                       const std::string& resultsPath,
+                       const SimulationConfig& config)
+{
+    try {
+        typedef std::chrono::steady_clock Clock;
+        CensusSettings settings;
+        settings.soups = soups;
+        settings.soupRows = config.soupRows;
+        settings.soupCols = config.soupCols;
+        settings.density = config.soupDensity;
+        settings.seed = config.soupSeed;
+        settings.rule = config.rule;
+        settings.maxIterations = config.maxIterations;
+        settings.threads = config.threads > 0 ? config.threads : WorkerPool::hardwareThreads();
+        std::cout << "Recensement de " << soups << " soupes " << settings.soupRows << "x"
+                  << settings.soupCols << " (" << settings.rule.toString() << ") sur "
+                  << settings.threads << " threads.\n";
+
+        Clock::time_point lastReport = Clock::now();
+        auto progress = [&](long long done, long long total) {
+            const Clock::time_point now = Clock::now();
+            if (done == total || now - lastReport >= std::chrono::seconds(1)) {
+                lastReport = now;
+                std::cout << "  " << done << " / " << total << "\n";
+            }
+        };
+        const CensusReport report = CensusService::run(settings, progress);
+        CensusFile::write(resultsPath, report);
+
+        std::cout << "Recensement termine en " << report.seconds << " s";
+        if (report.seconds > 0) std::cout << " (" << report.soups / report.seconds << " soupes/s)";
+        std::cout << " : " << report.objects << " objets, " << report.entries.size()
+                  << " especes, " << report.unsettled << " soupes non stabilisees.\n";
+        std::cout << "Classement : " << report.classifySeconds << " s de calcul, "
+                  << report.cacheHits << " objets trouves en cache, "
+                  << report.cacheMisses << " simules.\n";
+        for (std::size_t i = 0; i < report.entries.size() && i < 10; ++i) {
+            const CensusEntry& entry = report.entries[i];
+            std::cout << "  " << entry.count << "  " << entry.object.code << "  "
+                      << ObjectClass::kindName(entry.object.kind);
+            if (entry.object.period > 1) std::cout << " p" << entry.object.period;
+            if (!entry.object.name.empty()) std::cout << " (" << entry.object.name << ")";
+            std::cout << "\n";
+        }
+        std::cout << "Tableau : " << resultsPath << "\n";
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+    }
+}
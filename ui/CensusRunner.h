@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include "SimulationConfig.h"
+
+// Mode recensement : soups soupes aléatoires (taille, densité et première
+// graine de config.soup*) menées à stabilisation, objets finaux classés et
+// comptés ; tableau CSV dans resultsPath et principaux objets à l'écran.
+// config : règle, maxIterations par soupe, threads (0 = tous les cœurs).
+class CensusRunner {
+public:
+    static void run(long long soups,
+                    const std::string& resultsPath,
+                    const SimulationConfig& config);
+};
@@ -1,24 +1,139 @@
 #include "ConsoleRunner.h"
 #include "FileGridLoader.h"
+#include "MetricsFileSink.h"
+#include "AsyncGridExporter.h"
+#include "BinaryLogExporter.h"
+#include "FileCheckpointStore.h"
 #include "FileGridExporter.h"
 #include "SimulationService.h"
-#include "ConwayRule.h"
+#include "SystemEngineResources.h"
+#include "LifeRule.h"
 #include <iostream>
+#include <stdexcept>
 
-void ConsoleRunner::run(const SimulationConfig& config) {
+namespace {
+
+double micros(std::int64_t nanos) {
+    return static_cast<double>(nanos) / 1000.0;
+}
+
+void printLatency(const char* label, const LatencyHistogram& h) {
+    std::cout << label << " (us) : p50 " << micros(h.percentile(0.5))
+              << ", p90 " << micros(h.percentile(0.9))
+              << ", p99 " << micros(h.percentile(0.99))
+              << ", max " << micros(h.max())
+              << ", moyenne " << micros(static_cast<std::int64_t>(h.mean())) << "\n";
+}
+
+void printMetrics(const MetricsRecorder& metrics) {
+    std::cout << "Mesures sur " << metrics.generations() << " generations :\n";
+    printLatency("  Pas", metrics.stepLatency());
+    if (metrics.exportLatency().count() > 0)
+        printLatency("  Export", metrics.exportLatency());
+    std::cout << "  Naissances " << metrics.totalBirths()
+              << ", morts " << metrics.totalDeaths() << "\n";
+    if (metrics.size() > 0) {
+        const BoundingBox& box = metrics.recent(0).activeRegion;
+        if (!box.empty())
+            std::cout << "  Zone active au dernier pas : lignes " << box.top << ".." << box.bottom
+                      << ", colonnes " << box.left << ".." << box.right << "\n";
+    }
+}
+
+void simulate(const SimulationConfig& config, const SimulationCheckpoint* resumeFrom) {
     try {
         FileGridLoader loader;
-        FileGridExporter exporter;
-        SimulationService service(config, loader, &exporter, std::make_unique<ConwayRule>());
+        SystemEngineResources resources;
+        std::unique_ptr<IGridExporter> output;
+        if (config.outputFormat == OutputFormat::Log) {
+            if (config.rule.isGenerations()) {
+                // le journal ne garde que les cellules vivantes
+                throw std::invalid_argument("Le format log ne conserve pas les etats des regles "
+                                            "multi-etats : utiliser --format text");
+            }
+            // une reprise ouvre un nouveau journal, <base>_<generation>.golog
+            std::string path = config.outputBaseName;
+            if (resumeFrom) path += "_" + std::to_string(resumeFrom->engine.iteration);
+            output = std::make_unique<BinaryLogExporter>(path + ".golog",
+                                                         config.logKeyframeInterval);
+        }
+        else
+            output = std::make_unique<FileGridExporter>();
+        std::unique_ptr<IMetricsSink> metricsSink;
+        if (config.collectMetrics && !config.metricsFile.empty())
+            metricsSink = std::make_unique<MetricsFileSink>(config.metricsFile);
+        // moteur d'abord : le moteur reparti cree ses processus (fork)
+        // avant que l'export et les points de reprise n'aient leurs threads
+        SimulationService service(config, loader, nullptr, std::make_unique<LifeRule>(config.rule),
+                                  nullptr, resumeFrom, &resources);
+        // ecriture sur un thread dedie, en parallele du calcul
+        std::unique_ptr<IGridExporter> async;
+        if (config.exportQueue > 0)
+            async = std::make_unique<AsyncGridExporter>(*output, config.exportQueue);
+        IGridExporter* exporter = async ? async.get() : output.get();
+        std::unique_ptr<ICheckpointStore> checkpoints;
+        if (!config.checkpointFile.empty())
+            checkpoints = std::make_unique<FileCheckpointStore>(config.checkpointFile);
+        service.attach(exporter, checkpoints.get());
+        if (config.collectMetrics)
+            service.enableMetrics(config.metricsHistory, metricsSink.get());
+        if (resumeFrom)
+            std::cout << "Reprise a l'iteration " << service.currentIteration() << ".\n";
 
         int iter = 0;
+        long long activeTiles = 0;
         while (!service.hasFinished()) {
             service.step();
+            activeTiles += service.activeTiles();
             ++iter;
         }
-        std::cout << "Simulation terminee en " << iter << " iterations.\n";
+        service.finish();
+        std::cout << "Simulation terminee en " << service.currentIteration() << " iterations.\n";
+        if (iter > 0 && service.tileCount() > 0) {
+            double ratio = 100.0 * activeTiles / (static_cast<double>(iter) * service.tileCount());
+            std::cout << "Tuiles actives en moyenne : " << ratio << " % de "
+                      << service.tileCount() << ".\n";
+        }
+        int period = service.detectedPeriod();
+        if (period == 1)
+            std::cout << "Configuration stable.\n";
+        else if (period > 1)
+            std::cout << "Oscillateur de periode " << period << " detecte.\n";
+        if (const MetricsRecorder* metrics = service.metrics())
+            printMetrics(*metrics);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+    }
+}
+
+} // namespace
+
+void ConsoleRunner::run(const SimulationConfig& config) {
+    simulate(config, nullptr);
+}
+
+void ConsoleRunner::resume(const std::string& checkpointPath,
+                           const SimulationConfig& options,
+                           int maxIterations)
+{
+    SimulationCheckpoint checkpoint;
+    try {
+        checkpoint = FileCheckpointStore(checkpointPath).load(checkpointPath);
     }
     catch (const std::exception& ex) {
         std::cerr << "Erreur: " << ex.what() << "\n";
+        return;
     }
+    // configuration de la simulation interrompue ; les points de reprise
+    // suivants remplacent le meme fichier
+    SimulationConfig config = checkpoint.config;
+    config.threads = options.threads;
+    config.exportQueue = options.exportQueue;
+    config.collectMetrics = options.collectMetrics;
+    config.metricsFile = options.metricsFile;
+    config.metricsHistory = options.metricsHistory;
+    config.checkpointFile = checkpointPath;
+    if (maxIterations > 0) config.maxIterations = maxIterations;
+    simulate(config, &checkpoint);
 }
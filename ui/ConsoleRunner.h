@@ -1,7 +1,14 @@
 #pragma once
+#include <string>
 #include "SimulationConfig.h"
 
 class ConsoleRunner {
 public:
     static void run(const SimulationConfig& config);
+    // reprend la simulation enregistrée dans checkpointPath ; seuls les
+    // threads, la file d'export, les mesures et maxIterations (> 0) de
+    // options s'appliquent
+    static void resume(const std::string& checkpointPath,
+                       const SimulationConfig& options,
+                       int maxIterations = 0);
 };
@@ -0,0 +1,32 @@
+#include "ExtractRunner.h"
+#include "GridExporter.h"
+#include "SimulationLog.h"
+#include <iostream>
+
+void ExtractRunner::list(const std::string& logPath) {
+    try {
+        SimulationLogReader reader(logPath);
+        const std::vector<int>& iterations = reader.iterations();
+        std::cout << "Journal " << logPath << " : " << iterations.size() << " generations";
+        if (!iterations.empty())
+            std::cout << " (" << iterations.front() << " a " << iterations.back() << ")";
+        std::cout << ".\n";
+        if (!reader.hasIndex())
+            std::cout << "Index absent (ecriture interrompue) : enregistrements complets relus.\n";
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+    }
+}
+
+void ExtractRunner::run(const std::string& logPath, int iteration, const std::string& baseName) {
+    try {
+        SimulationLogReader reader(logPath);
+        GridExporter::exportGrid(reader.read(iteration), baseName, iteration);
+        std::cout << "Generation " << iteration << " ecrite dans "
+                  << baseName << "_" << iteration << ".txt\n";
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+    }
+}
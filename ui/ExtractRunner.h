@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+// Outil de lecture d'un journal binaire (.golog) : liste les générations
+// ou en extrait une au format texte habituel.
+class ExtractRunner {
+public:
+    static void list(const std::string& logPath);
+    // écrit <baseName>_<iteration>.txt
+    static void run(const std::string& logPath, int iteration, const std::string& baseName);
+};
@@ -1,66 +1,155 @@
 #include "GraphicRunner.h"
-#include "InitialStateLoader.h"
-#include "GameOfLife.h"
-#include "ConwayRule.h"
+#include "FileGridLoader.h"
+#include "GridRenderer.h"
+#include "SimulationService.h"
+#include "SimulationThread.h"
+#include "SystemEngineResources.h"
+#include "Viewport.h"
+#include "LifeRule.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <sstream>
+#include <string>
 
-static void drawGrid(sf::RenderWindow& window,
-                     const Grid& grid,
-                     int cellSize)
+// taille initiale de la fenetre : 20 pixels par cellule, 1000 pixels de
+// cote au plus (les grandes grilles s'affichent alors reduites)
+static sf::VideoMode initialMode(int rows, int cols) {
+    const int side = std::max(std::max(rows, cols), 1);
+    const float scale = std::min(20.0f, 1000.0f / side);
+    return sf::VideoMode(std::max(1, static_cast<int>(cols * scale)),
+                         std::max(1, static_cast<int>(rows * scale)));
+}
+
+// cibles de vitesse (generations par seconde) parcourues avec Haut / Bas ;
+// la derniere (0) calcule aussi vite que possible
+static const double kRates[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 0 };
+static const int kRateCount = sizeof(kRates) / sizeof(kRates[0]);
+static const int kDefaultRate = 2; // 5 generations par seconde
+
+static std::string windowTitle(const SimulationThread::Frame& frame, double rate,
+                               bool paused, bool skipFrames)
 {
-    sf::RectangleShape rect(sf::Vector2f(cellSize - 1, cellSize - 1));
-    for (int r = 0; r < grid.rows(); ++r) {
-        for (int c = 0; c < grid.cols(); ++c) {
-            rect.setPosition(c * cellSize, r * cellSize);
-            rect.setFillColor(grid.at(r,c).isAlive()
-                              ? sf::Color::White
-                              : sf::Color(30,30,30));
-            window.draw(rect);
-        }
-    }
+    std::ostringstream title;
+    title << "Game of Life - generation " << frame.iteration << " - ";
+    if (rate > 0) title << rate << " gen/s";
+    else title << "max";
+    if (!skipFrames) title << " (toutes les generations)";
+    if (frame.finished) title << " - terminee";
+    else if (paused) title << " - pause";
+    return title.str();
 }
 
 void GraphicRunner::run(const SimulationConfig& config) {
     try {
-        Grid grid = InitialStateLoader::loadFromFile(config.inputFile,
-                                                     config.toroidal);
-        GameOfLife game(grid, std::make_unique<ConwayRule>(), config.maxIterations);
+        // meme facade que le mode console, sans exporter ; construite avant
+        // la fenetre et le thread de calcul (fork du moteur reparti)
+        FileGridLoader loader;
+        SystemEngineResources resources;
+        SimulationService service(config, loader, nullptr, std::make_unique<LifeRule>(config.rule),
+                                  nullptr, nullptr, &resources);
+        const Grid& grid = service.currentGrid();
 
-        const int cellSize = 20;
-        sf::RenderWindow window(
-            sf::VideoMode(grid.cols()*cellSize, grid.rows()*cellSize),
-            "Game of Life");
+        sf::RenderWindow window(initialMode(grid.rows(), grid.cols()), "Game of Life");
+        Viewport view(grid.rows(), grid.cols(), window.getSize().x, window.getSize().y);
+        bool dragging = false;
+        sf::Vector2i dragFrom;
+        GridRenderer renderer(grid.rows(), grid.cols(), config.rule.states);
 
         window.setFramerateLimit(30);
-        sf::Clock clock;
-        float stepTime = 0.2f;
-        float accumulator = 0.f;
+        int rateIndex = kDefaultRate;
         bool paused = false;
+        bool skipFrames = true;
+        std::string title;
+
+        // calcul sur son propre thread : l'affichage prend la derniere
+        // generation publiee, a son rythme
+        SimulationThread simulation(service, kRates[rateIndex]);
 
         while (window.isOpen()) {
             sf::Event event;
             while (window.pollEvent(event)) {
                 if (event.type == sf::Event::Closed)
                     window.close();
+                if (event.type == sf::Event::Resized) {
+                    // un pixel de vue par pixel de fenetre
+                    window.setView(sf::View(sf::FloatRect(0, 0, event.size.width, event.size.height)));
+                    view.resize(event.size.width, event.size.height);
+                }
+                // molette : zoom autour du curseur ; glisser (bouton gauche) : deplacement
+                if (event.type == sf::Event::MouseWheelScrolled)
+                    view.zoomAt(std::pow(1.25f, event.mouseWheelScroll.delta),
+                                event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+                if (event.type == sf::Event::MouseButtonPressed
+                    && event.mouseButton.button == sf::Mouse::Left) {
+                    dragging = true;
+                    dragFrom = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+                }
+                if (event.type == sf::Event::MouseButtonReleased
+                    && event.mouseButton.button == sf::Mouse::Left)
+                    dragging = false;
+                if (event.type == sf::Event::MouseMoved && dragging) {
+                    view.pan(event.mouseMove.x - dragFrom.x, event.mouseMove.y - dragFrom.y);
+                    dragFrom = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+                }
                 if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::Space)
+                    switch (event.key.code) {
+                    case sf::Keyboard::Space:
                         paused = !paused;
-                    if (event.key.code == sf::Keyboard::N && paused)
-                        game.step();
+                        simulation.setPaused(paused);
+                        break;
+                    case sf::Keyboard::N:
+                        if (paused) simulation.requestStep();
+                        break;
+                    case sf::Keyboard::Up:
+                        rateIndex = std::min(rateIndex + 1, kRateCount - 1);
+                        simulation.setRate(kRates[rateIndex]);
+                        break;
+                    case sf::Keyboard::Down:
+                        rateIndex = std::max(rateIndex - 1, 0);
+                        simulation.setRate(kRates[rateIndex]);
+                        break;
+                    case sf::Keyboard::Add:
+                    case sf::Keyboard::Equal:
+                        view.zoomAt(2.0f, view.screenWidth() / 2.0f, view.screenHeight() / 2.0f);
+                        break;
+                    case sf::Keyboard::Subtract:
+                    case sf::Keyboard::Hyphen:
+                        view.zoomAt(0.5f, view.screenWidth() / 2.0f, view.screenHeight() / 2.0f);
+                        break;
+                    case sf::Keyboard::Home:
+                    case sf::Keyboard::R:
+                        view.fit();
+                        break;
+                    case sf::Keyboard::F:
+                        skipFrames = !skipFrames;
+                        simulation.setFrameSkipping(skipFrames);
+                        break;
+                    default:
+                        break;
+                    }
                 }
             }
 
-            float dt = clock.restart().asSeconds();
-            accumulator += dt;
+            // instantane de la derniere generation ; la texture ne couvre que la vue
+            if (simulation.acquire()) {
+                const SimulationThread::Frame& frame = simulation.frame();
+                if (frame.multiState)
+                    renderer.update(frame.states);
+                else
+                    renderer.update(frame.grid);
+            }
 
-            if (!paused && accumulator >= stepTime && !game.hasFinished()) {
-                accumulator = 0.f;
-                game.step();
+            const std::string next = windowTitle(simulation.frame(), kRates[rateIndex],
+                                                 paused, skipFrames);
+            if (next != title) {
+                title = next;
+                window.setTitle(title);
             }
 
             window.clear(sf::Color::Black);
-            drawGrid(window, game.currentGrid(), cellSize);
+            renderer.draw(window, view);
             window.display();
         }
     }
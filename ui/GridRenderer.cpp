@@ -0,0 +1,182 @@
+#include "GridRenderer.h"
+#include "DensityMap.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const sf::Color kDead(30, 30, 30);
+
+// pixel RGBA dans l'ordre des octets attendu par sf::Texture::update
+sf::Uint32 pack(const sf::Color& color) {
+    const sf::Uint8 bytes[4] = { color.r, color.g, color.b, color.a };
+    sf::Uint32 pixel;
+    std::memcpy(&pixel, bytes, sizeof pixel);
+    return pixel;
+}
+
+// regles Generations : vivante en blanc, etats mourants de plus en plus
+// sombres (du jaune vers le rouge)
+sf::Color stateColor(int state, int states) {
+    if (state == 0) return kDead;
+    if (state == 1) return sf::Color::White;
+    const int span = std::max(states - 2, 1);
+    const int k = std::min(state - 2, span);
+    const sf::Uint8 green = static_cast<sf::Uint8>(220 - 200 * k / span);
+    const sf::Uint8 red = static_cast<sf::Uint8>(255 - 100 * k / span);
+    return sf::Color(red, green, 40);
+}
+
+} // namespace
+
+GridRenderer::GridRenderer(int rows, int cols, int stateCount)
+    : m_rows(std::max(rows, 0)),
+      m_cols(std::max(cols, 0)),
+      m_rowChanged(m_rows, 0),
+      m_drawnView(m_rows, m_cols, 1, 1)
+{
+    for (int s = 0; s < 256; ++s) m_palette[s] = pack(stateColor(s, stateCount));
+    for (int byte = 0; byte < 256; ++byte)
+        for (int bit = 0; bit < 8; ++bit)
+            m_bytePixels[byte][bit] = m_palette[(byte >> bit) & 1];
+    // densite : du fond (30) au blanc
+    for (int level = 0; level < 256; ++level) {
+        const sf::Uint8 grey = static_cast<sf::Uint8>(kDead.r + (255 - kDead.r) * level / 255);
+        m_levelPixels[level] = pack(sf::Color(grey, grey, grey));
+    }
+}
+
+void GridRenderer::markChanged(int row) {
+    m_rowChanged[row] = 1;
+    m_anyChanged = true;
+}
+
+void GridRenderer::update(const Grid& grid) {
+    if (grid.rows() != m_rows || grid.cols() != m_cols) return; // dimensions fixees a la construction
+    if (!m_hasSnapshot || m_multiState) {
+        m_grid = Grid(m_rows, m_cols);
+        m_states = StateGrid();
+        m_multiState = false;
+        m_hasSnapshot = false;
+        m_drawn = false;
+    }
+    const std::size_t rowBytes = sizeof(std::uint64_t) * grid.wordsPerRow();
+    for (int r = 0; r < m_rows; ++r) {
+        std::uint64_t* snapshot = m_grid.rowWords(r);
+        if (m_hasSnapshot && std::memcmp(snapshot, grid.rowWords(r), rowBytes) == 0) continue;
+        std::memcpy(snapshot, grid.rowWords(r), rowBytes);
+        markChanged(r);
+    }
+    m_hasSnapshot = true;
+}
+
+void GridRenderer::update(const StateGrid& states) {
+    if (states.rows() != m_rows || states.cols() != m_cols) return;
+    if (!m_hasSnapshot || !m_multiState) {
+        m_states = StateGrid(m_rows, m_cols);
+        m_grid = Grid();
+        m_multiState = true;
+        m_hasSnapshot = false;
+        m_drawn = false;
+    }
+    for (int r = 0; r < m_rows; ++r) {
+        std::uint8_t* snapshot = m_states.row(r);
+        if (m_hasSnapshot && std::memcmp(snapshot, states.row(r), m_cols) == 0) continue;
+        std::memcpy(snapshot, states.row(r), m_cols);
+        markChanged(r);
+    }
+    m_hasSnapshot = true;
+}
+
+void GridRenderer::reserveTexture(int width, int height) {
+    if (width <= m_textureWidth && height <= m_textureHeight) return;
+    // croissance seulement : la texture suit la plus grande vue affichee
+    m_textureWidth = std::max(width, m_textureWidth);
+    m_textureHeight = std::max(height, m_textureHeight);
+    m_texture.create(m_textureWidth, m_textureHeight);
+    m_sprite.setTexture(m_texture);
+    m_pixels.resize(static_cast<std::size_t>(m_textureWidth) * m_textureHeight);
+    m_levels.resize(m_textureWidth);
+    m_drawn = false;
+}
+
+void GridRenderer::rasterRow(const Viewport::Region& region, int block, int outRow, int outCols) {
+    sf::Uint32* out = &m_pixels[static_cast<std::size_t>(outRow) * outCols];
+    if (block > 1) {
+        // vue reduite : un texel par bloc
+        if (m_multiState)
+            DensityMap::sampleRow(m_states, region.row0, region.col0, region.rows, region.cols,
+                                  block, outRow, m_levels.data());
+        else
+            DensityMap::sampleRow(m_grid, region.row0, region.col0, region.rows, region.cols,
+                                  block, outRow, m_levels.data());
+        for (int j = 0; j < outCols; ++j) out[j] = m_levelPixels[m_levels[j]];
+        return;
+    }
+
+    const int r = region.row0 + outRow;
+    if (m_multiState) {
+        const std::uint8_t* cells = m_states.row(r) + region.col0;
+        for (int c = 0; c < outCols; ++c) out[c] = m_palette[cells[c]];
+        return;
+    }
+    // 8 cellules a la fois depuis la table, a partir d'une colonne quelconque
+    const std::uint64_t* words = m_grid.rowWords(r);
+    const int lastWord = m_grid.wordsPerRow() - 1;
+    for (int c = 0; c < outCols; c += 8) {
+        const int col = region.col0 + c;
+        const int w = col >> 6;
+        const int shift = col & 63;
+        std::uint64_t bits = words[w] >> shift;
+        if (shift > 56 && w < lastWord) bits |= words[w + 1] << (64 - shift);
+        std::memcpy(out + c, m_bytePixels[bits & 0xFFu],
+                    sizeof(sf::Uint32) * static_cast<std::size_t>(std::min(8, outCols - c)));
+    }
+}
+
+void GridRenderer::upload(int rowBegin, int rowEnd, int outCols) {
+    if (rowBegin >= rowEnd) return;
+    m_texture.update(reinterpret_cast<const sf::Uint8*>(&m_pixels[static_cast<std::size_t>(rowBegin) * outCols]),
+                     outCols, rowEnd - rowBegin, 0, rowBegin);
+    m_uploadedRows += rowEnd - rowBegin;
+}
+
+void GridRenderer::draw(sf::RenderWindow& window, const Viewport& view) {
+    m_uploadedRows = 0;
+    const Viewport::Region region = view.visible();
+    if (!m_hasSnapshot || region.rows == 0) return;
+    const int block = view.lodBlock();
+    const int outRows = DensityMap::blockCount(region.rows, block);
+    const int outCols = DensityMap::blockCount(region.cols, block);
+    reserveTexture(outCols, outRows);
+
+    // vue inchangee : seules les lignes de texels touchees par un changement
+    const bool full = !m_drawn || view != m_drawnView;
+    int spanBegin = -1; // plage courante de lignes de texels a envoyer
+    for (int i = 0; i < outRows; ++i) {
+        const int rBegin = region.row0 + i * block;
+        const int rEnd = std::min(rBegin + block, region.row0 + region.rows);
+        const bool changed = full || (m_anyChanged
+            && std::find(m_rowChanged.begin() + rBegin, m_rowChanged.begin() + rEnd, 1)
+               != m_rowChanged.begin() + rEnd);
+        if (changed) {
+            rasterRow(region, block, i, outCols);
+            if (spanBegin < 0) spanBegin = i;
+        }
+        else if (spanBegin >= 0) {
+            upload(spanBegin, i, outCols);
+            spanBegin = -1;
+        }
+    }
+    if (spanBegin >= 0) upload(spanBegin, outRows, outCols);
+    if (m_anyChanged) std::fill(m_rowChanged.begin(), m_rowChanged.end(), 0);
+    m_anyChanged = false;
+    m_drawn = true;
+    m_drawnView = view;
+
+    const float scale = view.zoom() * block;
+    m_sprite.setTextureRect(sf::IntRect(0, 0, outCols, outRows));
+    m_sprite.setPosition(view.screenX(region.col0), view.screenY(region.row0));
+    m_sprite.setScale(scale, scale);
+    window.draw(m_sprite);
+}
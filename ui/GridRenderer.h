@@ -0,0 +1,60 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "StateGrid.h"
+#include "Viewport.h"
+
+// Rendu de la région visible d'une grille en une seule texture affichée par
+// un sprite mis à l'échelle : un seul appel de dessin par image, et un coût
+// proportionnel aux pixels d'écran, pas à la surface de la grille.
+//
+// Zoom d'au moins un pixel par cellule : un texel par cellule visible. En
+// dessous : un texel par bloc de cellules (Viewport::lodBlock()), en niveau
+// de gris selon la densité de cellules vivantes du bloc (DensityMap).
+//
+// update() copie la grille dans un instantané propre au rendu et note les
+// lignes modifiées ; draw() ne recalcule et n'envoie à la texture que les
+// lignes de texels touchées par ces lignes, ou toute la vue si elle a
+// changé (déplacement, zoom, taille de fenêtre). Le dessin lit
+// l'instantané, jamais la grille vivante du moteur.
+class GridRenderer {
+public:
+    // stateCount : nombre d'états des règles Generations (palette)
+    GridRenderer(int rows, int cols, int stateCount = 2);
+
+    void update(const Grid& grid);
+    void update(const StateGrid& states);
+    void draw(sf::RenderWindow& window, const Viewport& view);
+
+    int uploadedRows() const { return m_uploadedRows; } // lignes de texels au dernier draw()
+
+private:
+    void reserveTexture(int width, int height);
+    void rasterRow(const Viewport::Region& region, int block, int outRow, int outCols);
+    void upload(int rowBegin, int rowEnd, int outCols);
+    void markChanged(int row);
+
+    int m_rows;
+    int m_cols;
+    bool m_multiState = false;
+    bool m_hasSnapshot = false;
+    Grid m_grid;                         // instantané à deux états
+    StateGrid m_states;                  // instantané multi-états
+    std::vector<char> m_rowChanged;      // depuis le dernier draw()
+    bool m_anyChanged = false;
+    bool m_drawn = false;
+    Viewport m_drawnView;                // vue du dernier draw()
+
+    std::vector<sf::Uint32> m_pixels;    // RGBA, lignes de texels contiguës
+    std::vector<std::uint8_t> m_levels;  // densités d'une ligne de blocs
+    sf::Uint32 m_palette[256];           // couleur de chaque état
+    sf::Uint32 m_bytePixels[256][8];     // 8 cellules à deux états par octet
+    sf::Uint32 m_levelPixels[256];       // couleur de chaque densité
+    sf::Texture m_texture;
+    int m_textureWidth = 0;
+    int m_textureHeight = 0;
+    sf::Sprite m_sprite;
+    int m_uploadedRows = 0;
+};
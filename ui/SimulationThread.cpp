@@ -0,0 +1,145 @@
+#include "SimulationThread.h"
+#include "SimulationService.h"
+#include <utility>
+
+SimulationThread::SimulationThread(SimulationService& service, double generationsPerSecond)
+    : m_service(service),
+      m_rate(generationsPerSecond),
+      m_next(Clock::now())
+{
+    publish(); // generation initiale, avant que le thread ne prenne le service
+    m_thread = std::thread(&SimulationThread::loop, this);
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void SimulationThread::setPaused(bool paused) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_paused = paused;
+        m_next = Clock::now();
+    }
+    m_wake.notify_one();
+}
+
+void SimulationThread::requestStep() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stepRequests;
+    }
+    m_wake.notify_one();
+}
+
+void SimulationThread::setRate(double generationsPerSecond) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rate = generationsPerSecond;
+        m_next = Clock::now();
+    }
+    m_wake.notify_one();
+}
+
+void SimulationThread::setFrameSkipping(bool skip) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_skipFrames = skip;
+    }
+    m_wake.notify_one();
+}
+
+bool SimulationThread::acquire() {
+    const bool fresh = m_frames.acquire();
+    if (fresh && !m_skipFrames) {
+        // le calcul attend peut-etre cette lecture : verrou pris apres
+        // l'echange pour qu'il ne manque pas le reveil
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_wake.notify_one();
+    }
+    if (m_failed) {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            error = std::exchange(m_error, nullptr); // signalee une seule fois
+        }
+        if (error) std::rethrow_exception(error);
+    }
+    return fresh;
+}
+
+void SimulationThread::publish() {
+    Frame& frame = m_frames.back();
+    // affectation dans un emplacement deja dimensionne : pas d'allocation
+    if (const StateGrid* states = m_service.currentStates()) {
+        frame.multiState = true;
+        frame.states = *states;
+    }
+    else {
+        frame.multiState = false;
+        frame.grid = m_service.currentGrid();
+    }
+    frame.iteration = m_service.currentIteration();
+    frame.finished = m_service.hasFinished();
+    m_frames.publish();
+}
+
+bool SimulationThread::waitForStep(bool finished) {
+    // chemin rapide sans verrou : calcul continu, sans limite de vitesse
+    if (!finished && !m_stop && !m_paused && m_stepRequests == 0 && m_rate <= 0
+        && (m_skipFrames || !m_frames.pending()))
+        return true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        if (m_stop) return false;
+        if (finished) {
+            m_stepRequests = 0;
+            m_wake.wait(lock);
+            continue;
+        }
+        if (m_stepRequests > 0) {
+            --m_stepRequests;
+            return true;
+        }
+        if (m_paused || (!m_skipFrames && m_frames.pending())) {
+            m_wake.wait(lock);
+            continue;
+        }
+        const double rate = m_rate;
+        if (rate > 0) {
+            const Clock::time_point now = Clock::now();
+            if (now < m_next) {
+                m_wake.wait_until(lock, m_next);
+                continue;
+            }
+            // un pas plus long que la periode : pas de rattrapage en rafale
+            m_next += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / rate));
+            if (m_next < now) m_next = now;
+        }
+        return true;
+    }
+}
+
+void SimulationThread::loop() {
+    bool finished = m_service.hasFinished();
+    while (waitForStep(finished)) {
+        try {
+            m_service.step();
+            publish();
+            finished = m_service.hasFinished();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = std::current_exception();
+            m_failed = true;
+            return;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "Grid.h"
+#include "StateGrid.h"
+#include "TripleBuffer.h"
+
+class SimulationService;
+
+// Exécute les pas d'une simulation sur un thread dédié et publie chaque
+// génération calculée dans un triple tampon : l'affichage lit la plus
+// récente sans jamais attendre le calcul, et un pas lent ne fige pas la
+// fenêtre.
+//
+// Le rythme est une cible en générations par seconde (0 = aussi vite que
+// possible). Avec le saut d'images (par défaut), les générations calculées
+// entre deux images ne sont pas affichées ; sans, le calcul attend que
+// chaque génération ait été lue par l'affichage.
+//
+// Après le démarrage, seul ce thread touche au service ; une exception
+// levée par un pas arrête le calcul et est relancée par acquire().
+class SimulationThread {
+public:
+    struct Frame {
+        bool multiState = false;
+        Grid grid;
+        StateGrid states;
+        int iteration = 0;
+        bool finished = false; // le service a terminé (dernière génération)
+    };
+
+    SimulationThread(SimulationService& service, double generationsPerSecond);
+    ~SimulationThread(); // arrête et attend le thread
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void setPaused(bool paused);
+    void requestStep(); // un pas, même en pause
+    void setRate(double generationsPerSecond);
+    void setFrameSkipping(bool skip);
+
+    // vrai si une nouvelle génération est disponible dans frame()
+    bool acquire();
+    const Frame& frame() const { return m_frames.front(); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void loop();
+    bool waitForStep(bool finished); // faux : arret demande
+    void publish();
+
+    SimulationService& m_service;
+    TripleBuffer<Frame> m_frames;
+    // réglages lus sans verrou à chaque pas ; modifiés sous m_mutex pour
+    // ne pas manquer le réveil du thread de calcul en attente
+    std::atomic<bool> m_stop{ false };
+    std::atomic<bool> m_paused{ false };
+    std::atomic<bool> m_skipFrames{ true };
+    std::atomic<int> m_stepRequests{ 0 };
+    std::atomic<double> m_rate;    // générations par seconde, 0 = sans limite
+    std::atomic<bool> m_failed{ false };
+    Clock::time_point m_next;      // échéance du prochain pas cadencé
+    std::exception_ptr m_error;    // pas encore signalée
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::thread m_thread;
+};
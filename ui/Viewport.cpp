@@ -0,0 +1,100 @@
+#include "Viewport.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float kMaxZoom = 64.0f; // pixels par cellule au zoom maximal
+
+} // namespace
+
+Viewport::Viewport(int gridRows, int gridCols, int screenWidth, int screenHeight)
+    : m_rows(std::max(gridRows, 1)),
+      m_cols(std::max(gridCols, 1)),
+      m_width(std::max(screenWidth, 1)),
+      m_height(std::max(screenHeight, 1))
+{
+    fit();
+}
+
+void Viewport::resize(int screenWidth, int screenHeight) {
+    m_width = std::max(screenWidth, 1);
+    m_height = std::max(screenHeight, 1);
+    clamp();
+}
+
+void Viewport::fit() {
+    m_zoom = std::min(kMaxZoom, std::min(static_cast<float>(m_width) / m_cols,
+                                         static_cast<float>(m_height) / m_rows));
+    m_centerRow = m_rows / 2.0;
+    m_centerCol = m_cols / 2.0;
+}
+
+void Viewport::pan(float dxPixels, float dyPixels) {
+    m_centerCol -= dxPixels / m_zoom;
+    m_centerRow -= dyPixels / m_zoom;
+    clamp();
+}
+
+void Viewport::zoomAt(float factor, float screenX, float screenY) {
+    // cellule sous le curseur avant le zoom
+    const double col = m_centerCol + (screenX - m_width / 2.0) / m_zoom;
+    const double row = m_centerRow + (screenY - m_height / 2.0) / m_zoom;
+    m_zoom *= factor;
+    clamp();
+    m_centerCol = col - (screenX - m_width / 2.0) / m_zoom;
+    m_centerRow = row - (screenY - m_height / 2.0) / m_zoom;
+    clamp();
+}
+
+void Viewport::clamp() {
+    // au plus loin : la grille entière tient dans la moitié de la fenêtre
+    const float fitZoom = std::min(static_cast<float>(m_width) / m_cols,
+                                   static_cast<float>(m_height) / m_rows);
+    m_zoom = std::max(std::min(m_zoom, kMaxZoom), std::min(fitZoom / 2, kMaxZoom));
+    // le centre reste sur la grille
+    m_centerRow = std::max(0.0, std::min(m_centerRow, static_cast<double>(m_rows)));
+    m_centerCol = std::max(0.0, std::min(m_centerCol, static_cast<double>(m_cols)));
+}
+
+int Viewport::lodBlock() const {
+    int block = 1;
+    while (block * m_zoom < 1.0f && block < (1 << 20)) block *= 2;
+    return block;
+}
+
+Viewport::Region Viewport::visible() const {
+    const int block = lodBlock();
+    const double left = m_centerCol - m_width / (2.0 * m_zoom);
+    const double top = m_centerRow - m_height / (2.0 * m_zoom);
+    int col0 = std::max(0, static_cast<int>(std::floor(left)));
+    int row0 = std::max(0, static_cast<int>(std::floor(top)));
+    col0 -= col0 % block;
+    row0 -= row0 % block;
+    const int colEnd = std::min(m_cols, static_cast<int>(std::ceil(left + m_width / m_zoom)));
+    const int rowEnd = std::min(m_rows, static_cast<int>(std::ceil(top + m_height / m_zoom)));
+
+    Region region;
+    if (colEnd > col0 && rowEnd > row0) {
+        region.row0 = row0;
+        region.col0 = col0;
+        region.rows = rowEnd - row0;
+        region.cols = colEnd - col0;
+    }
+    return region;
+}
+
+float Viewport::screenX(double col) const {
+    return static_cast<float>((col - m_centerCol) * m_zoom + m_width / 2.0);
+}
+
+float Viewport::screenY(double row) const {
+    return static_cast<float>((row - m_centerRow) * m_zoom + m_height / 2.0);
+}
+
+bool Viewport::operator==(const Viewport& other) const {
+    return m_rows == other.m_rows && m_cols == other.m_cols
+        && m_width == other.m_width && m_height == other.m_height
+        && m_centerRow == other.m_centerRow && m_centerCol == other.m_centerCol
+        && m_zoom == other.m_zoom;
+}
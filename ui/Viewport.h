@@ -0,0 +1,49 @@
+#pragma once
+
+// Fenêtre de vue sur une grille : centre (en cellules) et zoom (pixels
+// d'écran par cellule). Convertit entre coordonnées d'écran et de grille et
+// donne la région visible, seule région que le rendu lit.
+//
+// En dessous d'un pixel par cellule, le rendu réduit des blocs de
+// lodBlock() × lodBlock() cellules (puissance de deux, un bloc fait au moins
+// un pixel d'écran).
+class Viewport {
+public:
+    struct Region {
+        int row0 = 0;
+        int col0 = 0;
+        int rows = 0; // 0 : rien de visible
+        int cols = 0;
+    };
+
+    Viewport(int gridRows, int gridCols, int screenWidth, int screenHeight);
+
+    void resize(int screenWidth, int screenHeight);
+    void fit();                                   // toute la grille, centrée
+    void pan(float dxPixels, float dyPixels);     // déplace le contenu affiché
+    void zoomAt(float factor, float screenX, float screenY); // point fixe sous le curseur
+
+    float zoom() const { return m_zoom; }
+    int lodBlock() const;
+    // région visible, alignée sur les blocs de lodBlock()
+    Region visible() const;
+    // position à l'écran du coin haut gauche de la cellule (row, col)
+    float screenX(double col) const;
+    float screenY(double row) const;
+    int screenWidth() const { return m_width; }
+    int screenHeight() const { return m_height; }
+
+    bool operator==(const Viewport& other) const;
+    bool operator!=(const Viewport& other) const { return !(*this == other); }
+
+private:
+    void clamp();
+
+    int m_rows;
+    int m_cols;
+    int m_width;
+    int m_height;
+    double m_centerRow = 0.0;
+    double m_centerCol = 0.0;
+    float m_zoom = 1.0f;
+};
@@ -1,39 +1,247 @@
 #include "SimulationConfig.h"
+#include "BatchRunner.h"
+#include "CensusRunner.h"
 #include "ConsoleRunner.h"
+#include "ExtractRunner.h"
 #include "GraphicRunner.h"
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static OutputFormat parseFormat(const std::string& name) {
+    if (name == "text") return OutputFormat::Text;
+    if (name == "log") return OutputFormat::Log;
+    throw std::invalid_argument("Format inconnu : " + name);
+}
+
+static Engine parseEngine(const std::string& name) {
+    if (name == "dense") return Engine::Dense;
+    if (name == "sparse") return Engine::Sparse;
+    if (name == "hashlife") return Engine::HashLife;
+    if (name == "distributed") return Engine::Distributed;
+    if (name == "tiled") return Engine::Tiled;
+    throw std::invalid_argument("Moteur inconnu : " + name);
+}
+
+// --view haut,gauche,lignes,colonnes
+static void parseView(const std::string& value, SimulationConfig& config) {
+    long long top = 0, left = 0;
+    int rows = 0, cols = 0;
+    char c1 = 0, c2 = 0, c3 = 0;
+    std::istringstream in(value);
+    if (!(in >> top >> c1 >> left >> c2 >> rows >> c3 >> cols)
+        || c1 != ',' || c2 != ',' || c3 != ',' || rows <= 0 || cols <= 0) {
+        throw std::invalid_argument("Vue invalide (attendu haut,gauche,lignes,colonnes) : " + value);
+    }
+    config.viewTop = top;
+    config.viewLeft = left;
+    config.viewRows = rows;
+    config.viewCols = cols;
+}
+
+// --soup 16x16, --size 4096x4096 (lignes x colonnes)
+static void parseSize(const std::string& value, int& rows, int& cols) {
+    char x = 0;
+    std::istringstream in(value);
+    if (!(in >> rows >> x >> cols) || x != 'x' || !in.eof() || rows <= 0 || cols <= 0) {
+        throw std::invalid_argument("Taille invalide (attendu LxC) : " + value);
+    }
+}
+
+// vrai si --nom (ou --nom=valeur) figure sur la ligne de commande
+static bool hasOption(int argc, char** argv, const std::string& name) {
+    const std::string flag = "--" + name;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == flag || arg.rfind(flag + "=", 0) == 0) return true;
+    }
+    return false;
+}
+
+// Options communes aux modes (--nom valeur ou --nom=valeur) ; les autres
+// arguments restent positionnels.
+static std::vector<std::string> parseOptions(int argc, char** argv,
+                                             SimulationConfig& config)
+{
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            args.push_back(arg);
+            continue;
+        }
+
+        std::string name = arg.substr(2);
+        std::string value;
+        std::size_t eq = name.find('=');
+        if (eq != std::string::npos) {
+            value = name.substr(eq + 1);
+            name = name.substr(0, eq);
+        }
+        else if (i + 1 < argc) {
+            value = argv[++i];
+        }
+        else {
+            throw std::invalid_argument("Valeur manquante pour --" + name);
+        }
+
+        if (name == "threads")
+            config.threads = std::stoi(value);
+        else if (name == "engine")
+            config.engine = parseEngine(value);
+        else if (name == "workers")
+            config.workers = std::stoi(value);
+        else if (name == "rule")
+            config.rule = RuleSpec::parse(value);
+        else if (name == "step-log2")
+            config.hashlifeStepLog2 = std::stoi(value);
+        else if (name == "view")
+            parseView(value, config);
+        else if (name == "format")
+            config.outputFormat = parseFormat(value);
+        else if (name == "keyframe")
+            config.logKeyframeInterval = std::stoi(value);
+        else if (name == "export-every")
+            config.exportEvery = std::stoi(value);
+        else if (name == "export-queue")
+            config.exportQueue = std::stoi(value);
+        else if (name == "checkpoint")
+            config.checkpointFile = value;
+        else if (name == "checkpoint-every")
+            config.checkpointEvery = std::stoi(value);
+        else if (name == "metrics") {
+            // "summary" : resume seul ; sinon fichier .csv ou .jsonl
+            config.collectMetrics = true;
+            config.metricsFile = value == "summary" ? std::string() : value;
+        }
+        else if (name == "metrics-history")
+            config.metricsHistory = std::stoi(value);
+        else if (name == "soup")
+            parseSize(value, config.soupRows, config.soupCols);
+        else if (name == "size")
+            parseSize(value, config.tiledRows, config.tiledCols);
+        else if (name == "density")
+            config.soupDensity = std::stod(value);
+        else if (name == "seed")
+            config.soupSeed = std::stoull(value);
+        else
+            throw std::invalid_argument("Option inconnue : --" + name);
+    }
+    return args;
+}
 
 int main(int argc, char** argv) {
     SimulationConfig config;
+    std::vector<std::string> args;
+    try {
+        args = parseOptions(argc, argv, config);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Erreur: " << ex.what() << "\n";
+        return 1;
+    }
 
-    if (argc < 2) {
+    if (args.empty()) {
         std::cout << "Usage:\n"
-                  << "  " << argv[0] << " console <input_file> <baseName> [maxIter]\n"
-                  << "  " << argv[0] << " graphic [input_file] [maxIter]\n";
+                  << "  " << argv[0] << " console <input_file> <baseName> [maxIter] [options]\n"
+                  << "  " << argv[0] << " graphic [input_file] [maxIter] [options]\n"
+                  << "  " << argv[0] << " extract <journal.golog> [generation [baseName]]\n"
+                  << "  " << argv[0] << " resume <checkpoint> [maxIter] [options]\n"
+                  << "  " << argv[0] << " batch <manifeste> <synthese.csv> [maxIter] [options]\n"
+                  << "  " << argv[0] << " census <soupes> <resultats.csv> [maxIter] [options]\n"
+                  << "Options:\n"
+                  << "  --threads N               threads de calcul (0 = tous les coeurs) ;\n"
+                  << "                            batch, census : simulations en parallele\n"
+                  << "  --engine dense|sparse|hashlife|distributed|tiled\n"
+                  << "                            grille fixe, univers creux, hashlife, grille\n"
+                  << "                            fixe repartie entre processus ou en fichier\n"
+                  << "  --workers N               distributed : processus de calcul (0 = un par coeur)\n"
+                  << "  --rule B3/S23             regle Life-like (B36/S23, B3678/S34678...)\n"
+                  << "  --size LxC                tiled : dimensions de la grille (motif au centre)\n"
+                  << "  --step-log2 K             hashlife : 2^K generations par pas\n"
+                  << "  --view T,L,R,C            fenetre exportee (univers non bornes)\n"
+                  << "  --format text|log         console : fichiers texte ou journal binaire\n"
+                  << "  --keyframe N              journal : image complete toutes les N generations\n"
+                  << "  --export-every K          console : exporte une generation sur K (0 = derniere)\n"
+                  << "  --export-queue N          console : generations en attente d'ecriture (0 = synchrone)\n"
+                  << "  --checkpoint FICHIER      console : point de reprise (moteur dense)\n"
+                  << "  --checkpoint-every N      point de reprise toutes les N generations\n"
+                  << "  --metrics summary|FICHIER console : mesures par generation (.csv ou .jsonl)\n"
+                  << "  --metrics-history N       mesures gardees en memoire (1024)\n"
+                  << "  --soup LxC                census : taille des soupes (16x16)\n"
+                  << "  --density D               census : densite des soupes (0.5)\n"
+                  << "  --seed N                  census : graine de la premiere soupe (1)\n";
         return 0;
     }
 
-    std::string mode = argv[1];
+    std::string mode = args[0];
 
     if (mode == "console") {
-        if (argc < 4) {
+        if (args.size() < 3) {
             std::cout << "Usage console: " << argv[0]
-                      << " console <input_file> <baseName> [maxIter]\n";
+                      << " console <input_file> <baseName> [maxIter] [options]\n";
             return 0;
         }
-        config.inputFile = argv[2];
+        config.inputFile = args[1];
         config.graphicMode = false;
-        config.outputBaseName = argv[3];
-        if (argc >= 5) config.maxIterations = std::stoi(argv[4]);
+        config.outputBaseName = args[2];
+        if (args.size() >= 4) config.maxIterations = std::stoi(args[3]);
 
         ConsoleRunner::run(config);
     }
     else if (mode == "graphic") {
-        if (argc >= 3) config.inputFile = argv[2];
+        if (args.size() >= 2) config.inputFile = args[1];
         config.graphicMode = true;
-        if (argc >= 4) config.maxIterations = std::stoi(argv[3]);
+        if (args.size() >= 3) config.maxIterations = std::stoi(args[2]);
         GraphicRunner::run(config);
     }
+    else if (mode == "extract") {
+        if (args.size() < 2) {
+            std::cout << "Usage extract: " << argv[0]
+                      << " extract <journal.golog> [generation [baseName]]\n";
+            return 0;
+        }
+        if (args.size() == 2) {
+            ExtractRunner::list(args[1]);
+        }
+        else {
+            std::string base = args.size() >= 4 ? args[3] : args[1].substr(0, args[1].rfind('.'));
+            ExtractRunner::run(args[1], std::stoi(args[2]), base);
+        }
+    }
+    else if (mode == "resume") {
+        if (args.size() < 2) {
+            std::cout << "Usage resume: " << argv[0]
+                      << " resume <checkpoint> [maxIter] [options]\n";
+            return 0;
+        }
+        ConsoleRunner::resume(args[1], config, args.size() >= 3 ? std::stoi(args[2]) : 0);
+    }
+    else if (mode == "batch") {
+        if (args.size() < 3) {
+            std::cout << "Usage batch: " << argv[0]
+                      << " batch <manifeste> <synthese.csv> [maxIter] [options]\n";
+            return 0;
+        }
+        // options et maxIter : valeurs par defaut de chaque entree du manifeste
+        if (args.size() >= 4) config.maxIterations = std::stoi(args[3]);
+        // sans --threads : autant de simulations en parallele que de coeurs
+        if (!hasOption(argc, argv, "threads")) config.threads = 0;
+        BatchRunner::run(args[1], args[2], config);
+    }
+    else if (mode == "census") {
+        if (args.size() < 3) {
+            std::cout << "Usage census: " << argv[0]
+                      << " census <soupes> <resultats.csv> [maxIter] [options]\n";
+            return 0;
+        }
+        // maxIter : limite par soupe (10000 sans argument)
+        config.maxIterations = args.size() >= 4 ? std::stoi(args[3]) : 10000;
+        if (!hasOption(argc, argv, "threads")) config.threads = 0;
+        CensusRunner::run(std::stoll(args[1]), args[2], config);
+    }
     else {
         std::cout << "Mode inconnu : " << mode << "\n";
     }